@@ -0,0 +1,182 @@
+#ifndef HXHIM_DATASTORE_BPLUSTREE_HPP
+#define HXHIM_DATASTORE_BPLUSTREE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Datastore {
+
+/**
+ * BPlusTree
+ * An ordered map of byte strings used by the
+ * in-memory datastore. Keys are ordered the
+ * same way as std::string.
+ *
+ * Each leaf packs the keys and values of its
+ * records into a single slab and keeps the
+ * offsets of the records sorted by key, so
+ * adding a record does not allocate memory for
+ * it, and scans walk contiguous memory.
+ *
+ * Leaves are linked in both directions. Empty
+ * leaves are removed, but underfull leaves are
+ * not merged with their siblings.
+ *
+ * Modifying the tree invalidates all iterators
+ * and the Slices they point to.
+ */
+class BPlusTree {
+    private:
+        struct Node;
+        struct Leaf;
+        struct Inner;
+
+    public:
+        /**
+         * Slice
+         * A reference to a key or value in a leaf
+         */
+        class Slice {
+            public:
+                Slice(const char *ptr = nullptr, const std::size_t len = 0);
+
+                const char *data() const;
+                std::size_t size() const;
+                bool starts_with(const std::string &prefix) const;
+
+                operator std::string() const;
+
+            private:
+                const char *ptr;
+                std::size_t len;
+        };
+
+        struct Record {
+            Slice first;     // key
+            Slice second;    // value
+        };
+
+        class const_iterator {
+            public:
+                const_iterator();
+
+                const Record &operator*() const;
+                const Record *operator->() const;
+
+                const_iterator &operator++();
+                const_iterator operator++(int);
+
+                // decrementing end() moves to the last record
+                const_iterator &operator--();
+                const_iterator operator--(int);
+
+                bool operator==(const const_iterator &rhs) const;
+                bool operator!=(const const_iterator &rhs) const;
+
+            private:
+                friend class BPlusTree;
+
+                const_iterator(const BPlusTree *tree, const Leaf *leaf, const std::size_t index);
+
+                // point the record at the current leaf and index
+                void load();
+
+                const BPlusTree *tree;
+                const Leaf *leaf;      // nullptr is end()
+                std::size_t index;
+                Record record;
+        };
+
+        BPlusTree();
+        ~BPlusTree();
+
+        BPlusTree(const BPlusTree &) = delete;
+        BPlusTree &operator=(const BPlusTree &) = delete;
+
+        std::size_t size() const;
+        bool empty() const;
+        void clear();
+
+        // insert or overwrite
+        void put(const std::string &key, const std::string &value);
+        void put(const std::string &key, const char *value, const std::size_t value_len);
+
+        // whether or not the key was found
+        bool erase(const std::string &key);
+
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator find(const std::string &key) const;
+        const_iterator lower_bound(const std::string &key) const;
+        const_iterator upper_bound(const std::string &key) const;
+
+    private:
+        // leaves split when either limit is exceeded
+        static const std::size_t LEAF_RECORDS = 64;
+        static const std::size_t LEAF_BYTES = 16384;
+        static const std::size_t INNER_CHILDREN = 64;
+
+        struct Node {
+            Node(const bool is_leaf);
+            virtual ~Node();
+
+            const bool is_leaf;
+        };
+
+        struct Leaf : Node {
+            Leaf();
+
+            std::size_t count() const;
+            Slice key(const std::size_t i) const;
+            Slice value(const std::size_t i) const;
+
+            // the first index whose key is not less than (or greater than, if upper is true) key
+            std::size_t search(const std::string &key, const bool upper) const;
+
+            void insert(const std::size_t i,
+                        const char *key, const std::size_t key_len,
+                        const char *value, const std::size_t value_len);
+            void remove(const std::size_t i);
+
+            // rewrite the slab without the removed records
+            void compact();
+
+            // move the upper half of the records into a new leaf
+            Leaf *split();
+
+            std::vector<std::size_t> offsets; // sorted by key
+            std::vector<char> slab;           // key length, value length, key, value
+            std::size_t garbage;              // bytes of removed records in the slab
+            Leaf *prev;
+            Leaf *next;
+        };
+
+        struct Inner : Node {
+            Inner();
+            ~Inner();
+
+            // index of the child that key belongs to
+            std::size_t child(const std::string &key) const;
+
+            std::vector<std::string> keys;    // keys[i] is the smallest key of children[i + 1]
+            std::vector<Node *> children;
+        };
+
+        typedef std::vector<std::pair<Inner *, std::size_t> > Path;
+
+        // find the leaf key belongs to, recording the inner nodes that were passed through
+        Leaf *descend(const std::string &key, Path *path) const;
+
+        // move to the first record of the next leaf if index is past the end of leaf
+        const_iterator make_iterator(const Leaf *leaf, const std::size_t index) const;
+
+        Node *root;
+        Leaf *head;
+        Leaf *tail;
+        std::size_t count;
+};
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef HXHIM_DATASTORE_INMEMORY_HPP
 #define HXHIM_DATASTORE_INMEMORY_HPP
 
+#include "datastore/BPlusTree.hpp"
 #include "datastore/datastore.hpp"
 
 namespace Datastore {
@@ -36,7 +37,7 @@ class InMemory : public Datastore {
 
     protected:
         bool good;
-        std::map<std::string, std::string> db;
+        BPlusTree db;
 };
 
 }
@@ -30,6 +30,7 @@ class LevelDB : public Datastore {
         bool OpenImpl(const std::string &new_name);
         void CloseImpl();
         bool UsableImpl() const;
+        bool ConcurrentWritesImpl() const;
 
         Message::Response::BPut    *BPutImpl   (Message::Request::BPut    *req);
         Message::Response::BGet    *BGetImpl   (Message::Request::BGet    *req);
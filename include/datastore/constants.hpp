@@ -4,6 +4,7 @@
 #define DATASTORE_SUCCESS 1
 #define DATASTORE_ERROR   2
 #define DATASTORE_UNSET   3
+#define DATASTORE_PARTIAL 4    // chunk of an object that is not complete yet
 
 namespace Datastore {
 
@@ -1,17 +1,20 @@
 #ifndef HXHIM_DATASTORE_BASE
 #define HXHIM_DATASTORE_BASE
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
 
 #include "datastore/constants.hpp"
 #include "datastore/transform.hpp"
 #include "message/Messages.hpp"
 #include "utils/Blob.hpp"
 #include "utils/Histogram.hpp"
+#include "utils/RWLock.hpp"
 #include "utils/Stats.hpp"
 
 namespace Datastore {
@@ -60,6 +63,13 @@ class Datastore {
 
         int ID() const;
 
+        // maximum number of records returned by each GETOP at once (0 is unlimited)
+        void SetGetOpChunk(const std::size_t records);
+
+        // limits on objects that arrive in chunks (0 is unlimited)
+        void SetMaxObjectSize(const std::size_t bytes);
+        void SetPartialTimeout(const std::size_t milliseconds);
+
         Message::Response::BPut       *operate(Message::Request::BPut       *req);
         Message::Response::BGet       *operate(Message::Request::BGet       *req);
         Message::Response::BGetOp     *operate(Message::Request::BGetOp     *req);
@@ -96,11 +106,20 @@ class Datastore {
         // check whether or not the underyling datastore is valid
         virtual bool UsableImpl() const = 0;
 
+        // whether or not the underlying datastore allows writes to
+        // run at the same time as other reads and writes
+        virtual bool ConcurrentWritesImpl() const { return false; }
+
         virtual Message::Response::BPut    *BPutImpl   (Message::Request::BPut    *req) = 0;
         virtual Message::Response::BGet    *BGetImpl   (Message::Request::BGet    *req) = 0;
         virtual Message::Response::BGetOp  *BGetOpImpl (Message::Request::BGetOp  *req) = 0;
         virtual Message::Response::BDelete *BDeleteImpl(Message::Request::BDelete *req) = 0;
 
+        // reassemble chunks of large objects before passing them to BPutImpl
+        Message::Response::BPut *BPutChunks(Message::Request::BPut *req);
+        int assemble(const Message::Request::BPut::Chunk &chunk, const Blob &piece, std::string &object);
+        void expire_partials(const ::Stats::Chronopoint &now);
+
         virtual int WriteHistogramsImpl() = 0;                                // store histograms in datastore
         virtual std::size_t ReadHistogramsImpl(const HistNames_t &names) = 0; // retrieve histograms from datastore
         virtual int SyncImpl() = 0;
@@ -115,6 +134,7 @@ class Datastore {
 
         // only used for objects
         static Blob append_type(void *ptr, std::size_t size, hxhim_data_t type);
+        static void append_type(void *ptr, std::size_t size, hxhim_data_t type, std::string &value);
         static hxhim_data_t remove_type(const void *ptr, std::size_t &size);
 
     protected:
@@ -122,7 +142,24 @@ class Datastore {
         int id;
         Transform::Callbacks *callbacks;
         Histograms hists;
-        mutable std::mutex mutex;
+        std::size_t getop_chunk;
+
+        // reads share the datastore; writes only take it
+        // exclusively if the underlying datastore requires it
+        mutable RWLock rwlock;
+
+        // objects whose chunks have not all arrived yet
+        struct Partial {
+            std::string object;                           // sized to the full object
+            std::map<std::size_t, std::size_t> received;  // start -> end of the bytes that have arrived
+            bool failed;                                  // a chunk did not fit into the object
+            ::Stats::Chronopoint updated;                 // when the last chunk arrived
+        };
+
+        std::map<std::uint64_t, Partial> partials; // chunk id -> object
+        std::mutex partials_mutex;                 // PUTs might share rwlock
+        std::size_t max_object_size;               // largest object that will be reassembled
+        std::size_t partial_timeout;               // milliseconds before an incomplete object is dropped
 
     public:
         // child classes should update stats, since events might
@@ -136,15 +173,47 @@ class Datastore {
                 std::size_t size;     // how much data was involved
             };
 
-            std::list<Event> puts;
-            std::list<Event> gets;
-            std::list<Event> getops;  // each individual op, not the entire packet
-            std::list<Event> deletes;
+            /**
+             * Op
+             * Running totals of the events of one type of
+             * operation. Memory use does not grow with the
+             * number of events, and the totals can be read
+             * while events are being added.
+             */
+            class Op {
+                public:
+                    Op();
+
+                    void add(const Event &event);
+
+                    uint64_t events() const;   // number of events
+                    uint64_t count() const;    // number of operations
+                    uint64_t size() const;     // bytes
+                    uint64_t time() const;     // nanoseconds
+
+                    ::Stats::Distribution latency; // nanoseconds per event
+                    ::Stats::Distribution sizes;   // bytes per event
+
+                private:
+                    std::atomic<uint64_t> count_;
+            };
+
+            Op puts;
+            Op gets;
+            Op getops;  // each individual op, not the entire packet
+            Op deletes;
         };
 
+        // statistics of an operation type, readable while the datastore is running
+        // (HXHIM_PUT, HXHIM_GET, HXHIM_GETOP, or HXHIM_DELETE; nullptr otherwise)
+        const Stats::Op *GetStats(const hxhim_op_t op) const;
+
     protected:
         Stats stats;
 
+        // record an event of a child class into one of the stats
+        void AddEvent(Stats::Op &op, const Stats::Event &event);
+
         void BGetOp_loop_init(Message::Request::BGetOp *req,
                               Message::Response::BGetOp *res,
                               const std::size_t i,
@@ -152,6 +221,9 @@ class Datastore {
                               void *&predicate, std::size_t &predicate_len,
                               Blob &key, std::size_t &prefix_len);
 
+        // whether or not an op walks towards larger keys
+        static bool BGetOp_forward(const hxhim_getop_t op);
+
         std::string BGetOp_get_seek(const Blob &key,
                                     std::size_t prefix_len,
                                     std::size_t predicate_len,
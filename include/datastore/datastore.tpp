@@ -60,6 +60,11 @@ void Datastore::Datastore::BGetOp_copy_response(Transform::Callbacks *callbacks,
             res->objects[i][j]    = std::move(RealBlob(object,    object_len,    encoded_object.data_type()));
             res->num_recs[i]++;
             event.size += key.size() + value.size();
+
+            // the last record of a full chunk is where the next chunk starts
+            if (res->num_recs[i] == req->num_recs[i]) {
+                res->rest.cursors[i] = RealBlob(key.size(), key.data(), hxhim_data_t::HXHIM_DATA_BYTE);
+            }
         }
         else {
             res->statuses[i] = DATASTORE_ERROR;
@@ -19,12 +19,48 @@ namespace Datastore {
             size_t double_precision; // used by double encoding
         };
 
+        /**
+         * Callback
+         * A transform function and its extra argument.
+         * A set callback without a function leaves the
+         * data unchanged.
+         */
+        template <typename Func_t>
+        struct Callback {
+            Callback(Func_t func = nullptr, void *extra = nullptr, const bool set = false)
+                : func(func),
+                  extra(extra),
+                  set(set)
+            {}
+
+            Func_t func;
+            void *extra;
+            bool set;    // whether or not this data type can be transformed
+        };
+
+        /**
+         * Callbacks
+         * The known data types are looked up by indexing
+         * into flat arrays. Data types past MAX_KNOWN are
+         * kept in maps.
+         */
         struct Callbacks {
+            typedef Callback<hxhim_encode_func> Encode;
+            typedef Callback<hxhim_decode_func> Decode;
+
+            /** @description Set the callbacks of a data type, replacing any existing ones */
+            void set_encode(const hxhim_data_t type, const Encode &callback);
+            void set_decode(const hxhim_data_t type, const Decode &callback);
+
+            /** @description Find the callbacks of a data type (nullptr if not set) */
+            const Encode *get_encode(const hxhim_data_t type) const;
+            const Decode *get_decode(const hxhim_data_t type) const;
+
             /** All functions should alloc (NOT construct) memory for *dst */
-            std::map<hxhim_data_t,
-                     std::pair<hxhim_encode_func, void *> > encode;
-            std::map<hxhim_data_t,
-                     std::pair<hxhim_decode_func, void *> > decode;
+            Encode encode[HXHIM_DATA_MAX_KNOWN];
+            Decode decode[HXHIM_DATA_MAX_KNOWN];
+            std::map<hxhim_data_t, Encode> other_encode;
+            std::map<hxhim_data_t, Decode> other_decode;
 
             NumericExtra numeric_extra;
         };
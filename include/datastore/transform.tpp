@@ -18,7 +18,7 @@ static void *copy(const std::string &str) {
     return dst;
 }
 
-template <typename T, typename = enable_if_t <std::is_integral<T>::value> >
+template <typename T, typename>
 int integers(void *src, const size_t,
              void **dst, size_t *dst_size,
              void *extra) {
@@ -34,7 +34,7 @@ int integers(void *src, const size_t,
     return DATASTORE_SUCCESS;
 }
 
-template <typename T, typename = enable_if_t <std::is_floating_point<T>::value> >
+template <typename T, typename>
 int floating_point(void *src, const size_t,
                    void **dst, size_t *dst_size,
                    void *extra) {
@@ -56,7 +56,7 @@ int floating_point(void *src, const size_t,
 
 namespace decode {
 
-template <typename T, typename = enable_if_t <std::is_integral<T>::value> >
+template <typename T, typename>
 int integers(void *src, const size_t src_size,
              void **dst, size_t *dst_size,
              void *extra) {
@@ -77,7 +77,7 @@ int integers(void *src, const size_t src_size,
     return DATASTORE_SUCCESS;
 }
 
-template <typename T, typename = enable_if_t <std::is_floating_point<T>::value> >
+template <typename T, typename>
 int floating_point(void *src, const size_t src_size,
                    void **dst, size_t *dst_size,
                    void *extra) {
@@ -1,13 +1,24 @@
 #ifndef HXHIM_TRIPLESTORE_HPP
 #define HXHIM_TRIPLESTORE_HPP
 
+#include <string>
+
 #include "utils/Blob.hpp"
 
+/** @description The length of the key formed from a subject and predicate */
+std::size_t sp_to_key_size(const Blob &subject,
+                           const Blob &predicate);
+
 /** @description Combines a subject and predicate into a key */
 int sp_to_key(const Blob &subject,
               const Blob &predicate,
               Blob *key);
 
+/** @description Combines a subject and predicate into a key, reusing the memory of the string */
+int sp_to_key(const Blob &subject,
+              const Blob &predicate,
+              std::string &key);
+
 /** @description Splits a key into a subject and predicate */
 int key_to_sp(const Blob &key,
               Blob &subject,
@@ -60,20 +60,54 @@ const std::string TRANSPORT                    = "TRANSPORT";
 
 /** MPI Options */
 const std::string MPI_LISTENERS                = "NUM_LISTENERS";                 // positive integer
+const std::string MPI_INGEST_WINDOW            = "INGEST_WINDOW";                 // nonnegative integer (bytes); 0 disables one-sided PUTs
+
+/** Shared Memory Options (NUM_LISTENERS is used for ranks on other nodes) */
+const std::string SHM_RING_SIZE                = "SHM_RING_SIZE";                 // positive integer (bytes)
+
+/** Simulated Transport Options */
+const std::string SIM_RANKS                    = "SIM_RANKS";                     // positive integer
+const std::string SIM_LATENCY                  = "SIM_LATENCY";                   // nonnegative integer (microseconds, optional)
+const std::string SIM_BANDWIDTH                = "SIM_BANDWIDTH";                 // nonnegative integer (bytes per second, optional); 0 is unlimited
+const std::string SIM_JITTER                   = "SIM_JITTER";                    // nonnegative integer (microseconds, optional)
+const std::string SIM_WORKERS                  = "SIM_WORKERS";                   // positive integer (optional)
+const std::string SIM_SEED                     = "SIM_SEED";                      // nonnegative integer (optional)
 
 #if HXHIM_HAVE_THALLIUM
 /** Thallium Options */
 const std::string THALLIUM_MODULE              = "THALLIUM_MODULE";               // See mercury documentation
 const std::string THALLIUM_THREAD_COUNT        = "THALLIUM_THREAD_COUNT";         // -1 or greater integer (optional)
+const std::string THALLIUM_EAGER_SIZE          = "THALLIUM_EAGER_SIZE";           // nonnegative integer (bytes, optional)
+const std::string THALLIUM_DATASTORE_XSTREAMS  = "THALLIUM_DATASTORE_XSTREAMS";   // nonnegative integer (optional)
 #endif
 
 const std::string TRANSPORT_ENDPOINT_GROUP     = "ENDPOINT_GROUP";                // list of ranks or "ALL"
+const std::string ENDPOINT_CACHE_SIZE          = "ENDPOINT_CACHE_SIZE";           // positive integer
 
 /** Asynchronous PUT Settings */
 const std::string START_ASYNC_PUTS_AT          = "START_ASYNC_PUTS_AT";           // nonnegative integer
 
 const std::string MAXIMUM_OPS_PER_REQUEST      = "MAXIMUM_OPS_PER_REQUEST";       // positive integer
 const std::string MAXIMUM_SIZE_PER_REQUEST     = "MAXIMUM_SIZE_PER_REQUEST";      // positive integer
+const std::string MAXIMUM_REQUESTS_IN_FLIGHT   = "MAXIMUM_REQUESTS_IN_FLIGHT";    // positive integer
+
+/** Collective Flush Settings */
+const std::string NODE_AGGREGATION             = "NODE_AGGREGATION";              // boolean
+
+/** Request Scheduling Settings (followed by a name from SCHEDULED_OPS) */
+const std::string SCHEDULE_PRIORITY_PREFIX     = "SCHEDULE_PRIORITY_";            // nonnegative integer; lower values are processed first
+const std::string SCHEDULE_WEIGHT_PREFIX       = "SCHEDULE_WEIGHT_";              // positive integer
+
+/** Flow Control Settings */
+const std::string RANGE_SERVER_CREDIT_BYTES    = "RANGE_SERVER_CREDIT_BYTES";     // nonnegative integer (bytes); 0 is unlimited
+const std::string RANGE_SERVER_CREDIT_OPS      = "RANGE_SERVER_CREDIT_OPS";       // nonnegative integer; 0 is unlimited
+
+/** GETOP Settings */
+const std::string RANGE_SERVER_GETOP_CHUNK     = "RANGE_SERVER_GETOP_CHUNK";      // nonnegative integer (records); 0 is unlimited
+
+/** Chunked PUT Settings */
+const std::string RANGE_SERVER_MAX_OBJECT_SIZE = "RANGE_SERVER_MAX_OBJECT_SIZE";  // nonnegative integer (bytes); 0 is unlimited
+const std::string RANGE_SERVER_PARTIAL_TIMEOUT = "RANGE_SERVER_PARTIAL_TIMEOUT";  // nonnegative integer (milliseconds); 0 is unlimited
 
 /** Histogram Options */
 const std::string HISTOGRAM_FIRST_N            = "HISTOGRAM_FIRST_N";             // unsigned int
@@ -119,6 +153,17 @@ const std::unordered_map<std::string, Datastore::Type> DATASTORES = {
     #endif
 };
 
+/**
+ * Operations whose scheduling can be configured
+ */
+const std::unordered_map<std::string, enum hxhim_op_t> SCHEDULED_OPS = {
+    std::make_pair("PUT",       HXHIM_PUT),
+    std::make_pair("GET",       HXHIM_GET),
+    std::make_pair("GETOP",     HXHIM_GETOP),
+    std::make_pair("DELETE",    HXHIM_DELETE),
+    std::make_pair("HISTOGRAM", HXHIM_HISTOGRAM),
+};
+
 /**
  * Set of predefined hash functions
  */
@@ -140,6 +185,8 @@ const std::unordered_map<std::string, hxhim_hash_t> HASHES = {
 const std::unordered_map<std::string, Transport::Type> TRANSPORTS = {
     std::make_pair("NULL",     Transport::TRANSPORT_NULL),
     std::make_pair("MPI",      Transport::TRANSPORT_MPI),
+    std::make_pair("SHM",      Transport::TRANSPORT_SHM),
+    std::make_pair("SIM",      Transport::TRANSPORT_SIM),
     #if HXHIM_HAVE_THALLIUM
     std::make_pair("THALLIUM", Transport::TRANSPORT_THALLIUM),
     #endif
@@ -193,10 +240,15 @@ const Config::Config DEFAULT_CONFIG = {
 #endif
     std::make_pair(TRANSPORT,                     "NULL"),
     std::make_pair(HASH,                          "RANK_MOD_DATASTORES"),
+    std::make_pair(MPI_INGEST_WINDOW,             "0"),
+    std::make_pair(SHM_RING_SIZE,                 "4194304"),
     std::make_pair(TRANSPORT_ENDPOINT_GROUP,      "ALL"),
+    std::make_pair(ENDPOINT_CACHE_SIZE,           "1024"),
     std::make_pair(START_ASYNC_PUTS_AT,           "0"),
     std::make_pair(MAXIMUM_OPS_PER_REQUEST,       "128"),
     std::make_pair(MAXIMUM_SIZE_PER_REQUEST,      "1048576"),
+    std::make_pair(MAXIMUM_REQUESTS_IN_FLIGHT,    "4"),
+    std::make_pair(NODE_AGGREGATION,              "false"),
     std::make_pair(HISTOGRAM_FIRST_N,             "10"),
     std::make_pair(HISTOGRAM_BUCKET_GEN_NAME,     "10_BUCKETS"),
     std::make_pair(HISTOGRAM_READ_EXISTING,       "true"),
@@ -41,6 +41,9 @@ hxhim_results_t *hxhimFlushDeletes(hxhim_t *hx);
 hxhim_results_t *hxhimFlushHistograms(hxhim_t *hx);
 hxhim_results_t *hxhimFlush(hxhim_t *hx);
 
+/** @description Collective flush where all ranks exchange queued work at the same time */
+hxhim_results_t *hxhimFlushCollective(hxhim_t *hx);
+
 /** @description Function that forces the datastores to flush to the underlying storage */
 hxhim_results_t *hxhimSync(hxhim_t *hx);
 
@@ -35,6 +35,9 @@ Results *FlushDeletes(hxhim_t *hx);
 Results *FlushHistograms(hxhim_t *hx);
 Results *Flush(hxhim_t *hx);
 
+/** @description Collective flush where all ranks exchange queued work at the same time */
+Results *FlushCollective(hxhim_t *hx);
+
 /** @description Function that forces the datastores to flush to the underlying storage */
 Results *Sync(hxhim_t *hx);
 
@@ -42,12 +42,20 @@ int hxhim_set_transform_function(hxhim_t *hx, const enum hxhim_data_t type,
                                          hxhim_decode_func decode, void *decode_extra);
 int hxhim_set_transport_null(hxhim_t *hx);
 int hxhim_set_transport_mpi(hxhim_t *hx, const size_t listeners);
+int hxhim_set_transport_mpi_ingest(hxhim_t *hx, const size_t listeners, const size_t ingest_window);
+int hxhim_set_transport_shm(hxhim_t *hx, const size_t ring_size, const size_t listeners);
+int hxhim_set_transport_sim(hxhim_t *hx, const size_t ranks, const size_t latency, const size_t bandwidth, const size_t jitter, const size_t workers, const size_t seed);
 #if HXHIM_HAVE_THALLIUM
 int hxhim_set_transport_thallium(hxhim_t *hx, const char *module, const int thread_count);
+int hxhim_set_transport_thallium_eager(hxhim_t *hx, const char *module, const int thread_count, const size_t eager_size);
+int hxhim_set_transport_thallium_xstreams(hxhim_t *hx, const char *module, const int thread_count, const size_t eager_size, const size_t xstreams_per_datastore);
 #endif
 int hxhim_add_endpoint_to_group(hxhim_t *hx, const int id);
 int hxhim_clear_endpoint_group(hxhim_t *hx);
 
+/* maximum number of resolved endpoints held by each rank */
+int hxhim_set_endpoint_cache_size(hxhim_t *hx, const size_t count);
+
 /** Asynchronous PUT Settings */
 int hxhim_set_start_async_puts_at(hxhim_t *hx, const size_t count);
 
@@ -55,6 +63,26 @@ int hxhim_set_start_async_puts_at(hxhim_t *hx, const size_t count);
 int hxhim_set_maximum_ops_per_request(hxhim_t *hx, const size_t count);
 int hxhim_set_maximum_size_per_request(hxhim_t *hx, const size_t size);
 
+/* maximum number of packets a single destination can be processing at once */
+int hxhim_set_maximum_requests_in_flight(hxhim_t *hx, const size_t count);
+
+/* funnel collective flushes through one leader rank per node */
+int hxhim_set_node_aggregation(hxhim_t *hx, const int enable);
+
+/* order in which range servers process queued requests */
+int hxhim_set_request_schedule(hxhim_t *hx, const enum hxhim_op_t op, const size_t priority, const size_t weight);
+
+/* amount of outstanding work each range server accepts from all clients (0 is unlimited) */
+int hxhim_set_range_server_credit_bytes(hxhim_t *hx, const size_t bytes);
+int hxhim_set_range_server_credit_ops(hxhim_t *hx, const size_t ops);
+
+/* maximum number of records each GETOP returns at once (0 is unlimited) */
+int hxhim_set_range_server_getop_chunk(hxhim_t *hx, const size_t records);
+
+/* limits on objects that are sent to range servers in chunks (0 is unlimited) */
+int hxhim_set_range_server_max_object_size(hxhim_t *hx, const size_t bytes);
+int hxhim_set_range_server_partial_timeout(hxhim_t *hx, const size_t milliseconds);
+
 int hxhim_set_histogram_first_n(hxhim_t *hx, const size_t count);
 int hxhim_set_histogram_bucket_gen_name(hxhim_t *hx, const char *method);
 int hxhim_set_histogram_bucket_gen_function(hxhim_t *hx, HistogramBucketGenerator_t gen, void *args);
@@ -7,6 +7,8 @@
 
 #if HXHIM_HAVE_THALLIUM
 int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const int thread_count = -1);
+int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const int thread_count, const std::size_t eager_size);
+int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const int thread_count, const std::size_t eager_size, const std::size_t xstreams_per_datastore);
 #endif
 
 int hxhim_set_histogram_bucket_gen_name(hxhim_t *hx, const std::string &method);
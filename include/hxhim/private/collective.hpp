@@ -0,0 +1,527 @@
+#ifndef COLLECTIVE_HPP
+#define COLLECTIVE_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include <mpi.h>
+
+#include "hxhim/private/Results.hpp"
+#include "hxhim/private/hxhim.hpp"
+#include "hxhim/private/process.hpp"
+#include "message/Packer.hpp"
+#include "message/Unpacker.hpp"
+#include "transport/backend/local/RangeServer.hpp"
+#include "utils/little_endian.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+#include "utils/type_traits.hpp"
+
+namespace hxhim {
+namespace collective {
+
+/** @description Packed messages going to or coming from each rank */
+using Buffers = std::vector<std::vector<char> >;
+
+/**
+ * append
+ * Appends a length prefixed packed message to a buffer
+ *
+ * @param dst the buffer to append to
+ * @param buf the packed message
+ * @param len the length of the packed message
+ */
+inline void append(std::vector<char> &dst, const void *buf, const std::size_t len) {
+    const std::size_t offset = dst.size();
+    dst.resize(offset + sizeof(len) + len);
+    little_endian::encode(&dst[offset], len);
+    memcpy(&dst[offset + sizeof(len)], buf, len);
+}
+
+/**
+ * split
+ * Splits a buffer of length prefixed packed messages
+ * into pointers to each packed message
+ *
+ * @param buf  the buffer to split
+ * @param len  the length of the buffer
+ * @return a list of pointers and lengths of the packed messages
+ */
+inline std::list<std::pair<char *, std::size_t> > split(char *buf, const std::size_t len) {
+    std::list<std::pair<char *, std::size_t> > msgs;
+    std::size_t offset = 0;
+    while ((offset + sizeof(std::size_t)) <= len) {
+        std::size_t msg_len = 0;
+        little_endian::decode(msg_len, &buf[offset]);
+        offset += sizeof(msg_len);
+
+        if ((offset + msg_len) > len) {
+            break;
+        }
+
+        msgs.emplace_back(&buf[offset], msg_len);
+        offset += msg_len;
+    }
+
+    return msgs;
+}
+
+/**
+ * exchange
+ * Sends each rank its buffer and receives the buffers
+ * that all other ranks sent to this rank. Counts are
+ * exchanged with MPI_Alltoall and the data with MPI_Alltoallv.
+ *
+ * MPI counts and displacements are ints, so the data is
+ * moved in rounds that each carry at most max_round bytes
+ * to and from each rank. Every rank sends the number of
+ * rounds it needs along with its counts, so all ranks
+ * agree on the number of rounds without another
+ * collective. Usually, everything fits into one round.
+ *
+ * @param comm the communicator that all ranks are in
+ * @param send one buffer for each rank
+ * @param recv the received data
+ * @param recv_displs where each rank's data starts in recv
+ * @param recv_counts how much data came from each rank
+ * @param max_round the most bytes moved to or from this rank in one MPI_Alltoallv
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+inline int exchange(MPI_Comm comm, const Buffers &send,
+                    std::vector<char> &recv,
+                    std::vector<std::size_t> &recv_displs,
+                    std::vector<std::size_t> &recv_counts,
+                    const std::size_t max_round = INT_MAX) {
+    const std::size_t size = send.size();
+    if (!size) {
+        return HXHIM_ERROR;
+    }
+
+    // each rank gets at most its share of a round
+    const std::size_t share = std::max(std::min(max_round, (std::size_t) INT_MAX) / size, (std::size_t) 1);
+
+    // the count going to each rank and the number of rounds this rank needs
+    std::vector<unsigned long long> send_counts(2 * size);
+    unsigned long long rounds = 0;
+    for(std::size_t i = 0; i < size; i++) {
+        rounds = std::max(rounds, (unsigned long long) ((send[i].size() + share - 1) / share));
+    }
+
+    for(std::size_t i = 0; i < size; i++) {
+        send_counts[2 * i]     = send[i].size();
+        send_counts[2 * i + 1] = rounds;
+    }
+
+    std::vector<unsigned long long> counts(2 * size);
+    if (MPI_Alltoall(send_counts.data(), 2, MPI_UNSIGNED_LONG_LONG,
+                     counts.data(), 2, MPI_UNSIGNED_LONG_LONG,
+                     comm) != MPI_SUCCESS) {
+        return HXHIM_ERROR;
+    }
+
+    recv_displs.resize(size);
+    recv_counts.resize(size);
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < size; i++) {
+        recv_displs[i] = total;
+        recv_counts[i] = counts[2 * i];
+        total += recv_counts[i];
+        rounds = std::max(rounds, counts[2 * i + 1]);
+    }
+
+    recv.resize(total);
+
+    std::vector<int> round_send_counts(size);
+    std::vector<int> round_send_displs(size);
+    std::vector<int> round_recv_counts(size);
+    std::vector<int> round_recv_displs(size);
+    std::vector<char> send_buf;
+    std::vector<char> recv_buf;
+    for(unsigned long long round = 0; round < rounds; round++) {
+        const std::size_t offset = round * share;
+
+        send_buf.clear();
+        for(std::size_t i = 0; i < size; i++) {
+            const std::size_t len = (send[i].size() > offset)?std::min(send[i].size() - offset, share):0;
+            round_send_counts[i] = len;
+            round_send_displs[i] = send_buf.size();
+            if (len) {
+                send_buf.insert(send_buf.end(), send[i].begin() + offset, send[i].begin() + offset + len);
+            }
+        }
+
+        std::size_t round_total = 0;
+        for(std::size_t i = 0; i < size; i++) {
+            const std::size_t len = (recv_counts[i] > offset)?std::min(recv_counts[i] - offset, share):0;
+            round_recv_counts[i] = len;
+            round_recv_displs[i] = round_total;
+            round_total += len;
+        }
+
+        // a single round is received in place
+        char *dst = recv.data();
+        if (rounds > 1) {
+            recv_buf.resize(round_total);
+            dst = recv_buf.data();
+        }
+
+        if (MPI_Alltoallv(send_buf.data(), round_send_counts.data(), round_send_displs.data(), MPI_CHAR,
+                          dst, round_recv_counts.data(), round_recv_displs.data(), MPI_CHAR,
+                          comm) != MPI_SUCCESS) {
+            return HXHIM_ERROR;
+        }
+
+        if (rounds > 1) {
+            for(std::size_t i = 0; i < size; i++) {
+                memcpy(&recv[recv_displs[i] + offset], &recv_buf[round_recv_displs[i]], round_recv_counts[i]);
+            }
+        }
+    }
+
+    return HXHIM_SUCCESS;
+}
+
+/** @description A packet addressed from one bootstrap rank to another */
+struct Record {
+    int dst;
+    int src;
+    const char *data;
+    std::size_t len;
+};
+
+/**
+ * append
+ * Appends an addressed packet to a buffer
+ *
+ * @param dst    the buffer to append to
+ * @param record the addressed packet
+ */
+inline void append(std::vector<char> &dst, const Record &record) {
+    const std::size_t offset = dst.size();
+    dst.resize(offset + sizeof(record.dst) + sizeof(record.src) + sizeof(record.len) + record.len);
+
+    char *curr = &dst[offset];
+    little_endian::encode(curr, record.dst);
+    curr += sizeof(record.dst);
+    little_endian::encode(curr, record.src);
+    curr += sizeof(record.src);
+    little_endian::encode(curr, record.len);
+    curr += sizeof(record.len);
+    memcpy(curr, record.data, record.len);
+}
+
+/**
+ * records
+ * Splits a buffer of addressed packets
+ *
+ * @param buf  the buffer to split
+ * @param len  the length of the buffer
+ * @return the addressed packets, which point into buf
+ */
+inline std::vector<Record> records(const char *buf, const std::size_t len) {
+    static const std::size_t header = sizeof(Record::dst) + sizeof(Record::src) + sizeof(Record::len);
+
+    std::vector<Record> recs;
+    std::size_t offset = 0;
+    while ((offset + header) <= len) {
+        Record record;
+        little_endian::decode(record.dst, &buf[offset]);
+        offset += sizeof(record.dst);
+        little_endian::decode(record.src, &buf[offset]);
+        offset += sizeof(record.src);
+        little_endian::decode(record.len, &buf[offset]);
+        offset += sizeof(record.len);
+
+        if ((offset + record.len) > len) {
+            break;
+        }
+
+        record.data = &buf[offset];
+        offset += record.len;
+        recs.push_back(record);
+    }
+
+    return recs;
+}
+
+/**
+ * exchange_by_node
+ * Same as exchange, but in two levels:
+ *     1. Each rank funnels its buffers to its node leader
+ *     2. Leaders merge the buffers by destination node and
+ *        exchange them, so only one message travels
+ *        between each pair of nodes
+ *     3. Leaders scatter the buffers they received to
+ *        the ranks on their node
+ * The funnel and the scatter are exchanges within the
+ * node in which only the leader sends or receives data,
+ * so they are also split into rounds when needed.
+ *
+ * @param hx   the HXHIM session
+ * @param send one buffer for each bootstrap rank
+ * @param recv the received data
+ * @param recv_displs where each rank's data starts in recv
+ * @param recv_counts how much data came from each rank
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+inline int exchange_by_node(hxhim_t *hx, const Buffers &send,
+                            std::vector<char> &recv,
+                            std::vector<std::size_t> &recv_displs,
+                            std::vector<std::size_t> &recv_counts) {
+    decltype(hx->p->collective) &collective = hx->p->collective;
+    const int rank = hx->p->bootstrap.rank;
+    const int size = hx->p->bootstrap.size;
+
+    int node_size = 0;
+    MPI_Comm_size(collective.node, &node_size);
+
+    // address this rank's buffers to the node leader
+    Buffers outgoing(node_size);
+    for(int dst = 0; dst < size; dst++) {
+        if (send[dst].size()) {
+            append(outgoing[0], Record{dst, rank, send[dst].data(), send[dst].size()});
+        }
+    }
+
+    // funnel to the node leader
+    std::vector<char> gathered;
+    std::vector<std::size_t> displs;
+    std::vector<std::size_t> counts;
+    if (exchange(collective.node, outgoing, gathered, displs, counts) != HXHIM_SUCCESS) {
+        return HXHIM_ERROR;
+    }
+    outgoing.clear();
+
+    // leaders merge by destination node and exchange
+    Buffers per_rank(node_size);
+    if (collective.leaders != MPI_COMM_NULL) {
+        int nodes = 0;
+        MPI_Comm_size(collective.leaders, &nodes);
+
+        Buffers per_node(nodes);
+        for(Record const &record : records(gathered.data(), gathered.size())) {
+            append(per_node[collective.node_of[record.dst]], record);
+        }
+
+        std::vector<char> arrived;
+        if (exchange(collective.leaders, per_node, arrived, displs, counts) != HXHIM_SUCCESS) {
+            return HXHIM_ERROR;
+        }
+
+        for(Record const &record : records(arrived.data(), arrived.size())) {
+            append(per_rank[collective.node_rank_of[record.dst]], record);
+        }
+    }
+
+    // leaders scatter to the ranks on their node
+    std::vector<char> incoming;
+    if (exchange(collective.node, per_rank, incoming, displs, counts) != HXHIM_SUCCESS) {
+        return HXHIM_ERROR;
+    }
+
+    // order by source rank
+    std::vector<const Record *> by_src(size, nullptr);
+    const std::vector<Record> recs = records(incoming.data(), incoming.size());
+    for(Record const &record : recs) {
+        by_src[record.src] = &record;
+    }
+
+    recv.clear();
+    recv_displs.resize(size);
+    recv_counts.resize(size);
+    for(int src = 0; src < size; src++) {
+        recv_displs[src] = recv.size();
+        recv_counts[src] = by_src[src]?by_src[src]->len:0;
+        if (by_src[src]) {
+            recv.insert(recv.end(), by_src[src]->data, by_src[src]->data + by_src[src]->len);
+        }
+    }
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * exchange
+ * Exchanges buffers with all other ranks,
+ * through node leaders if node aggregation
+ * is enabled.
+ *
+ * @param hx   the HXHIM session
+ * @param send one buffer for each bootstrap rank
+ * @param recv the received data
+ * @param recv_displs where each rank's data starts in recv
+ * @param recv_counts how much data came from each rank
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+inline int exchange(hxhim_t *hx, const Buffers &send,
+                    std::vector<char> &recv,
+                    std::vector<std::size_t> &recv_displs,
+                    std::vector<std::size_t> &recv_counts) {
+    if (hx->p->collective.node_aggregation) {
+        return exchange_by_node(hx, send, recv, recv_displs, recv_counts);
+    }
+
+    return exchange(hx->p->bootstrap.comm, send, recv, recv_displs, recv_counts);
+}
+
+/**
+ * process
+ * Collective version of hxhim::process.
+ * All ranks must call this function at the same time.
+ * In each round, the first packet for each target range server
+ * is extracted. Local packets are processed directly. Remote
+ * packets are exchanged with all-to-all collectives (optionally
+ * aggregated by node), processed
+ * by the receiving rank, and the responses are returned with a
+ * second all-to-all. Rounds continue until every rank has
+ * emptied its queues.
+ *
+ * @tparam Request_t   the transport request type
+ * @tparam Response_t  the transport response type
+ * @param hx           the HXHIM session
+ * @param queues       the queued requests
+ * @return results of flushing the queue
+ */
+template <typename Request_t,
+          typename Response_t,
+          typename = enable_if_t <is_child_of <Message::Request::Request,   Request_t>::value  &&
+                                  is_child_of <Message::Response::Response, Response_t>::value> >
+hxhim::Results *process(hxhim_t *hx,
+                        hxhim::Queues <Request_t> &queues) {
+    MPI_Comm comm = hx->p->bootstrap.comm;
+    const int rank = hx->p->bootstrap.rank;
+    const int size = hx->p->bootstrap.size;
+
+    hxhim::Results *res = construct<hxhim::Results>();
+
+    while (true) {
+        // stop when no rank has anything left to send
+        int local_work = !!hxhim::remaining(queues);
+        int any_work = 0;
+        if (MPI_Allreduce(&local_work, &any_work, 1, MPI_INT, MPI_MAX, comm) != MPI_SUCCESS) {
+            mlog(HXHIM_CLIENT_ERR, "Rank %d Could not check for collective work", rank);
+            break;
+        }
+
+        if (!any_work) {
+            break;
+        }
+
+        // extract the first packet for each target range server
+        std::list <Request_t *> local;
+        Buffers requests(size);
+        for(std::size_t ds = 0; ds < queues.size(); ds++) {
+            if (!queues[ds].size()) {
+                continue;
+            }
+
+            Request_t *req = queues[ds].front();
+            queues[ds].pop_front();
+
+            // set because they were not set in impl
+            req->src = rank;
+            req->dst = ds;
+            req->dst_rank = hx->p->queues.ds_to_rank[req->dst];
+
+            hx->p->stats.used[req->op].push_back(req->filled());
+            hx->p->stats.outgoing[req->op][req->dst]++;
+
+            if (req->src == req->dst_rank) {
+                local.push_back(req);
+                continue;
+            }
+
+            void *buf = nullptr;
+            std::size_t len = 0;
+            if (Message::Packer::pack(req, &buf, &len) == MESSAGE_SUCCESS) {
+                append(requests[req->dst_rank], buf, len);
+            }
+            else {
+                mlog(HXHIM_CLIENT_ERR, "Rank %d Could not pack %s request for datastore %zu", rank, HXHIM_OP_STR[req->op], ds);
+            }
+
+            dealloc(buf);
+            destruct(req);
+        }
+
+        // send requests to range servers
+        std::vector<char> incoming;
+        std::vector<std::size_t> displs;
+        std::vector<std::size_t> counts;
+        if (exchange(hx, requests, incoming, displs, counts) != HXHIM_SUCCESS) {
+            mlog(HXHIM_CLIENT_ERR, "Rank %d Could not exchange requests", rank);
+            for(Request_t *req : local) {
+                destruct(req);
+            }
+            break;
+        }
+        requests.clear();
+
+        // process requests from other ranks and pack responses for them
+        Buffers responses(size);
+        for(int src = 0; src < size; src++) {
+            for(std::pair<char *, std::size_t> const &msg : split(incoming.data() + displs[src], counts[src])) {
+                Request_t *req = nullptr;
+                if (Message::Unpacker::unpack(&req, msg.first, msg.second) != MESSAGE_SUCCESS) {
+                    mlog(HXHIM_SERVER_WARN, "Rank %d Could not unpack request from %d", rank, src);
+                    continue;
+                }
+
+                Response_t *response = Transport::local::range_server<Response_t, Request_t>(hx, req);
+                destruct(req);
+
+                void *buf = nullptr;
+                std::size_t len = 0;
+                if (Message::Packer::pack(response, &buf, &len) == MESSAGE_SUCCESS) {
+                    append(responses[src], buf, len);
+                }
+                else {
+                    mlog(HXHIM_SERVER_WARN, "Rank %d Could not pack response to %d", rank, src);
+                }
+
+                dealloc(buf);
+                destruct(response);
+            }
+        }
+
+        // process local data while remote responses are pending
+        for(Request_t *req : local) {
+            Response_t *response = Transport::local::range_server<Response_t, Request_t>(hx, req);
+            hxhim::next_chunks(hx, queues, response);
+            hxhim::Result::AddAll(hx, res, response);
+            destruct(req);
+        }
+
+        // return responses
+        if (exchange(hx, responses, incoming, displs, counts) != HXHIM_SUCCESS) {
+            mlog(HXHIM_CLIENT_ERR, "Rank %d Could not exchange responses", rank);
+            break;
+        }
+        responses.clear();
+
+        // serialize results
+        for(int src = 0; src < size; src++) {
+            for(std::pair<char *, std::size_t> const &msg : split(incoming.data() + displs[src], counts[src])) {
+                Response_t *response = nullptr;
+                if (Message::Unpacker::unpack(&response, msg.first, msg.second) != MESSAGE_SUCCESS) {
+                    mlog(HXHIM_CLIENT_WARN, "Rank %d Could not unpack response from %d", rank, src);
+                    continue;
+                }
+
+                hxhim::next_chunks(hx, queues, response);
+                hxhim::Result::AddAll(hx, res, response);
+            }
+        }
+    }
+
+    return res;
+}
+
+}
+}
+
+#endif
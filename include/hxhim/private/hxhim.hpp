@@ -19,7 +19,9 @@
 #include "hxhim/private/Stats.hpp"
 #include "hxhim/struct.h"
 #include "message/Messages.hpp"
+#include "transport/Credits.hpp"
 #include "transport/Options.hpp"
+#include "transport/Scheduler.hpp"
 #include "transport/transport.hpp"
 #include "utils/type_traits.hpp"
 
@@ -74,6 +76,8 @@ typedef struct hxhim_private {
             std::size_t size;              // max bytes to allow
         } max_per_request;
 
+        std::size_t max_in_flight = 4;     // max packets outstanding at one range server per flush
+
         struct {
             hxhim::Queues<Message::Request::BPut> queue;
             std::mutex mutex;
@@ -81,6 +85,7 @@ typedef struct hxhim_private {
             bool flushed;                             // true if flush was called
             bool processing;                          // true if data was popped off of the queue and has not been placed on the results queue yet
             std::size_t count;
+            std::uint32_t chunked;                    // number of objects that have been split into chunks
         } puts;
         hxhim::Queues<Message::Request::BGet>       gets;
         hxhim::Queues<Message::Request::BGetOp>     getops;
@@ -102,6 +107,16 @@ typedef struct hxhim_private {
         hxhim::Results *results;           // the list of of PUT results
     } async_puts;
 
+    // collective flush settings
+    struct {
+        bool node_aggregation;             // whether or not to funnel packets through node leaders
+        MPI_Comm node;                     // ranks on the same node; node rank 0 is the leader
+        MPI_Comm leaders;                  // node leaders; MPI_COMM_NULL on other ranks
+        int node_rank;                     // rank within node
+        std::vector<int> node_of;          // bootstrap rank -> rank of its leader in leaders
+        std::vector<int> node_rank_of;     // bootstrap rank -> rank within its node
+    } collective;
+
     struct {
         std::string name;
         hxhim_hash_t func;                 // the function used to determine which datastore should be used to perform an operation with
@@ -112,7 +127,9 @@ typedef struct hxhim_private {
     struct {
         Transport::Options *config;
         std::set<int> endpointgroup;
+        std::size_t endpoint_cache = 1024; // max resolved endpoints held at once
         Transport::Transport *transport;
+        Transport::Credits credits;        // flow control of packets going to remote range servers
     } transport;
 
     struct {
@@ -145,6 +162,27 @@ typedef struct hxhim_private {
             // f(datastore ID) = (rank, offset)
             std::vector<Datastore::Datastore *> ds;
         } datastores;
+
+        // order in which queued requests are processed
+        Transport::SchedulePolicies schedule = Transport::default_schedule();
+
+        // outstanding requests this range server accepts from all clients (0 is unlimited)
+        struct {
+            std::size_t bytes = 67108864;
+            std::size_t ops = 0;
+        } credits;
+
+        // the shares of the credits given to the clients in responses
+        Transport::Grants grants;
+
+        // maximum number of records each GETOP returns at once (0 is unlimited)
+        std::size_t getop_chunk = 1024;
+
+        // limits on objects that arrive in chunks (0 is unlimited)
+        struct {
+            std::size_t max_size = 1073741824;  // bytes
+            std::size_t timeout = 60000;        // milliseconds
+        } partials;
     } range_server;
 
     hxhim::Stats::Global stats;
@@ -164,6 +202,8 @@ int one_datastore(hxhim_t *hx, const std::string &name);
 int transport    (hxhim_t *hx);
 int queues       (hxhim_t *hx);
 int async_puts   (hxhim_t *hx);
+
+::Datastore::Transform::Callbacks *transform(hxhim_t *hx);
 }
 
 namespace destroy {
@@ -204,6 +244,10 @@ int GetOpImpl(hxhim_t *hx,
               enum hxhim_data_t object_type,
               std::size_t num_records, enum hxhim_getop_t op);
 
+void next_chunks(hxhim_t *hx,
+                 Queues<Message::Request::BGetOp> &getops,
+                 Message::Response::BGetOp *response);
+
 int DeleteImpl(hxhim_t *hx,
                Queues<Message::Request::BDelete> &dels,
                Blob subject,
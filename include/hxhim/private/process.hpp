@@ -1,6 +1,9 @@
 #ifndef PROCESS_HPP
 #define PROCESS_HPP
 
+#include <list>
+#include <tuple>
+
 #include "hxhim/private/Results.hpp"
 #include "hxhim/private/hxhim.hpp"
 #include "transport/backend/local/RangeServer.hpp"
@@ -24,6 +27,16 @@ std::size_t remaining(hxhim::Queues<Request_t> &queues) {
     return count;
 }
 
+/**
+ * next_chunks
+ * Only GETOP responses are returned in chunks
+ */
+template <typename Request_t,
+          typename Response_t,
+          typename = enable_if_t <is_child_of <Message::Request::Request,   Request_t>::value  &&
+                                  is_child_of <Message::Response::Response, Response_t>::value> >
+void next_chunks(hxhim_t *, hxhim::Queues<Request_t> &, Response_t *) {}
+
 template <typename Request_t,
           typename Response_t,
           typename = enable_if_t <is_child_of <Message::Request::Request,   Request_t>::value  &&
@@ -45,39 +58,68 @@ hxhim::Results *process(hxhim_t *hx,
         ::Stats::Chronopoint pop_start = ::Stats::now();
         #endif
 
-        // extract the first packet for each target range server
+        // read before acquiring credits so that returned credits are not missed
+        const std::size_t credit_generation = hx->p->transport.credits.generation();
+
+        // extract the first packet for each target datastore
+        // and keep taking packets going to remote range servers
+        // until each range server has a full window of packets
+        // packets going to remote range servers stay queued
+        // until there are credits available to send them
         std::list <Request_t *> local;
         Transport::ReqList <Request_t> remote;
-        for(std::size_t ds = 0; ds < queues.size(); ds++) {
-            if (!queues[ds].size()) {
-                continue;
-            }
-
-            Request_t *req = queues[ds].front();
-            queues[ds].pop_front();
+        std::list<std::tuple<int, std::size_t, std::size_t> > credits; // rank, bytes, and ops taken by each packet
+        for(bool first = true, added = true; added; first = false) {
+            added = false;
+            for(std::size_t ds = 0; ds < queues.size(); ds++) {
+                if (!queues[ds].size()) {
+                    continue;
+                }
+
+                Request_t *req = queues[ds].front();
+                const int dst_rank = hx->p->queues.ds_to_rank[ds];
+                if (dst_rank == hx->p->bootstrap.rank) {
+                    // local packets are processed one per datastore at a time
+                    if (!first) {
+                        continue;
+                    }
+                }
+                else {
+                    const std::size_t bytes = req->size();
+                    if ((remote.count(dst_rank) >= hx->p->queues.max_in_flight) ||
+                        !hx->p->transport.credits.acquire(dst_rank, bytes, req->count)) {
+                        continue;
+                    }
+
+                    credits.emplace_back(dst_rank, bytes, req->count);
+                }
+
+                queues[ds].pop_front();
+                added = true;
+
+                // set because they were not set in impl
+                req->src = hx->p->bootstrap.rank;
+                req->dst = ds;
+                req->dst_rank = dst_rank;
+
+                if (req->src == req->dst_rank) {
+                    local.push_back(req);
+                }
+                else {
+                    remote.emplace(req->dst_rank, req);
+                }
 
-            // set because they were not set in impl
-            req->src = hx->p->bootstrap.rank;
-            req->dst = ds;
-            req->dst_rank = hx->p->queues.ds_to_rank[req->dst];
-
-            if (req->src == req->dst_rank) {
-                local.push_back(req);
-            }
-            else {
-                remote[req->dst_rank] = req;
+                #if PRINT_TIMESTAMPS
+                ::Stats::Chronopoint collect_stats_start = ::Stats::now();
+                #endif
+                hx->p->stats.used[req->op].push_back(req->filled());
+                hx->p->stats.outgoing[req->op][req->dst]++;
+                #if PRINT_TIMESTAMPS
+                ::Stats::Chronopoint collect_stats_end = ::Stats::now();
+                ::Stats::print_event(hx->p->print_buffer, rank, "collect_stats",
+                    ::Stats::global_epoch, collect_stats_start, collect_stats_end);
+                #endif
             }
-
-            #if PRINT_TIMESTAMPS
-            ::Stats::Chronopoint collect_stats_start = ::Stats::now();
-            #endif
-            hx->p->stats.used[req->op].push_back(req->filled());
-            hx->p->stats.outgoing[req->op][req->dst]++;
-            #if PRINT_TIMESTAMPS
-            ::Stats::Chronopoint collect_stats_end = ::Stats::now();
-            ::Stats::print_event(hx->p->print_buffer, rank, "collect_stats",
-                ::Stats::global_epoch, collect_stats_start, collect_stats_end);
-            #endif
         }
 
         #if PRINT_TIMESTAMPS
@@ -102,6 +144,17 @@ hxhim::Results *process(hxhim_t *hx,
             ::Stats::Chronopoint serialize_start = ::Stats::now();
             #endif
 
+            // the range servers send their current grants with their responses
+            for(Message::Response::Response *curr = response; curr; curr = curr->next) {
+                if ((curr->src >= 0) && ((std::size_t) curr->src < hx->p->queues.ds_to_rank.size())) {
+                    hx->p->transport.credits.grant(hx->p->queues.ds_to_rank[curr->src],
+                                                   curr->grant.bytes, curr->grant.ops);
+                }
+            }
+
+            // request the rest of responses that were cut off
+            hxhim::next_chunks(hx, queues, response);
+
             // serialize results
             hxhim::Result::AddAll(hx, res, response);
 
@@ -116,6 +169,11 @@ hxhim::Results *process(hxhim_t *hx,
                 destruct(req.second);
             }
 
+            // the responses have arrived, so the range servers are done with the packets
+            for(REF(credits)::value_type const &taken : credits) {
+                hx->p->transport.credits.release(std::get<0>(taken), std::get<1>(taken), std::get<2>(taken));
+            }
+
             #if PRINT_TIMESTAMPS
             ::Stats::Chronopoint destruct_end = ::Stats::now();
             ::Stats::print_event(hx->p->print_buffer, rank, "destruct",
@@ -123,6 +181,12 @@ hxhim::Results *process(hxhim_t *hx,
             #endif
         }
 
+        // wait for another thread to return credits
+        if (!remote.size() && !local.size()) {
+            hx->p->transport.credits.wait(credit_generation);
+            continue;
+        }
+
         // process local data
         if (local.size()) {
             for(Request_t *req : local) {
@@ -140,6 +204,9 @@ hxhim::Results *process(hxhim_t *hx,
                 ::Stats::Chronopoint serialize_start = ::Stats::now();
                 #endif
 
+                // request the rest of responses that were cut off
+                hxhim::next_chunks(hx, queues, response);
+
                 // serialize results
                 hxhim::Result::AddAll(hx, res, response);
 
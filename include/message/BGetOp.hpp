@@ -15,12 +15,14 @@ struct BGetOp final : SubjectPredicate {
     std::size_t add(Blob subject, Blob predicate,
                     hxhim_data_t object_type,
                     std::size_t num_rec,
-                    hxhim_getop_t op);
+                    hxhim_getop_t op,
+                    Blob cursor = Blob());
     int cleanup();
 
     hxhim_data_t *object_types;
     std::size_t *num_recs;            // number of records to get back
     hxhim_getop_t *ops;
+    Blob *cursors;                    // encoded key of the last record of the previous chunk (empty for the first chunk)
 };
 
 }
@@ -43,6 +45,14 @@ struct BGetOp final : Response { // does not inherit SubjectPredicate
     // add the size of the latest set of responses
     std::size_t update_size(const std::size_t);
 
+    // records of op i that did not fit into this chunk
+    std::size_t set_rest(const std::size_t i,
+                         Blob subject, Blob predicate,
+                         hxhim_data_t object_type,
+                         std::size_t num_rec,
+                         hxhim_getop_t op,
+                         Blob cursor);
+
     int steal(BGetOp *bgetop, const std::size_t i);
     int cleanup();
 
@@ -52,6 +62,17 @@ struct BGetOp final : Response { // does not inherit SubjectPredicate
     Blob **subjects;
     Blob **predicates;
     Blob **objects;
+
+    // the original ops of responses that were cut off at the
+    // chunk size, used by clients to request the next chunk
+    struct {
+        std::size_t *num_recs;        // number of records not returned yet (0 if done)
+        hxhim_getop_t *ops;
+        hxhim_data_t *object_types;
+        Blob *subjects;
+        Blob *predicates;
+        Blob *cursors;                // encoded key of the last record in this chunk
+    } rest;
 };
 
 }
@@ -1,6 +1,8 @@
 #ifndef BPUT_MESSAGE_HPP
 #define BPUT_MESSAGE_HPP
 
+#include <cstdint>
+
 #include "message/SubjectPredicate.hpp"
 
 namespace Message {
@@ -8,14 +10,36 @@ namespace Message {
 namespace Request {
 
 struct BPut final : SubjectPredicate {
+    // objects that are too large for one packet are sent as chunks
+    struct Chunk {
+        std::uint64_t id;      // shared by all chunks of one object; 0 if the object was not split
+        std::size_t offset;    // where the chunk starts within the full object
+        std::size_t total;     // size of the full object
+    };
+
     BPut(const std::size_t max = 0);
     ~BPut();
 
     void alloc(const std::size_t max);
-    std::size_t add(Blob subject, Blob predicate, Blob object);
+    std::size_t add(Blob subject, Blob predicate, Blob object, const Chunk &chunk = Chunk());
     int cleanup();
 
+    // number of bytes the chunk information of an object is packed into
+    static std::size_t chunk_size(const Chunk &chunk);
+
+    // number of bytes a type always takes up, or 0 if the size varies
+    static std::size_t fixed_width(const hxhim_data_t type);
+
+    // returns the type of the objects if all of them are the same fixed width type
+    hxhim_data_t single_type(std::size_t *width = nullptr) const;
+
     Blob *objects;
+
+    // only chunks with non-zero ids are chunks of larger objects
+    Chunk *chunks;
+
+    // objects unpacked from a single type packet reference this buffer
+    Blob single_type_objects;
 };
 
 }
@@ -35,6 +35,7 @@ struct Message {
     enum hxhim_op_t op;
     int src;  // request: rank;  response: ds_id
     int dst;  // request: ds_id; response: rank
+    std::size_t seq;    // set by the transport on requests and copied into their responses
     std::size_t max_count;
     std::size_t count;
     std::size_t serialized_size;
@@ -19,6 +19,12 @@ struct Response : Message {
 
     int *statuses; // DATASTORE_SUCCESS or DATASTORE_ERROR
 
+    // credits the range server grants to the client (0 is unlimited)
+    struct {
+        std::size_t bytes;
+        std::size_t ops;
+    } grant;
+
     Response *next;
 
   protected:
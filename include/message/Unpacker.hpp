@@ -29,12 +29,18 @@ class Unpacker {
         static int unpack(Response::BDelete    **bdm,    void *buf, const std::size_t bufsize);
         static int unpack(Response::BHistogram **bhm,    void *buf, const std::size_t bufsize);
 
+        /** Reads the operation and destination of a packed message without unpacking it */
+        static int peek(void *buf, const std::size_t bufsize, enum hxhim_op_t *op, int *dst);
+
     private:
         /** Allocates space for a temporary message and unpacks only the header */
         static int unpack(Message              **msg,    void *buf, const std::size_t bufsize);
 
         /** Unpacks the message header in a preallocated space */
         static int unpack(Message              *msg,     void *buf, const std::size_t bufsize, char **curr);
+
+        /** Unpacks the message header and the response header in a preallocated space */
+        static int unpack(Response::Response   *res,     void *buf, const std::size_t bufsize, char **curr);
 };
 
 }
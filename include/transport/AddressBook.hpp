@@ -0,0 +1,63 @@
+#ifndef TRANSPORT_ADDRESS_BOOK_HPP
+#define TRANSPORT_ADDRESS_BOOK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <mpi.h>
+
+namespace Transport {
+
+/**
+ * AddressBook
+ * The addresses of the ranks of a communicator, shared by
+ * all of the ranks on a node.
+ *
+ * Instead of every rank gathering the address of every
+ * other rank, each node gathers the addresses of its ranks
+ * to a node leader, the node leaders exchange addresses
+ * with each other, and each leader writes the result into
+ * a shared memory window that the other ranks on its node
+ * read from. Only one copy of the addresses exists per node,
+ * and only the node leaders take part in the exchange
+ * between nodes.
+ *
+ * Ranks that do not publish an address have an empty
+ * address.
+ *
+ * The address book is created and destroyed collectively.
+ */
+class AddressBook {
+    public:
+        /** @description Collective over comm */
+        AddressBook(const MPI_Comm comm, const std::string &self, const bool publish);
+
+        /** @description Collective over the ranks on this node */
+        ~AddressBook();
+
+        /** @description Whether or not the addresses were exchanged successfully */
+        bool Valid() const;
+
+        /** @description The number of ranks in the communicator */
+        int Size() const;
+
+        /** @description Get the address of a rank; returns false if it does not have one */
+        bool get(const int rank, std::string &address) const;
+
+    private:
+        /** @description Exchange addresses and fill in the shared table */
+        bool exchange(const MPI_Comm comm, const std::string &self, const bool publish);
+
+        int size;
+        MPI_Comm node;
+        MPI_Win win;
+
+        // the shared table: size + 1 offsets followed by the addresses
+        const std::int64_t *offsets;
+        const char *addresses;
+};
+
+}
+
+#endif
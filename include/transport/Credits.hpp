@@ -0,0 +1,117 @@
+#ifndef TRANSPORT_CREDITS_HPP
+#define TRANSPORT_CREDITS_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include "message/Response.hpp"
+#include "utils/Stats.hpp"
+
+namespace Transport {
+
+/**
+ * Credits
+ * The client side of the flow control between clients
+ * and range servers.
+ *
+ * Each range server has a budget of bytes and operations
+ * that it is willing to have outstanding, which it splits
+ * between the clients that are sending to it (see Grants).
+ * The grants arrive in the headers of responses. A client
+ * takes credits out of its grant before sending a packet
+ * and returns them once the response has arrived. Packets
+ * that do not fit into the remaining credits stay in the
+ * client's queues.
+ *
+ * A client can always send one packet to a range server it
+ * has nothing outstanding at, even if the packet is larger
+ * than its grant, so every client makes progress. A client
+ * therefore has at most max(grant, size of one packet)
+ * outstanding at each range server. Packets are limited by
+ * the maximum request size, except for a single operation
+ * whose subject and predicate do not fit by themselves.
+ *
+ * Until the first grant of a range server has arrived, a
+ * client only sends one packet at a time to it. A grant of
+ * 0 bytes or 0 operations does not limit that resource.
+ */
+class Credits {
+    public:
+        Credits();
+
+        /** @description Set the credits granted by the range server on rank */
+        void grant(const int rank, const std::size_t bytes, const std::size_t ops);
+
+        /** @description Try to take the credits needed to send a packet */
+        bool acquire(const int rank, const std::size_t bytes, const std::size_t ops);
+
+        /** @description Return the credits of a packet whose response has arrived */
+        void release(const int rank, const std::size_t bytes, const std::size_t ops);
+
+        /** @description Changes every time credits are returned */
+        std::size_t generation();
+
+        /** @description Wait until credits have been returned since generation was read */
+        void wait(const std::size_t since);
+
+        /** @description The part of a range server budget granted to each of its clients */
+        static std::size_t share(const std::size_t budget, const std::size_t clients);
+
+    private:
+        struct Account {
+            bool granted;                   // whether a grant has arrived
+            std::size_t granted_bytes;
+            std::size_t granted_ops;
+            std::size_t bytes;              // outstanding
+            std::size_t ops;                // outstanding
+            std::size_t packets;            // outstanding
+        };
+
+        std::unordered_map<int, Account> accounts;
+        std::size_t returned;
+        std::mutex mutex;
+        std::condition_variable cv;
+};
+
+/**
+ * Grants
+ * The range server side of the flow control between
+ * clients and range servers.
+ *
+ * The budget of the range server is split evenly between
+ * the clients that have sent a request within the last
+ * ACTIVE_MS milliseconds, and the share is placed into the
+ * header of each response. Grants grow as clients go idle
+ * and shrink as more clients send requests, so the total
+ * outstanding at the range server stays near the budget
+ * once every client has received its current grant.
+ */
+class Grants {
+    public:
+        static const std::size_t ACTIVE_MS = 1000;
+
+        Grants();
+
+        /** @description Set the budget of the range server (0 is unlimited) */
+        void budget(const std::size_t bytes, const std::size_t ops);
+
+        /** @description Record a request from client and place its grant into the response */
+        void issue(const int client, Message::Response::Response *res);
+
+        /** @description The number of clients that have sent requests recently */
+        std::size_t active();
+
+    private:
+        std::size_t bytes;
+        std::size_t ops;
+
+        std::unordered_map<int, ::Stats::Chronopoint> seen; // when each client last sent a request
+        ::Stats::Chronopoint swept;                        // when idle clients were last removed
+        std::mutex mutex;
+};
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef TRANSPORT_ENDPOINT_CACHE_HPP
+#define TRANSPORT_ENDPOINT_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Transport {
+
+/**
+ * EndpointCache
+ * A bounded least recently used cache of endpoints.
+ *
+ * Endpoints are resolved the first time they are needed
+ * instead of during initialization, so the number of
+ * endpoints a rank holds depends on how many ranks it
+ * talks to, not on the size of the job. Once the cache is
+ * full, the endpoint that has not been used for the longest
+ * time is dropped, and will be resolved again if it is
+ * needed later.
+ *
+ * Endpoints are copied out of the cache, so they should be
+ * cheap to copy (e.g. std::shared_ptr) and stay valid after
+ * being evicted.
+ *
+ * @tparam Endpoint the type of the cached endpoints
+ */
+template <typename Endpoint>
+class EndpointCache {
+    public:
+        /** @description Resolves the endpoint of a rank; returns false if it cannot be resolved */
+        typedef std::function<bool(const int rank, Endpoint &endpoint)> Resolver;
+
+        /** @param capacity the maximum number of endpoints held (0 is treated as 1) */
+        EndpointCache(const std::size_t capacity, const Resolver &resolve);
+
+        /** @description Get an endpoint, resolving it if it is not cached */
+        bool get(const int rank, Endpoint &endpoint);
+
+        /** @description Cache an endpoint that was resolved elsewhere */
+        void put(const int rank, const Endpoint &endpoint);
+
+        /** @description Drop an endpoint */
+        void erase(const int rank);
+
+        /** @description Drop all endpoints */
+        void clear();
+
+        std::size_t size() const;
+        std::size_t capacity() const;
+
+        /** @description The number of times an endpoint had to be resolved */
+        std::size_t misses() const;
+
+    private:
+        typedef std::list<std::pair<int, Endpoint> > Entries;
+
+        void insert(const int rank, const Endpoint &endpoint);
+
+        const std::size_t max;
+        Resolver resolve;
+
+        Entries entries;                                                 // most recently used first
+        std::unordered_map<int, typename Entries::iterator> lookup;
+        std::size_t resolved;
+        mutable std::mutex mutex;
+};
+
+}
+
+#include "transport/EndpointCache.tpp"
+
+#endif
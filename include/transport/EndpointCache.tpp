@@ -0,0 +1,112 @@
+template <typename Endpoint>
+Transport::EndpointCache<Endpoint>::EndpointCache(const std::size_t capacity, const Resolver &resolve)
+    : max(capacity?capacity:1),
+      resolve(resolve),
+      entries(),
+      lookup(),
+      resolved(0),
+      mutex()
+{}
+
+/**
+ * get
+ * The resolver is called without holding the lock,
+ * so a slow lookup does not block other threads from
+ * using endpoints that are already cached. If two
+ * threads resolve the same rank at the same time,
+ * the second result replaces the first.
+ *
+ * @param rank      the rank whose endpoint is needed
+ * @param endpoint  where to place the endpoint
+ * @return whether or not the endpoint was found
+ */
+template <typename Endpoint>
+bool Transport::EndpointCache<Endpoint>::get(const int rank, Endpoint &endpoint) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        typename std::unordered_map<int, typename Entries::iterator>::iterator it = lookup.find(rank);
+        if (it != lookup.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            endpoint = it->second->second;
+            return true;
+        }
+    }
+
+    Endpoint found;
+    if (!resolve || !resolve(rank, found)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    resolved++;
+    insert(rank, found);
+    endpoint = found;
+    return true;
+}
+
+template <typename Endpoint>
+void Transport::EndpointCache<Endpoint>::put(const int rank, const Endpoint &endpoint) {
+    std::lock_guard<std::mutex> lock(mutex);
+    insert(rank, endpoint);
+}
+
+template <typename Endpoint>
+void Transport::EndpointCache<Endpoint>::erase(const int rank) {
+    std::lock_guard<std::mutex> lock(mutex);
+    typename std::unordered_map<int, typename Entries::iterator>::iterator it = lookup.find(rank);
+    if (it != lookup.end()) {
+        entries.erase(it->second);
+        lookup.erase(it);
+    }
+}
+
+template <typename Endpoint>
+void Transport::EndpointCache<Endpoint>::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lookup.clear();
+    entries.clear();
+}
+
+template <typename Endpoint>
+std::size_t Transport::EndpointCache<Endpoint>::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+template <typename Endpoint>
+std::size_t Transport::EndpointCache<Endpoint>::capacity() const {
+    return max;
+}
+
+template <typename Endpoint>
+std::size_t Transport::EndpointCache<Endpoint>::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return resolved;
+}
+
+/**
+ * insert
+ * Places an endpoint at the front of the cache,
+ * evicting the least recently used endpoint if
+ * the cache is full. The caller holds the lock.
+ *
+ * @param rank      the rank of the endpoint
+ * @param endpoint  the endpoint
+ */
+template <typename Endpoint>
+void Transport::EndpointCache<Endpoint>::insert(const int rank, const Endpoint &endpoint) {
+    typename std::unordered_map<int, typename Entries::iterator>::iterator it = lookup.find(rank);
+    if (it != lookup.end()) {
+        it->second->second = endpoint;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    if (entries.size() >= max) {
+        lookup.erase(entries.back().first);
+        entries.pop_back();
+    }
+
+    entries.emplace_front(rank, endpoint);
+    lookup[rank] = entries.begin();
+}
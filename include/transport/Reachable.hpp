@@ -0,0 +1,40 @@
+#ifndef TRANSPORT_REACHABLE_HPP
+#define TRANSPORT_REACHABLE_HPP
+
+#include <cstddef>
+#include <set>
+
+namespace Transport {
+
+/**
+ * Reachable
+ * Decides whether an endpoint group may send requests
+ * to a rank. The answer is computed from the range server
+ * layout when it is needed instead of from a table of every
+ * range server built during initialization.
+ *
+ * A rank is reachable if it is a range server, is not this
+ * rank, and is in the endpoint group. An empty endpoint
+ * group contains every rank.
+ */
+class Reachable {
+    public:
+        Reachable(const int rank,
+                  const int size,
+                  const std::size_t client_ratio,
+                  const std::size_t server_ratio,
+                  const std::set<int> &endpointgroup);
+
+        bool operator()(const int dst) const;
+
+    private:
+        int rank;
+        int size;
+        std::size_t client_ratio;
+        std::size_t server_ratio;
+        std::set<int> endpointgroup;
+};
+
+}
+
+#endif
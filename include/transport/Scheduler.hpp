@@ -0,0 +1,99 @@
+#ifndef TRANSPORT_SCHEDULER_HPP
+#define TRANSPORT_SCHEDULER_HPP
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include "hxhim/constants.h"
+
+namespace Transport {
+
+/**
+ * SchedulePolicy
+ * How range servers order the requests of one operation
+ */
+struct SchedulePolicy {
+    std::size_t priority;   // lower values are served first
+    std::size_t weight;     // requests served per round before lower priorities get a turn (0 is treated as 1)
+};
+
+/** @description Policies indexed by hxhim_op_t */
+typedef std::array<SchedulePolicy, HXHIM_INVALID> SchedulePolicies;
+
+/** @description Reads are served ahead of writes */
+SchedulePolicies default_schedule();
+
+/**
+ * Scheduler
+ * Orders requests waiting for the datastores of a range server.
+ *
+ * Each datastore has its own queues, and datastores with
+ * waiting requests are served round robin, so a backlog for
+ * one datastore does not delay the others.
+ *
+ * Within a datastore, there is one queue per operation. The
+ * queue with the best priority is served first, but each
+ * operation can only be served weight times per round. A round
+ * ends when none of the waiting operations have any turns left,
+ * so every waiting operation is served at least once per round.
+ * With the defaults, a GET waits behind at most one bulk PUT
+ * per datastore instead of every PUT that arrived before it.
+ *
+ * When several threads remove requests, acquire and release
+ * hand each datastore to one thread at a time, so requests of
+ * the same operation on a datastore finish in the order they
+ * were queued.
+ *
+ * This class does not lock. Callers serialize access.
+ *
+ * @tparam T the type of the queued requests
+ */
+template <typename T>
+class Scheduler {
+    public:
+        Scheduler(const std::size_t datastores, const SchedulePolicies &policies);
+
+        /** @description Queue a request for a datastore */
+        void push(const std::size_t datastore, const enum hxhim_op_t op, const T &item);
+
+        /** @description Remove the next request to process */
+        bool pop(T &item);
+
+        /** @description Remove the next request of a datastore that is not busy and mark it busy */
+        bool acquire(T &item, std::size_t &datastore);
+
+        /** @description Allow the requests of a datastore to be acquired again */
+        void release(const std::size_t datastore);
+
+        /** @description Whether or not acquire would remove a request */
+        bool acquirable() const;
+
+        std::size_t size() const;
+
+        /** @description Remove every queued request */
+        std::list<T> clear();
+
+    private:
+        struct Queues {
+            std::array<std::list<T>, HXHIM_INVALID> ops;
+            std::array<std::size_t, HXHIM_INVALID> turns;   // turns left in this round
+            std::size_t count;
+            bool busy;                                      // a request was acquired and not released
+        };
+
+        bool pop(Queues &queues, T &item);
+
+        SchedulePolicies policies;
+        std::vector<enum hxhim_op_t> order;  // operations from best to worst priority
+        std::vector<Queues> datastores;
+        std::size_t next;                     // datastore to check first
+        std::size_t count;
+};
+
+}
+
+#include "transport/Scheduler.tpp"
+
+#endif
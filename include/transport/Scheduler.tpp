@@ -0,0 +1,182 @@
+#include <algorithm>
+
+template <typename T>
+Transport::Scheduler<T>::Scheduler(const std::size_t datastores, const SchedulePolicies &policies)
+    : policies(policies),
+      order(),
+      datastores(datastores?datastores:1),
+      next(0),
+      count(0)
+{
+    for(SchedulePolicy &policy : this->policies) {
+        if (!policy.weight) {
+            policy.weight = 1;
+        }
+    }
+
+    for(std::size_t op = 0; op < this->policies.size(); op++) {
+        order.push_back((enum hxhim_op_t) op);
+    }
+
+    // ties keep the order of hxhim_op_t
+    std::stable_sort(order.begin(), order.end(),
+                     [this](const enum hxhim_op_t lhs, const enum hxhim_op_t rhs) -> bool {
+                         return this->policies[lhs].priority < this->policies[rhs].priority;
+                     });
+
+    for(Queues &queues : this->datastores) {
+        for(std::size_t op = 0; op < queues.turns.size(); op++) {
+            queues.turns[op] = this->policies[op].weight;
+        }
+        queues.count = 0;
+        queues.busy = false;
+    }
+}
+
+/**
+ * push
+ * Requests for datastores outside of the range of
+ * this scheduler are wrapped around. Requests with
+ * invalid operations are queued as the lowest
+ * priority operation.
+ *
+ * @param datastore  the offset of the target datastore on this range server
+ * @param op         the operation of the request
+ * @param item       the request
+ */
+template <typename T>
+void Transport::Scheduler<T>::push(const std::size_t datastore, const enum hxhim_op_t op, const T &item) {
+    Queues &queues = datastores[datastore % datastores.size()];
+    const enum hxhim_op_t queue = (op < HXHIM_INVALID)?op:order.back();
+    queues.ops[queue].push_back(item);
+    queues.count++;
+    count++;
+}
+
+/**
+ * pop
+ *
+ * @param item where to place the next request
+ * @return whether or not a request was removed
+ */
+template <typename T>
+bool Transport::Scheduler<T>::pop(T &item) {
+    if (!count) {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < datastores.size(); i++) {
+        Queues &queues = datastores[next];
+        next = (next + 1) % datastores.size();
+
+        if (pop(queues, item)) {
+            count--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * acquire
+ * Datastores that are busy are skipped. The datastore
+ * of the removed request stays busy until it is released.
+ *
+ * @param item       where to place the next request
+ * @param datastore  the offset of the datastore of the request
+ * @return whether or not a request was removed
+ */
+template <typename T>
+bool Transport::Scheduler<T>::acquire(T &item, std::size_t &datastore) {
+    if (!count) {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < datastores.size(); i++) {
+        const std::size_t ds = next;
+        Queues &queues = datastores[ds];
+        next = (next + 1) % datastores.size();
+
+        if (!queues.busy && pop(queues, item)) {
+            queues.busy = true;
+            datastore = ds;
+            count--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * release
+ *
+ * @param datastore  the offset returned by acquire
+ */
+template <typename T>
+void Transport::Scheduler<T>::release(const std::size_t datastore) {
+    datastores[datastore % datastores.size()].busy = false;
+}
+
+template <typename T>
+bool Transport::Scheduler<T>::acquirable() const {
+    for(Queues const &queues : datastores) {
+        if (!queues.busy && queues.count) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+bool Transport::Scheduler<T>::pop(Queues &queues, T &item) {
+    if (!queues.count) {
+        return false;
+    }
+
+    // the second pass starts a new round
+    for(int pass = 0; pass < 2; pass++) {
+        for(const enum hxhim_op_t op : order) {
+            std::list<T> &queue = queues.ops[op];
+            if (queue.size() && queues.turns[op]) {
+                queues.turns[op]--;
+                item = queue.front();
+                queue.pop_front();
+                queues.count--;
+                return true;
+            }
+        }
+
+        for(std::size_t op = 0; op < queues.turns.size(); op++) {
+            queues.turns[op] = policies[op].weight;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+std::size_t Transport::Scheduler<T>::size() const {
+    return count;
+}
+
+/**
+ * clear
+ *
+ * @return every request that was queued
+ */
+template <typename T>
+std::list<T> Transport::Scheduler<T>::clear() {
+    std::list<T> all;
+    for(Queues &queues : datastores) {
+        for(std::list<T> &queue : queues.ops) {
+            all.splice(all.end(), queue);
+        }
+        queues.count = 0;
+        queues.busy = false;
+    }
+    count = 0;
+    return all;
+}
@@ -2,11 +2,15 @@
 #define TRANSPORT_MPI_ENDPOINT_GROUP_HPP
 
 #include <atomic>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <mpi.h>
 
 #include "transport/backend/MPI/EndpointBase.hpp"
+#include "transport/backend/MPI/IngestWindow.hpp"
+#include "transport/Reachable.hpp"
 #include "transport/transport.hpp"
 #include "utils/type_traits.hpp"
 #include "utils/mlog2.h"
@@ -22,16 +26,13 @@ namespace MPI {
 class EndpointGroup : virtual public ::Transport::EndpointGroup, virtual public EndpointBase {
     public:
         EndpointGroup(const MPI_Comm comm,
-                      volatile std::atomic_bool &running);
+                      volatile std::atomic_bool &running,
+                      const std::size_t preposted_size,
+                      const Reachable &reachable,
+                      const std::shared_ptr<IngestWindow> &ingest = nullptr);
 
         ~EndpointGroup();
 
-        /** @description Add a mapping from a unique ID to a MPI rank */
-        void AddID(const int id, const int rank);
-
-        /** @ description Remove a unique ID from the map */
-        void RemoveID(const int id);
-
         /** @description Bulk Put to multiple endpoints    */
         Message::Response::BPut *communicate(const ReqList<Message::Request::BPut> &bpm_list);
 
@@ -60,16 +61,40 @@ class EndpointGroup : virtual public ::Transport::EndpointGroup, virtual public
                                          std::is_base_of<Message::Response::Response, Recv_t>::value> >
         Recv_t *return_msgs(const ReqList<Send_t> &messages);
 
-        /** @description Mapping from unique ids to MPI ranks */
-        std::unordered_map<int, int> ranks;
+        /** @description Wait for the responses to the requests recorded in srvs and seqs */
+        template <typename Recv_t, typename = enable_if_t<std::is_base_of<Message::Response::Response, Recv_t>::value> >
+        Recv_t *collect(const std::size_t count);
+
+        /** @description Append PUTs to the ingest windows of the range servers */
+        std::size_t ingest_puts(const ReqList<Message::Request::BPut> &bpm_list,
+                                ReqList<Message::Request::BPut> &rejected);
 
         volatile std::atomic_bool &running;
 
-        /** Memory that is only allocated once during the lifetime of EndpointGroup
+        /** @description Requests up to this size fit into the pre-posted receives of the range servers */
+        const std::size_t preposted_size;
+
+        /** @description Which ranks requests can be sent to */
+        const Reachable reachable;
+
+        /** @description One-sided PUT path (may be nullptr) */
+        std::shared_ptr<IngestWindow> ingest;
+
+        /** @description Only one thread can communicate at a time because
+                         the buffers below are shared and responses are
+                         matched by source rank, not by caller */
+        std::mutex mutex;
+
+        /** Memory that is reused during the lifetime of EndpointGroup
             and is only used by one function at a time */
-        std::size_t *lens; // buffer lengths
-        int *dsts;         // request destination servers
-        int *srvs;         // response source servers
+        std::vector<std::size_t> lens;    // buffer lengths
+        std::vector<int> dsts;            // request destination servers
+        std::vector<int> srvs;            // response source servers
+        std::vector<std::size_t> seqs;    // sequence IDs of the requests in flight
+
+        std::vector<void *> bufs;         // packed requests
+        std::vector<MPI_Request> reqs;    // sends in flight
+        std::vector<int> indices;         // completed sends
 };
 
 }
@@ -1,8 +1,9 @@
-#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "hxhim/constants.h"
 #include "transport/backend/MPI/constants.h"
+#include "utils/Backoff.hpp"
 #include "utils/macros.hpp"
 #include "utils/memory.hpp"
 #include "utils/mlog2.h"
@@ -29,7 +30,13 @@ std::size_t Transport::MPI::EndpointGroup::parallel_send(const ReqList<Send_t> &
 
     // pack the data
     // packs might fail - use pack_count to keep track of successful packs
-    std::vector<void *> bufs(messages.size(), nullptr);
+    // the vectors are members so that their memory is reused across calls
+    // a destination can appear more than once
+    bufs.assign(messages.size(), nullptr);
+    lens.resize(messages.size());
+    dsts.resize(messages.size());
+    srvs.resize(messages.size());
+    seqs.resize(messages.size());
     std::size_t pack_count = 0;
     for(REF(messages)::value_type const &message : messages) {
         Send_t *msg = message.second;
@@ -40,8 +47,14 @@ std::size_t Transport::MPI::EndpointGroup::parallel_send(const ReqList<Send_t> &
 
         mlog(MPI_DBG, "Attempting to pack message (type %s, size %zu, %d -> %d)", HXHIM_OP_STR[msg->op], msg->size(), msg->src, msg->dst);
 
-        if (Message::Packer::pack(msg, &bufs[pack_count], &lens[pack_count]) == TRANSPORT_SUCCESS) {
-            dsts[pack_count] = msg->dst;
+        if (!reachable(message.first)) {
+            mlog(MPI_WARN, "Rank %d cannot be reached", message.first);
+            continue;
+        }
+
+        if (Message::Packer::pack(msg, &bufs[pack_count], &lens[pack_count]) == MESSAGE_SUCCESS) {
+            dsts[pack_count] = message.first;
+            seqs[pack_count] = msg->seq;
             pack_count++;
             mlog(MPI_DBG, "Successfully packed message (type %s, size %zu, %d -> %d)", HXHIM_OP_STR[msg->op], msg->size(), msg->src, msg->dst);
         }
@@ -52,106 +65,71 @@ std::size_t Transport::MPI::EndpointGroup::parallel_send(const ReqList<Send_t> &
 
     mlog(MPI_DBG, "Successfully packed %zu messages", pack_count);
 
-    // send sizes and data in parallel
-    std::vector<MPI_Request *> size_reqs(pack_count);
-    std::vector<MPI_Request *> data_reqs(pack_count);
-    std::size_t size_count = 0;
+    // send data in parallel
+    // the receiver gets the size from the matched message, so only one message is sent
+    // unless the message is too large for the pre-posted receives
+    reqs.assign(2 * pack_count, MPI_REQUEST_NULL);
     std::size_t data_count = 0;
+    std::size_t started = 0;
 
     mlog(MPI_DBG, "Starting to send messages asynchronously");
     for(std::size_t i = 0; i < pack_count; i++) {
-        // this is not really necessary
-        std::unordered_map<int, int>::const_iterator dst_it = ranks.find(dsts[i]);
+        mlog(MPI_DBG, "Attempting to send packed message[%zu] (size %zu, %d -> %d)", i, lens[i], rank, dsts[i]);
+
+        // requests that do not fit into the pre-posted receives are announced
+        // with an empty request and then matched by the range server
+        int tag = TRANSPORT_MPI_REQUEST_TAG;
+        if (lens[i] > preposted_size) {
+            if (MPI_Isend(nullptr, 0, MPI_CHAR, dsts[i], TRANSPORT_MPI_REQUEST_TAG, comm, &reqs[started]) != MPI_SUCCESS) {
+                mlog(MPI_ERR, "Errored while announcing data of size %zu to server %d", lens[i], dsts[i]);
+                continue;
+            }
 
-        if (dst_it == ranks.end()) {
-            continue;
+            started++;
+            tag = TRANSPORT_MPI_LARGE_REQUEST_TAG;
         }
 
-        // send size
-        size_reqs[size_count] = construct<MPI_Request>();
-
-        mlog(MPI_DBG, "Attempting to send packed message[%zu] (size %zu, %d -> %d)", i, lens[i], rank, dst_it->second);
-
-        if (MPI_Isend(&lens[i], sizeof(lens[i]), MPI_CHAR, dst_it->second, TRANSPORT_MPI_SIZE_REQUEST_TAG, comm, size_reqs[size_count]) == MPI_SUCCESS) {
-            mlog(MPI_DBG, "Successfully started sending size %zu to server %d", lens[i], dst_it->second);
-
-            size_count++;
-
-            // send data
-            data_reqs[data_count] = construct<MPI_Request>();
-            if (MPI_Isend(bufs[i], lens[i], MPI_CHAR, dst_it->second, TRANSPORT_MPI_DATA_REQUEST_TAG, comm, data_reqs[data_count]) == MPI_SUCCESS) {
-                mlog(MPI_DBG, "Successfully started data of size %zu to server %d", lens[i], dst_it->second);
-                srvs[data_count] = dst_it->second;
-                data_count++;
-            }
-            else {
-                mlog(MPI_ERR, "Errored while sending data of size %zu to server %d", lens[i], dst_it->second);
-                dealloc(data_reqs[i]);
-                data_reqs[data_count] = nullptr;
-            }
+        if (MPI_Isend(bufs[i], lens[i], MPI_CHAR, dsts[i], tag, comm, &reqs[started]) == MPI_SUCCESS) {
+            mlog(MPI_DBG, "Successfully started data of size %zu to server %d", lens[i], dsts[i]);
+            srvs[data_count] = dsts[i];
+            seqs[data_count] = seqs[i];
+            data_count++;
+            started++;
         }
         else {
-            mlog(MPI_ERR, "Errored while sending size %zu to server %d", lens[i], dst_it->second);
-            dealloc(size_reqs[i]);
-            size_reqs[size_count] = nullptr;
+            mlog(MPI_ERR, "Errored while sending data of size %zu to server %d", lens[i], dsts[i]);
+            reqs[started] = MPI_REQUEST_NULL;
         }
     }
     mlog(MPI_DBG, "Done sending messages asynchronously");
 
     mlog(MPI_DBG, "Waiting for messages to complete");
 
-    //Wait for messages to complete
-    int rank;
-    MPI_Comm_rank(comm, &rank);
-    const std::size_t total_msgs = size_count + data_count;
+    // Wait for messages to complete
+    // completed requests are set to MPI_REQUEST_NULL by MPI_Testsome
+    indices.resize(started);
     std::size_t done = 0;
-    while (running && (done != total_msgs)) {
-        for(std::size_t i = 0; i < size_count; i++) {
-            if (!size_reqs[i]) {
-                continue;
-            }
-
-            int flag = 0;
-            MPI_Status status;
-            MPI_Test(size_reqs[i], &flag, &status);
-
-            if (flag) {
-                dealloc(size_reqs[i]);
-                size_reqs[i] = nullptr;
-                done++;
-            }
+    Backoff backoff;
+    while (running && (done != started)) {
+        int outcount = 0;
+        if (MPI_Testsome(started, reqs.data(), &outcount, indices.data(), MPI_STATUSES_IGNORE) != MPI_SUCCESS) {
+            mlog(MPI_ERR, "Errored while waiting for messages to complete");
+            break;
         }
 
-        for(std::size_t i = 0; i < data_count; i++) {
-            if (!data_reqs[i]) {
-                continue;
-            }
-
-            int flag = 0;
-            MPI_Status status;
-
-            MPI_Test(data_reqs[i], &flag, &status);
-
-            if (flag) {
-                dealloc(data_reqs[i]);
-                data_reqs[i] = nullptr;
-                done++;
-            }
+        if ((outcount == MPI_UNDEFINED) || (outcount == 0)) {
+            backoff.wait();
+            continue;
         }
-    }
 
-    // Free any remaining requests
-    for(std::size_t i = 0; i < size_count; i++) {
-        if (size_reqs[i]) {
-            MPI_Request_free(size_reqs[i]);
-            dealloc(size_reqs[i]);
-        }
+        done += outcount;
+        backoff.reset();
     }
 
-    for(std::size_t i = 0; i < data_count; i++) {
-        if (data_reqs[i]) {
-            MPI_Request_free(data_reqs[i]);
-            dealloc(data_reqs[i]);
+    // Free any remaining requests
+    for(std::size_t i = 0; i < started; i++) {
+        if (reqs[i] != MPI_REQUEST_NULL) {
+            MPI_Request_free(&reqs[i]);
         }
     }
 
@@ -172,7 +150,7 @@ std::size_t Transport::MPI::EndpointGroup::parallel_send(const ReqList<Send_t> &
  *
  * @param  nsrcs     the number of source range servers that are expected
  * @param  srcs      the array of source range servers
-OD * @tparam messages  A pointer to the array of messages that are received
+ * @tparam messages  A pointer to the array of messages that are received
  * @return the number of valid messages
  */
 template <typename Recv_t, typename>
@@ -189,130 +167,64 @@ std::size_t Transport::MPI::EndpointGroup::parallel_recv(const std::size_t nsrcs
 
     mlog(MPI_DBG, "Waiting to receive %zu messages", nsrcs);
 
-    std::vector<MPI_Request *> reqs(nsrcs);
+    // match the response from each server as it arrives
+    // the matched message provides the size of the buffer to allocate
+    std::vector<int> remaining(srcs, srcs + nsrcs);
 
-    // use reqs to receive size messages from the servers in the list
-    std::size_t size_req_count = 0;
-    for(std::size_t i = 0; i < nsrcs; i++) {
-        //this is not really necessary
-        std::unordered_map<int, int>::const_iterator src_it = ranks.find(srcs[i]);
-
-        if (src_it != ranks.end()) {
-            reqs[size_req_count] = construct<MPI_Request>();
-            if (MPI_Irecv(&lens[i], sizeof(lens[i]), MPI_CHAR,
-                          src_it->second, TRANSPORT_MPI_SIZE_RESPONSE_TAG, comm, reqs[size_req_count]) == MPI_SUCCESS) {
-                mlog(MPI_DBG, "Receiving size[%zu] from %d %d", i, src_it->second, srcs[i]);
-                size_req_count++;
-            }
-            else {
-                mlog(MPI_DBG, "Failed to start receiving size[%zu]", i);
-                dealloc(reqs[size_req_count]);
-                reqs[size_req_count] = nullptr;
-            }
-        }
-    }
+    mlog(MPI_DBG, "Waiting for data to be received");
 
-    // Wait for size messages to complete
-    mlog(MPI_DBG, "Waiting for size to be received");
+    std::vector<void *> recvbufs;
+    std::vector<std::size_t> recvlens;
+    Backoff backoff;
+    while (running && remaining.size()) {
+        const std::size_t before = remaining.size();
+        for(std::size_t i = 0; i < remaining.size();) {
+            int flag = 0;
+            MPI_Message message;
+            MPI_Status status;
 
-    std::size_t done = 0;
-    while (running && (done != size_req_count)) {
-        for(std::size_t i = 0; i < size_req_count; i++) {
-            // if there is a request
-            if (reqs[i]) {
-                int flag = 0;
-                MPI_Status status;
-
-                // test the request
-                MPI_Test(reqs[i], &flag, &status);
-
-                // if the request completed, add 1
-                if (flag) {
-                    // mlog(MPI_DBG, "size received: %zu", i);
-                    dealloc(reqs[i]);
-                    reqs[i] = nullptr;
-                    done++;
-                }
-                else {
-                    // mlog(MPI_DBG, "size[%zu] not completed yet %zu", i, sizeof(lens[i]));
-                }
+            if ((MPI_Improbe(remaining[i], TRANSPORT_MPI_RESPONSE_TAG, comm, &flag, &message, &status) != MPI_SUCCESS) ||
+                !flag) {
+                i++;
+                continue;
             }
-        }
-    }
 
-    // Free any remaining requests
-    for(std::size_t i = 0; i < size_req_count; i++) {
-        if (reqs[i]) {
-            MPI_Request_free(reqs[i]);
-            dealloc(reqs[i]);
-        }
-    }
+            int count = 0;
+            MPI_Get_count(&status, MPI_CHAR, &count);
 
-    mlog(MPI_DBG, "Received %zu sizes", done);
-
-    // reuse reqs to receive data messages from the servers
-    std::size_t data_req_count = 0;
-    std::vector<void *> recvbufs(size_req_count);
-    for(std::size_t i = 0; i < size_req_count; i++) {
-        std::unordered_map<int, int>::const_iterator src_it = ranks.find(srcs[i]);
-        if (src_it != ranks.end()) {
-            // Receive a message from the servers in the list
-            reqs[data_req_count] = construct<MPI_Request>();
-            recvbufs[data_req_count] = alloc(lens[i]);
-            if (MPI_Irecv(recvbufs[data_req_count], lens[i], MPI_CHAR,
-                          src_it->second, TRANSPORT_MPI_DATA_RESPONSE_TAG, comm, reqs[data_req_count]) == MPI_SUCCESS) {
-                data_req_count++;
+            void *buf = alloc(count);
+            if (MPI_Mrecv(buf, count, MPI_CHAR, &message, MPI_STATUS_IGNORE) == MPI_SUCCESS) {
+                mlog(MPI_DBG, "Received %d bytes from %d", count, remaining[i]);
+                recvbufs.push_back(buf);
+                recvlens.push_back(count);
             }
             else {
-                dealloc(reqs[data_req_count]);
-                reqs[data_req_count] = nullptr;
-                dealloc(recvbufs[data_req_count]);
+                mlog(MPI_ERR, "Failed to receive %d bytes from %d", count, remaining[i]);
+                dealloc(buf);
             }
-        }
-    }
-
-    mlog(MPI_DBG, "Completed receiving %zu sizes", done);
-
-    // Wait for messages to complete
-    mlog(MPI_DBG, "Waiting for data to be received");
-
-    done = 0;
-    while (running && (done != data_req_count)) {
-        for(std::size_t i = 0; i < data_req_count; i++) {
-            if (!reqs[i]) {
-                continue;
-            }
-
-            int flag = 0;
-            MPI_Status status;
 
-            MPI_Test(reqs[i], &flag, &status);
-
-            if (!flag) {
-                continue;
-            }
+            remaining[i] = remaining.back();
+            remaining.pop_back();
+        }
 
-            dealloc(reqs[i]);
-            reqs[i] = nullptr;
-            done++;
+        // sleep a little longer each time nothing arrives
+        if (remaining.size() == before) {
+            backoff.wait();
+        }
+        else {
+            backoff.reset();
         }
     }
 
     mlog(MPI_DBG, "Data received");
 
-    // Free any remaining requests
-    for(std::size_t i = 0; i < data_req_count; i++) {
-        if (reqs[i]) {
-            MPI_Request_free(reqs[i]);
-            dealloc(reqs[i]);
-        }
-    }
+    const std::size_t data_req_count = recvbufs.size();
 
     // unpack the data
     std::size_t valid = 0;
     *messages = alloc_array<Recv_t *>(data_req_count);
     for(std::size_t i = 0; i < data_req_count; i++) {
-        if (Message::Unpacker::unpack(&((*messages)[valid]), recvbufs[i], lens[i]) == TRANSPORT_SUCCESS) {
+        if (Message::Unpacker::unpack(&((*messages)[valid]), recvbufs[i], recvlens[i]) == MESSAGE_SUCCESS) {
             valid++;
         }
 
@@ -344,11 +256,28 @@ Recv_t *Transport::MPI::EndpointGroup::return_msgs(const ReqList<Send_t> &messag
         mlog(MPI_DBG, "    Server %d", srvs[i]);
     }
 
-    mlog(MPI_DBG, "Waiting for %zu responses", sent);
+    return collect<Recv_t>(sent);
+}
+
+/**
+ * collect
+ * Waits for the responses to the first count requests
+ * recorded in srvs and seqs. The responses are chained
+ * together into a list.
+ *
+ * @param count  the number of requests that are waiting for responses
+ * @treturn a linked list of return messages
+ */
+template<typename Recv_t, typename>
+Recv_t *Transport::MPI::EndpointGroup::collect(const std::size_t count) {
+    mlog(MPI_DBG, "Waiting for %zu responses", count);
+
+    // responses can arrive in any order
+    std::unordered_set<std::size_t> outstanding(seqs.begin(), seqs.begin() + count);
 
     // wait for responses
     Recv_t **recv_list = nullptr;
-    const std::size_t recvd = parallel_recv(sent, srvs, &recv_list);
+    const std::size_t recvd = parallel_recv(count, srvs.data(), &recv_list);
     mlog(MPI_DBG, "Received from %zu servers", recvd);
 
     // convert the responses into a list
@@ -356,6 +285,12 @@ Recv_t *Transport::MPI::EndpointGroup::return_msgs(const ReqList<Send_t> &messag
     Recv_t *tail = nullptr;
     for (std::size_t i = 0; i < recvd; i++) {
         Recv_t *brm = dynamic_cast<Recv_t *>(recv_list[i]);
+        if (brm && !outstanding.erase(brm->seq)) {
+            mlog(MPI_WARN, "Dropping response %zu from %d that does not match a request", brm->seq, brm->src);
+            destruct(brm);
+            continue;
+        }
+
         if (brm) {
             mlog(MPI_DBG, "    Server %d", brm->src);
             //Build the linked list to return
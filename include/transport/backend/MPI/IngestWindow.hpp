@@ -0,0 +1,161 @@
+#ifndef TRANSPORT_MPI_INGEST_WINDOW_HPP
+#define TRANSPORT_MPI_INGEST_WINDOW_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <mpi.h>
+
+#include "transport/constants.hpp"
+
+namespace Transport {
+namespace MPI {
+
+/**
+ * IngestWindow
+ * A log of packed requests that clients append to with
+ * one-sided MPI operations, so that range servers do not
+ * have to match and receive every PUT.
+ *
+ * Each range server exposes a ring of bytes. A client
+ * waits until the ring has room for a record, reserves
+ * the space by moving the tail counter of the target
+ * while holding its reservation lock, writes the record
+ * with MPI_Put, and then publishes it
+ * by writing the sequence number into the record header.
+ * The range server drains published records in order and
+ * advances the head counter, which clients read to find
+ * out when space has been freed.
+ *
+ * Space is only reserved once it is free, so a client
+ * never has to wait between reserving and publishing,
+ * and every reservation is published. Otherwise, a
+ * client that gave up while waiting (e.g. on shutdown)
+ * would leave a hole that stops the range server from
+ * draining the records behind it.
+ *
+ * The window is allocated and freed collectively.
+ */
+class IngestWindow {
+    public:
+        /** @description Collective; ranks that are not range servers expose 0 bytes */
+        IngestWindow(const MPI_Comm comm, const std::size_t capacity, const bool expose);
+
+        /** @description Collective */
+        ~IngestWindow();
+
+        /** @description Whether or not the window was allocated successfully */
+        bool Valid() const;
+
+        /** @description Largest packed message that can be appended */
+        std::size_t MaxMessage() const;
+
+        /** @description Client side: copy a message into the log of a range server */
+        int append(const int rank, const void *data, const std::size_t len,
+                   volatile std::atomic_bool &running);
+
+        /**
+         * drain
+         * Range server side: pass every published record to handle
+         * Only one thread may drain a window at a time.
+         *
+         * @tparam Handle  void(void *data, const std::size_t len)
+         * @param handle   the function to call for each record; data is only valid during the call
+         * @return the number of records handled
+         */
+        template <typename Handle>
+        std::size_t drain(Handle handle);
+
+    private:
+        /** @description Placed before every record */
+        struct Record {
+            std::uint64_t len;   // length of the packed message
+            std::uint64_t seq;   // offset of the record + 1, written last
+        };
+
+        // byte displacements within the window
+        static const MPI_Aint TAIL;
+        static const MPI_Aint HEAD;
+        static const MPI_Aint LOCK;
+        static const MPI_Aint DATA;
+
+        static std::size_t record_size(const std::size_t len);
+
+        /** @description Reserve need bytes in the ring of a range server once they are free */
+        int reserve(const int rank, const std::uint64_t need, std::uint64_t &offset,
+                    volatile std::atomic_bool &running);
+
+        /** @description Write len bytes starting at pos, wrapping around the end of the ring */
+        void put(const int rank, const std::size_t pos, const void *data, const std::size_t len);
+
+        /** @description Get the sequence number of the record at pos in the local ring */
+        std::uint64_t published(const std::size_t pos);
+
+        MPI_Comm comm;
+        int rank;
+        MPI_Win win;
+        char *base;
+        std::size_t capacity;
+
+        // range server: bytes drained so far
+        std::uint64_t consumed;
+
+        // range server: records that wrap around the end of the ring are copied here
+        std::vector<char> wrapped;
+};
+
+template <typename Handle>
+std::size_t IngestWindow::drain(Handle handle) {
+    if (!Valid() || !capacity) {
+        return 0;
+    }
+
+    std::size_t count = 0;
+    while (true) {
+        const std::size_t pos = consumed % capacity;
+        if (published(pos) != consumed + 1) {
+            break;
+        }
+
+        MPI_Win_sync(win);
+
+        char *ring = base + DATA;
+        const std::size_t len = ((Record *) (ring + pos))->len;
+        const std::size_t start = (pos + sizeof(Record)) % capacity;
+        const std::size_t need = record_size(len);
+
+        if (start + len <= capacity) {
+            handle((void *) (ring + start), len);
+        }
+        else {
+            const std::size_t first = capacity - start;
+            wrapped.resize(len);
+            memcpy(wrapped.data(), ring + start, first);
+            memcpy(wrapped.data() + first, ring, len - first);
+            handle((void *) wrapped.data(), len);
+        }
+
+        // clear the record so that stale bytes are never mistaken for a header
+        const std::size_t first = std::min(need, capacity - pos);
+        memset(ring + pos, 0, first);
+        memset(ring, 0, need - first);
+        MPI_Win_sync(win);
+
+        consumed += need;
+        MPI_Accumulate(&consumed, 1, MPI_UINT64_T, rank, HEAD, 1, MPI_UINT64_T, MPI_REPLACE, win);
+        MPI_Win_flush(rank, win);
+
+        count++;
+    }
+
+    return count;
+}
+
+}
+}
+
+#endif
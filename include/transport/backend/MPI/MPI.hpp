@@ -6,6 +6,7 @@
 #define TRANSPORT_MPI_HPP
 
 #include "transport/backend/MPI/EndpointGroup.hpp"
+#include "transport/backend/MPI/IngestWindow.hpp"
 #include "transport/backend/MPI/Init.hpp"
 #include "transport/backend/MPI/Instance.hpp"
 #include "transport/backend/MPI/Options.hpp"
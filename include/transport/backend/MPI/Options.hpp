@@ -13,14 +13,17 @@ namespace MPI {
 
 struct Options : ::Transport::Options {
     Options(MPI_Comm comm,
-            const std::size_t listeners)
+            const std::size_t listeners,
+            const std::size_t ingest_window = 0)
         : ::Transport::Options(TRANSPORT_MPI),
         comm(comm),
-        listeners(listeners)
+        listeners(listeners),
+        ingest_window(ingest_window)
     {}
 
     const MPI_Comm comm;
     const std::size_t listeners;
+    const std::size_t ingest_window; // bytes; 0 sends PUTs like every other request
 };
 
 }
@@ -1,6 +1,12 @@
 #ifndef TRANSPORT_MPI_RANGE_SERVER_HPP
 #define TRANSPORT_MPI_RANGE_SERVER_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -8,30 +14,133 @@
 
 #include "hxhim/struct.h"
 #include "hxhim/options.h"
+#include "transport/Scheduler.hpp"
+#include "transport/backend/MPI/IngestWindow.hpp"
 #include "transport/transport.hpp"
 
 namespace Transport {
 namespace MPI {
 
+/**
+ * RangeServer
+ * The MPI range server is split into stages connected by queues:
+ *     1. a receiver thread that matches and receives requests
+ *     2. a pool of worker threads that unpack, process, and pack
+ *        requests in the order chosen by a Scheduler. Each
+ *        datastore is handled by one worker at a time.
+ *     3. a sender thread that completes responses asynchronously
+ * A slow datastore operation only occupies one worker,
+ * so requests continue to be received while it runs.
+ *
+ * The receiver keeps a pool of persistent receives
+ * (MPI_Recv_init) into one registered slab sized from the
+ * maximum request size. Workers unpack requests directly
+ * out of the slab and hand the slots back, so receiving a
+ * request does not allocate. Requests that are larger than
+ * a slot are sent with a different tag and received with
+ * a matched probe once the empty request announcing them
+ * arrives. MPI fills the slots in the order that they were
+ * started and slots are only taken in that order, so the
+ * requests of each client are queued in the order they
+ * were sent.
+ *
+ * The receiver stops matching requests while the requests
+ * that have been received but not processed exceed the
+ * credit budget of the range server, leaving the rest of
+ * the requests with their clients.
+ *
+ * If an ingest window is provided, another thread drains
+ * the PUTs that clients append to it with one-sided MPI.
+ * Their responses are sent like the responses of received
+ * requests, so clients see the status of every PUT.
+ */
 class RangeServer : virtual public ::Transport::RangeServer {
     public:
-        RangeServer(hxhim_t *hx, const std::size_t listener_count);
+        RangeServer(hxhim_t *hx, const std::size_t worker_count,
+                    const std::shared_ptr<IngestWindow> &ingest = nullptr);
         ~RangeServer();
 
+        /** @description Number of pre-posted receives per worker */
+        static const std::size_t SLOTS_PER_WORKER;
+
     private:
-        /**
-         * Function that will be used to listen for MPI messages
-         */
-        void listener_thread();
+        /** @description A packed request or response */
+        struct Packet {
+            Packet(void *data = nullptr, const std::size_t len = 0, const int rank = -1, const int slot = -1);
+
+            void *data;
+            std::size_t len;
+            int rank;          // source of a request or destination of a response
+            int slot;          // pool slot holding the data, or -1 if data was allocated
+        };
+
+        /** @description Pre-posted persistent receives */
+        struct Pool {
+            char *slab;                      // slot_size * reqs.size() bytes from MPI_Alloc_mem
+            std::size_t slot_size;
+            std::vector<MPI_Request> reqs;
+            std::deque<int> posted;          // started slots, in the order that they match messages
+            std::vector<int> released;       // slots to restart, filled by the workers
+            std::mutex mutex;                // protects released
+        };
+
+        /** @description Packets passed between stages */
+        struct Stage {
+            std::list<Packet> queue;
+            std::mutex mutex;
+            std::condition_variable ready;
+        };
+
+        /** @description Requests waiting for a worker */
+        struct Scheduled {
+            Scheduled(const std::size_t datastores, const SchedulePolicies &policies);
+
+            Scheduler<Packet> queue;
+            std::mutex mutex;
+            std::condition_variable ready;
+        };
+
+        void receiver_thread();
+        void worker_thread();
+        void sender_thread();
+        void ingest_thread();
+
+        /** @description Run a request against the datastores and queue its response */
+        void process(const Packet &req);
+
+        /** @description Queue a response for the sender */
+        void reply(Message::Response::Response *response);
 
-        int recv(void **data, std::size_t *len);
-        int send(const int dst, void *data, const std::size_t len);
+        /** @description Process every PUT currently in the ingest window */
+        std::size_t drain_ingest();
 
-        int Flush(MPI_Request &req);
-        int Flush(MPI_Request &req, MPI_Status &status);
+        int recv(Packet &packet);
+
+        /** @description Receive the large request announced by an empty request from source */
+        int recv_large(const int source, Packet &packet);
+
+        /** @description Restart the receives of slots that the workers are done with */
+        void restart_slots();
+
+        /** @description Free a request packet or return its slot to the pool */
+        void release(const Packet &packet);
 
         hxhim_t *hx;
-        std::vector<std::thread> listeners;
+
+        std::thread receiver;
+        std::vector<std::thread> workers;
+        std::thread sender;
+
+        std::shared_ptr<IngestWindow> ingest;
+        std::thread ingester;
+
+        Scheduled requests;
+        Stage responses;
+
+        /** @description Bytes of requests that have been received but not processed */
+        std::atomic<std::size_t> admitted;
+
+        Pool pool;
 };
 
 }
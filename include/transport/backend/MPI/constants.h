@@ -1,9 +1,12 @@
 #ifndef TRANSPORT_MPI_TAGS_H
 #define TRANSPORT_MPI_TAGS_H
 
-#define TRANSPORT_MPI_SIZE_REQUEST_TAG  0
-#define TRANSPORT_MPI_DATA_REQUEST_TAG  1
-#define TRANSPORT_MPI_SIZE_RESPONSE_TAG 2
-#define TRANSPORT_MPI_DATA_RESPONSE_TAG 3
+#define TRANSPORT_MPI_REQUEST_TAG  0
+#define TRANSPORT_MPI_RESPONSE_TAG 1
+
+/* requests that do not fit into the pre-posted receive buffers of the range server */
+/* each one is announced by an empty message with TRANSPORT_MPI_REQUEST_TAG so that */
+/* the range server receives it in the same order as the rest of the requests */
+#define TRANSPORT_MPI_LARGE_REQUEST_TAG 2
 
 #endif
@@ -0,0 +1,82 @@
+#ifndef TRANSPORT_SHM_ENDPOINT_GROUP_HPP
+#define TRANSPORT_SHM_ENDPOINT_GROUP_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "transport/backend/MPI/EndpointGroup.hpp"
+#include "transport/backend/SHM/Ring.hpp"
+#include "transport/transport.hpp"
+#include "utils/type_traits.hpp"
+
+namespace Transport {
+namespace SHM {
+
+/**
+ * EndpointGroup
+ * Sends requests to range servers on the same node by
+ * copying them into the request rings of the range servers.
+ * The range servers copy their responses into the response
+ * ring of this rank. Requests to range servers on other
+ * nodes are sent with the MPI endpoint group.
+ */
+class EndpointGroup : virtual public ::Transport::EndpointGroup {
+    public:
+        EndpointGroup(const int rank,
+                      const std::shared_ptr<Ring> &responses,
+                      const std::unordered_map<int, std::shared_ptr<Ring> > &servers,
+                      MPI::EndpointGroup *remote,
+                      volatile std::atomic_bool &running);
+
+        ~EndpointGroup();
+
+        /** @description Bulk Put to multiple endpoints    */
+        Message::Response::BPut *communicate(const ReqList<Message::Request::BPut> &bpm_list);
+
+        /** @description Bulk Get from multiple endpoints  */
+        Message::Response::BGet *communicate(const ReqList<Message::Request::BGet> &bgm_list);
+
+        /** @description Bulk Get from multiple endpoints  */
+        Message::Response::BGetOp *communicate(const ReqList<Message::Request::BGetOp> &bgm_list);
+
+        /** @description Bulk Delete to multiple endpoints */
+        Message::Response::BDelete *communicate(const ReqList<Message::Request::BDelete> &bdm_list);
+
+        /** @description Bulk Histogram to multiple endpoints */
+        Message::Response::BHistogram *communicate(const ReqList<Message::Request::BHistogram> &bhm_list);
+
+    private:
+        /** @description Unpack every response currently in the response ring */
+        template <typename Recv_t, typename = enable_if_t<std::is_base_of<Message::Response::Response, Recv_t>::value> >
+        std::size_t collect(Recv_t **head, Recv_t **tail);
+
+        template <typename Recv_t, typename Send_t,
+                  typename = enable_if_t<std::is_base_of<Message::Request::Request,   Send_t>::value &&
+                                         std::is_base_of<Message::Response::Response, Recv_t>::value> >
+        Recv_t *return_msgs(const ReqList<Send_t> &messages);
+
+        const int rank;
+
+        /** @description Where range servers on this node place responses to this rank */
+        std::shared_ptr<Ring> responses;
+
+        /** @description Request rings of range servers on this node, by rank */
+        std::unordered_map<int, std::shared_ptr<Ring> > servers;
+
+        /** @description Range servers on other nodes (may be nullptr) */
+        MPI::EndpointGroup *remote;
+
+        volatile std::atomic_bool &running;
+
+        /** @description The response ring only has one consumer */
+        std::mutex mutex;
+};
+
+}
+}
+
+#include "EndpointGroup.tpp"
+
+#endif
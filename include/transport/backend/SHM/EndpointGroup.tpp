@@ -0,0 +1,156 @@
+#include <list>
+#include <unordered_set>
+
+#include "hxhim/constants.h"
+#include "utils/Backoff.hpp"
+#include "utils/macros.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+/**
+ * collect
+ * Unpacks responses directly out of the response
+ * ring and appends them to the list.
+ *
+ * @param head  the front of the list of responses
+ * @param tail  the back of the list of responses
+ * @return the number of messages removed from the ring
+ */
+template <typename Recv_t, typename>
+std::size_t Transport::SHM::EndpointGroup::collect(Recv_t **head, Recv_t **tail) {
+    return responses->drain([head, tail](const int src, void *data, const std::size_t len) {
+            Recv_t *response = nullptr;
+            if (Message::Unpacker::unpack(&response, data, len) != MESSAGE_SUCCESS) {
+                mlog(SHM_ERR, "Failed to unpack %zu byte response from %d", len, src);
+                return;
+            }
+
+            if (*tail) {
+                (*tail)->next = response;
+            }
+            else {
+                *head = response;
+            }
+            *tail = response;
+        });
+}
+
+/**
+ * return_msgs
+ * Sends Transport::B* messages and waits for their responses.
+ *     1. Messages to range servers on this node are pushed
+ *        into the request rings of those range servers.
+ *     2. Messages to other nodes are sent with MPI.
+ *     3. Responses from this node are unpacked from the response ring.
+ * The responses are chained together into a list.
+ *
+ * @param messages  the messages to send, keyed by destination rank
+ * @return a linked list of response messages
+ */
+template<typename Recv_t, typename Send_t, typename>
+Recv_t *Transport::SHM::EndpointGroup::return_msgs(const ReqList<Send_t> &messages) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Recv_t *head = nullptr;
+    Recv_t *tail = nullptr;
+
+    ReqList<Send_t> others;
+    std::unordered_set<std::size_t> outstanding;
+    std::size_t sent = 0;
+    std::size_t recvd = 0;
+
+    for(REF(messages)::value_type const &message : messages) {
+        Send_t *msg = message.second;
+        if (!msg) {
+            continue;
+        }
+
+        std::unordered_map<int, std::shared_ptr<Ring> >::const_iterator it = servers.find(message.first);
+        if (it == servers.end()) {
+            others.emplace(message.first, msg);
+            continue;
+        }
+
+        void *buf = nullptr;
+        std::size_t len = 0;
+        if (Message::Packer::pack(msg, &buf, &len) != MESSAGE_SUCCESS) {
+            mlog(SHM_ERR, "Failed to pack message (type %s, %d -> %d)", HXHIM_OP_STR[msg->op], msg->src, message.first);
+            continue;
+        }
+
+        // pull responses out of the way while the range server is busy
+        const int rc = it->second->write(rank, buf, len, running,
+                                         [this, &head, &tail, &recvd]() -> bool {
+                                             const std::size_t count = collect(&head, &tail);
+                                             recvd += count;
+                                             return count;
+                                         });
+        dealloc(buf);
+
+        if (rc == TRANSPORT_SUCCESS) {
+            outstanding.insert(msg->seq);
+            sent++;
+        }
+        else {
+            mlog(SHM_ERR, "Failed to push message (type %s, %d -> %d)", HXHIM_OP_STR[msg->op], msg->src, message.first);
+        }
+    }
+
+    mlog(SHM_DBG, "Pushed %zu messages to range servers on this node", sent);
+
+    // the range servers on this node work while MPI communicates
+    Recv_t *others_head = nullptr;
+    if (remote && others.size()) {
+        others_head = remote->communicate(others);
+    }
+
+    // wait for the responses from this node
+    Backoff backoff;
+    while (running && (recvd < sent)) {
+        const std::size_t count = collect(&head, &tail);
+        recvd += count;
+        if (count) {
+            backoff.reset();
+        }
+        else {
+            backoff.wait();
+        }
+    }
+
+    mlog(SHM_DBG, "Received %zu responses from range servers on this node", recvd);
+
+    // responses can arrive in any order
+    Recv_t *response = head;
+    head = nullptr;
+    tail = nullptr;
+    while (response) {
+        Recv_t *following = static_cast<Recv_t *>(response->next);
+        response->next = nullptr;
+
+        if (outstanding.erase(response->seq)) {
+            if (tail) {
+                tail->next = response;
+            }
+            else {
+                head = response;
+            }
+            tail = response;
+        }
+        else {
+            mlog(SHM_WARN, "Dropping response %zu from %d that does not match a request", response->seq, response->src);
+            destruct(response);
+        }
+
+        response = following;
+    }
+
+    if (tail) {
+        tail->next = others_head;
+    }
+    else {
+        head = others_head;
+    }
+
+    return head;
+}
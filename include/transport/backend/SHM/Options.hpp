@@ -0,0 +1,27 @@
+#ifndef TRANSPORT_SHM_OPTIONS_HPP
+#define TRANSPORT_SHM_OPTIONS_HPP
+
+#include <cstddef>
+
+#include "transport/constants.hpp"
+#include "transport/Options.hpp"
+
+namespace Transport {
+namespace SHM {
+
+struct Options : ::Transport::Options {
+    Options(const std::size_t ring_size,
+            const std::size_t listeners)
+        : ::Transport::Options(TRANSPORT_SHM),
+        ring_size(ring_size),
+        listeners(listeners)
+    {}
+
+    const std::size_t ring_size;  // bytes in each shared memory ring
+    const std::size_t listeners;  // MPI range server workers for ranks on other nodes
+};
+
+}
+}
+
+#endif
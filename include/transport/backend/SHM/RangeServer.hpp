@@ -0,0 +1,62 @@
+#ifndef TRANSPORT_SHM_RANGE_SERVER_HPP
+#define TRANSPORT_SHM_RANGE_SERVER_HPP
+
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include "hxhim/struct.h"
+#include "transport/Scheduler.hpp"
+#include "transport/backend/MPI/RangeServer.hpp"
+#include "transport/backend/SHM/Ring.hpp"
+#include "transport/transport.hpp"
+
+namespace Transport {
+namespace SHM {
+
+/**
+ * RangeServer
+ * A single thread drains the request ring of this rank,
+ * unpacks the requests into a Scheduler, processes them
+ * in the order chosen by the Scheduler, and pushes the
+ * packed responses into the response ring of the ranks
+ * that sent the requests. The ring is drained again
+ * before every request is processed, so newly arrived
+ * reads can go ahead of writes that are already queued.
+ * Requests from other nodes are handled by the MPI range
+ * server.
+ */
+class RangeServer : virtual public ::Transport::RangeServer {
+    public:
+        RangeServer(hxhim_t *hx,
+                    const std::shared_ptr<Ring> &requests,
+                    const std::unordered_map<int, std::shared_ptr<Ring> > &clients,
+                    MPI::RangeServer *remote);
+        ~RangeServer();
+
+    private:
+        void handler_thread();
+        void schedule(const int src, void *data, const std::size_t len);
+        void handle(Message::Request::Request *request);
+
+        hxhim_t *hx;
+
+        /** @description Where ranks on this node place requests to this range server */
+        std::shared_ptr<Ring> requests;
+
+        /** @description Response rings of ranks on this node, by rank */
+        std::unordered_map<int, std::shared_ptr<Ring> > clients;
+
+        /** @description Range server for requests from other nodes (may be nullptr) */
+        MPI::RangeServer *remote;
+
+        /** @description Unpacked requests waiting to be processed; only used by the handler */
+        Scheduler<Message::Request::Request *> scheduled;
+
+        std::thread handler;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef TRANSPORT_SHM_RING_HPP
+#define TRANSPORT_SHM_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <pthread.h>
+
+#include "transport/constants.hpp"
+#include "utils/Backoff.hpp"
+
+namespace Transport {
+namespace SHM {
+
+/**
+ * Ring
+ * A multiple producer, single consumer ring buffer
+ * of messages placed in a POSIX shared memory segment.
+ *
+ * Producers on any rank of the node copy messages
+ * directly into the segment. Messages that are larger
+ * than half of the ring are split into fragments, which
+ * the consumer reassembles. Messages that arrive in one
+ * fragment are handed to the consumer without copying
+ * them out of the segment.
+ *
+ * The segment is only unlinked by the rank that created it.
+ */
+class Ring {
+    public:
+        /** @description Create and initialize a new shared memory segment */
+        static Ring *create(const std::string &name, const std::size_t capacity);
+
+        /** @description Map a segment created by another rank */
+        static Ring *open(const std::string &name);
+
+        ~Ring();
+
+        /** @description Remove the name of the segment; existing mappings remain valid */
+        int unlink();
+
+        const std::string &Name() const;
+        std::size_t Capacity() const;
+
+        /** @description Largest amount of data that can be pushed in one call */
+        std::size_t MaxFragment() const;
+
+        /** @description Try to copy one fragment into the ring */
+        int push(const int src, const void *data, const std::size_t len, const bool more);
+
+        /**
+         * write
+         * Push an entire message, splitting it into fragments.
+         * While the ring is full, idle is called so that the caller
+         * can make progress elsewhere (e.g. drain its own ring).
+         *
+         * @tparam Idle    bool(); returns whether or not any progress was made
+         * @param src      the rank pushing the message
+         * @param data     the message
+         * @param len      the length of the message
+         * @param running  stop waiting when this becomes false
+         * @param idle     the function to call while the ring is full
+         * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR
+         */
+        template <typename Idle>
+        int write(const int src, const void *data, const std::size_t len,
+                  volatile std::atomic_bool &running, Idle idle);
+
+        /**
+         * drain
+         * Pass every complete message in the ring to handle.
+         * Only one thread may drain a ring at a time.
+         *
+         * @tparam Handle  void(const int src, void *data, const std::size_t len)
+         * @param handle   the function to call for each message; data is only valid during the call
+         * @return the number of messages handled
+         */
+        template <typename Handle>
+        std::size_t drain(Handle handle);
+
+    private:
+        /** @description Control block at the front of the segment */
+        struct Header {
+            pthread_mutex_t mutex;   // process shared
+            std::size_t capacity;    // bytes of data after the header
+            std::size_t head;        // total bytes consumed
+            std::size_t tail;        // total bytes produced
+        };
+
+        /** @description Placed before every fragment */
+        struct Record {
+            std::uint64_t len;       // length of the fragment, or WRAP
+            std::int32_t  src;       // rank that pushed the fragment
+            std::uint32_t more;      // whether or not more fragments follow
+        };
+
+        static const std::uint64_t WRAP;
+
+        Ring(const std::string &name, void *mapping, const std::size_t mapping_size, const bool owner);
+
+        static std::size_t header_size();
+        static std::size_t record_size(const std::size_t len);
+
+        /** @description Get the next fragment without removing it */
+        bool peek(Record **record);
+
+        /** @description Remove the fragment returned by peek */
+        void pop();
+
+        std::string name;
+        void *mapping;
+        std::size_t mapping_size;
+        bool owner;
+
+        Header *header;
+        char *data;
+
+        // fragments of messages that have not been completely received, by source rank
+        std::unordered_map<int, std::vector<char> > partial;
+};
+
+template <typename Idle>
+int Ring::write(const int src, const void *data, const std::size_t len,
+                volatile std::atomic_bool &running, Idle idle) {
+    const char *curr = (const char *) data;
+    std::size_t remaining = len;
+    Backoff backoff;
+
+    do {
+        const std::size_t fragment = std::min(remaining, MaxFragment());
+        const bool more = (remaining > fragment);
+
+        while (push(src, curr, fragment, more) != TRANSPORT_SUCCESS) {
+            if (!running) {
+                return TRANSPORT_ERROR;
+            }
+
+            if (idle()) {
+                backoff.reset();
+            }
+            else {
+                backoff.wait();
+            }
+        }
+
+        curr += fragment;
+        remaining -= fragment;
+    } while (remaining);
+
+    return TRANSPORT_SUCCESS;
+}
+
+template <typename Handle>
+std::size_t Ring::drain(Handle handle) {
+    std::size_t count = 0;
+
+    Record *record = nullptr;
+    while (peek(&record)) {
+        char *fragment = reinterpret_cast<char *>(record) + sizeof(Record);
+        const int src = record->src;
+
+        std::unordered_map<int, std::vector<char> >::iterator it = partial.find(src);
+        if ((it == partial.end()) && !record->more) {
+            // whole message in one fragment - use it in place
+            handle(src, (void *) fragment, (std::size_t) record->len);
+            count++;
+        }
+        else {
+            std::vector<char> &buf = partial[src];
+            buf.insert(buf.end(), fragment, fragment + record->len);
+
+            if (!record->more) {
+                handle(src, (void *) buf.data(), buf.size());
+                partial.erase(src);
+                count++;
+            }
+        }
+
+        pop();
+    }
+
+    return count;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef TRANSPORT_SHM_HPP
+#define TRANSPORT_SHM_HPP
+
+#include "transport/backend/SHM/EndpointGroup.hpp"
+#include "transport/backend/SHM/Init.hpp"
+#include "transport/backend/SHM/Options.hpp"
+#include "transport/backend/SHM/RangeServer.hpp"
+#include "transport/backend/SHM/Ring.hpp"
+
+#endif
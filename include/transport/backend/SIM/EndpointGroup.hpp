@@ -0,0 +1,61 @@
+#ifndef TRANSPORT_SIM_ENDPOINT_GROUP_HPP
+#define TRANSPORT_SIM_ENDPOINT_GROUP_HPP
+
+#include <memory>
+
+#include "transport/backend/SIM/Network.hpp"
+#include "transport/backend/SIM/RangeServer.hpp"
+#include "transport/transport.hpp"
+#include "utils/type_traits.hpp"
+
+namespace Transport {
+namespace SIM {
+
+/**
+ * EndpointGroup
+ * Packs requests and hands them to the simulated range
+ * servers with the time that the network model says they
+ * arrive. Responses are only returned once the network
+ * model says that the last one has arrived, so calls take
+ * as long as they would over the simulated network.
+ */
+class EndpointGroup : virtual public ::Transport::EndpointGroup {
+    public:
+        EndpointGroup(const int rank,
+                      const std::shared_ptr<Network> &network,
+                      RangeServer &servers);
+
+        ~EndpointGroup();
+
+        /** @description Bulk Put to multiple endpoints    */
+        Message::Response::BPut *communicate(const ReqList<Message::Request::BPut> &bpm_list);
+
+        /** @description Bulk Get from multiple endpoints  */
+        Message::Response::BGet *communicate(const ReqList<Message::Request::BGet> &bgm_list);
+
+        /** @description Bulk Get from multiple endpoints  */
+        Message::Response::BGetOp *communicate(const ReqList<Message::Request::BGetOp> &bgm_list);
+
+        /** @description Bulk Delete to multiple endpoints */
+        Message::Response::BDelete *communicate(const ReqList<Message::Request::BDelete> &bdm_list);
+
+        /** @description Bulk Histogram to multiple endpoints */
+        Message::Response::BHistogram *communicate(const ReqList<Message::Request::BHistogram> &bhm_list);
+
+    private:
+        template <typename Recv_t, typename Send_t,
+                  typename = enable_if_t<std::is_base_of<Message::Request::Request,   Send_t>::value &&
+                                         std::is_base_of<Message::Response::Response, Recv_t>::value> >
+        Recv_t *return_msgs(const ReqList<Send_t> &messages);
+
+        const int rank;
+        std::shared_ptr<Network> network;
+        RangeServer &servers;
+};
+
+}
+}
+
+#include "EndpointGroup.tpp"
+
+#endif
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <list>
+#include <thread>
+#include <unordered_set>
+
+#include "hxhim/constants.h"
+#include "utils/macros.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+/**
+ * return_msgs
+ * Sends Transport::B* messages and waits for their responses.
+ *     1. Messages are packed and given to the simulated
+ *        range servers with their arrival times.
+ *     2. Once every range server has replied, this thread
+ *        sleeps until the last response has arrived.
+ *     3. Responses are unpacked and chained together into a list.
+ *
+ * @param messages  the messages to send, keyed by destination rank
+ * @return a linked list of response messages
+ */
+template<typename Recv_t, typename Send_t, typename>
+Recv_t *Transport::SIM::EndpointGroup::return_msgs(const ReqList<Send_t> &messages) {
+    Inbox inbox;
+    std::unordered_set<std::size_t> outstanding;
+    std::size_t sent = 0;
+
+    for(REF(messages)::value_type const &message : messages) {
+        Send_t *msg = message.second;
+        if (!msg) {
+            continue;
+        }
+
+        if (!servers.Has(message.first)) {
+            mlog(SIM_ERR, "Rank %d does not have a simulated range server", message.first);
+            continue;
+        }
+
+        void *buf = nullptr;
+        std::size_t len = 0;
+        if (Message::Packer::pack(msg, &buf, &len) != MESSAGE_SUCCESS) {
+            mlog(SIM_ERR, "Failed to pack message (type %s, %d -> %d)", HXHIM_OP_STR[msg->op], msg->src, message.first);
+            dealloc(buf);
+            continue;
+        }
+
+        servers.deliver(message.first,
+                        network->send(rank, message.first, len, 2 * msg->seq),
+                        buf, len, &inbox);
+        outstanding.insert(msg->seq);
+        sent++;
+    }
+
+    mlog(SIM_DBG, "Sent %zu messages to simulated range servers", sent);
+
+    // every delivered request gets a reply, so the inbox
+    // cannot be destroyed while the range servers use it
+    std::list<Inbox::Response> responses;
+    {
+        std::unique_lock<std::mutex> lock(inbox.mutex);
+        inbox.cv.wait(lock,
+                      [&inbox, sent]() -> bool {
+                          return inbox.responses.size() == sent;
+                      });
+        responses = std::move(inbox.responses);
+    }
+
+    Network::Clock::time_point last = Network::Clock::now();
+    for(Inbox::Response const &response : responses) {
+        last = std::max(last, response.arrival);
+    }
+    std::this_thread::sleep_until(last);
+
+    Recv_t *head = nullptr;
+    Recv_t *tail = nullptr;
+    for(Inbox::Response &packed : responses) {
+        if (!packed.data) {
+            continue;
+        }
+
+        Recv_t *response = nullptr;
+        const int rc = Message::Unpacker::unpack(&response, packed.data, packed.len);
+        dealloc(packed.data);
+
+        if (rc != MESSAGE_SUCCESS) {
+            mlog(SIM_ERR, "Failed to unpack %zu byte response", packed.len);
+            continue;
+        }
+
+        if (!outstanding.erase(response->seq)) {
+            mlog(SIM_WARN, "Dropping response %zu from %d that does not match a request", response->seq, response->src);
+            destruct(response);
+            continue;
+        }
+
+        if (tail) {
+            tail->next = response;
+        }
+        else {
+            head = response;
+        }
+        tail = response;
+    }
+
+    return head;
+}
@@ -0,0 +1,22 @@
+#ifndef TRANSPORT_SIM_INIT_HPP
+#define TRANSPORT_SIM_INIT_HPP
+
+#include <set>
+
+#include "hxhim/struct.h"
+#include "transport/backend/SIM/Options.hpp"
+#include "transport/transport.hpp"
+
+namespace Transport {
+namespace SIM {
+
+Transport *init(hxhim_t *hx,
+                const std::size_t client_ratio,
+                const std::size_t server_ratio,
+                const std::set<int> &endpointgroup,
+                Options *opts);
+
+}
+}
+
+#endif
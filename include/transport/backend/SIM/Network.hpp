@@ -0,0 +1,58 @@
+#ifndef TRANSPORT_SIM_NETWORK_HPP
+#define TRANSPORT_SIM_NETWORK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace Transport {
+namespace SIM {
+
+/**
+ * Network
+ * Models the links between the simulated ranks.
+ *
+ * Every rank has one link to the network, which can
+ * send and receive at the same time. A message occupies
+ * the sending link of its source and the receiving link
+ * of its destination for len / bandwidth seconds, so
+ * messages to and from a busy rank queue up behind each
+ * other. Once the last byte has been sent, the message
+ * arrives after the latency plus a random jitter.
+ *
+ * The jitter of a message only depends on the seed and
+ * the ID of the message, so runs are reproducible.
+ */
+class Network {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        Network(const std::size_t ranks,
+                const std::size_t latency,
+                const std::size_t bandwidth,
+                const std::size_t jitter,
+                const std::size_t seed);
+
+        /** @description Reserve the links for a message and get its arrival time */
+        Clock::time_point send(const int src, const int dst, const std::size_t len, const std::size_t id);
+
+    private:
+        struct Link {
+            Clock::time_point out;  // when the sending side is free
+            Clock::time_point in;   // when the receiving side is free
+        };
+
+        const std::chrono::microseconds latency;
+        const std::size_t bandwidth;
+        const std::size_t jitter;
+        const std::size_t seed;
+
+        std::vector<Link> links;
+        std::mutex mutex;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef TRANSPORT_SIM_OPTIONS_HPP
+#define TRANSPORT_SIM_OPTIONS_HPP
+
+#include <cstddef>
+
+#include "transport/constants.hpp"
+#include "transport/Options.hpp"
+
+namespace Transport {
+namespace SIM {
+
+struct Options : ::Transport::Options {
+    /** @description One-way delay added to every message (microseconds) */
+    static const std::size_t DEFAULT_LATENCY = 1;
+
+    /** @description Bytes per second of each link; 0 does not limit bandwidth */
+    static const std::size_t DEFAULT_BANDWIDTH = 0;
+
+    /** @description Largest random delay added to the latency (microseconds) */
+    static const std::size_t DEFAULT_JITTER = 0;
+
+    /** @description Threads that run the simulated range servers */
+    static const std::size_t DEFAULT_WORKERS = 4;
+
+    /** @description Seed of the jitter, so runs are reproducible */
+    static const std::size_t DEFAULT_SEED = 0;
+
+    Options(const std::size_t ranks,
+            const std::size_t latency = DEFAULT_LATENCY,
+            const std::size_t bandwidth = DEFAULT_BANDWIDTH,
+            const std::size_t jitter = DEFAULT_JITTER,
+            const std::size_t workers = DEFAULT_WORKERS,
+            const std::size_t seed = DEFAULT_SEED)
+        : ::Transport::Options(TRANSPORT_SIM),
+          ranks(ranks),
+          latency(latency),
+          bandwidth(bandwidth),
+          jitter(jitter),
+          workers(workers),
+          seed(seed)
+    {}
+
+    const std::size_t ranks;      // logical ranks, including this one
+    const std::size_t latency;    // microseconds
+    const std::size_t bandwidth;  // bytes per second
+    const std::size_t jitter;     // microseconds
+    const std::size_t workers;
+    const std::size_t seed;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef TRANSPORT_SIM_RANGE_SERVER_HPP
+#define TRANSPORT_SIM_RANGE_SERVER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "datastore/datastore.hpp"
+#include "hxhim/struct.h"
+#include "transport/Credits.hpp"
+#include "transport/Scheduler.hpp"
+#include "transport/backend/SIM/Network.hpp"
+#include "transport/transport.hpp"
+
+namespace Transport {
+namespace SIM {
+
+/**
+ * Inbox
+ * Where the simulated range servers place the
+ * packed responses to one call to communicate.
+ * A response without data means that the request
+ * could not be processed.
+ */
+struct Inbox {
+    struct Response {
+        Network::Clock::time_point arrival;
+        void *data;
+        std::size_t len;
+    };
+
+    std::list<Response> responses;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+/**
+ * RangeServer
+ * Runs the range servers of every simulated rank
+ * other than this one.
+ *
+ * Each simulated range server has its own datastores and
+ * a Scheduler, and processes one request at a time, like
+ * the range server of a real rank with one handler. Packed
+ * requests are held until the network model says that they
+ * have arrived, and are then unpacked into the Scheduler of
+ * their range server. A pool of workers processes requests
+ * of range servers that are not busy, and packs the
+ * responses into the Inbox of the caller. Each range
+ * server grants credits out of its own budget.
+ */
+class RangeServer : virtual public ::Transport::RangeServer {
+    public:
+        RangeServer(hxhim_t *hx,
+                    const std::shared_ptr<Network> &network,
+                    const std::size_t workers);
+        ~RangeServer();
+
+        /** @description Take ownership of the datastores of a simulated range server */
+        void AddServer(const int rank, const std::vector<::Datastore::Datastore *> &datastores);
+
+        /** @description Whether or not rank is simulated by this object */
+        bool Has(const int rank) const;
+
+        /** @description Take ownership of a packed request that arrives at rank at the given time */
+        void deliver(const int rank, const Network::Clock::time_point &arrival,
+                     void *data, const std::size_t len, Inbox *inbox);
+
+    private:
+        struct Arrival {
+            Network::Clock::time_point time;
+            int rank;
+            void *data;
+            std::size_t len;
+            Inbox *inbox;
+
+            bool operator>(const Arrival &rhs) const;
+        };
+
+        struct Pending {
+            Message::Request::Request *request;
+            Inbox *inbox;
+        };
+
+        struct Server {
+            Server(const std::vector<::Datastore::Datastore *> &datastores,
+                   const std::size_t per_server,
+                   const SchedulePolicies &policies);
+
+            std::vector<::Datastore::Datastore *> datastores;
+            Scheduler<Pending> scheduled;
+            Grants grants;
+            bool busy;
+        };
+
+        void worker_thread();
+        void arrive(std::unique_lock<std::mutex> &lock);
+        void handle(const int rank, Server &server, const Pending &pending);
+        void reply(const int rank, const Message::Request::Request *request,
+                   Message::Response::Response *response, Inbox *inbox);
+
+        hxhim_t *hx;
+        std::shared_ptr<Network> network;
+
+        std::unordered_map<int, std::unique_ptr<Server> > servers;
+
+        std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival> > arrivals;
+        std::deque<int> ready;           // range servers with queued requests that are not busy
+        bool stop;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        std::vector<std::thread> workers;
+};
+
+}
+}
+
+#endif
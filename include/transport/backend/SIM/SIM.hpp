@@ -0,0 +1,10 @@
+#ifndef TRANSPORT_SIM_HPP
+#define TRANSPORT_SIM_HPP
+
+#include "transport/backend/SIM/EndpointGroup.hpp"
+#include "transport/backend/SIM/Init.hpp"
+#include "transport/backend/SIM/Network.hpp"
+#include "transport/backend/SIM/Options.hpp"
+#include "transport/backend/SIM/RangeServer.hpp"
+
+#endif
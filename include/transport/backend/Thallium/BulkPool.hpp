@@ -0,0 +1,72 @@
+#ifndef TRANSPORT_THALLIUM_BULK_POOL_HPP
+#define TRANSPORT_THALLIUM_BULK_POOL_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <thallium.hpp>
+
+namespace Transport {
+namespace Thallium {
+
+/**
+ * BulkPool
+ * Buffers that have already been exposed to the
+ * engine, grouped into power of 2 size classes.
+ *
+ * Registering memory is one of the most expensive
+ * operations of RDMA capable Mercury plugins, so
+ * regions are registered once and then reused by
+ * every request and response. Sizes larger than the
+ * largest size class are registered on demand and
+ * deregistered when they are released.
+ */
+class BulkPool {
+    public:
+        /** @description Smallest size class */
+        static const std::size_t MIN_SIZE = 4096;
+
+        /** @description Largest size class */
+        static const std::size_t MAX_SIZE = 16777216;
+
+        /** @description Number of idle regions kept per size class */
+        static const std::size_t MAX_FREE = 16;
+
+        struct Region {
+            void *buf;
+            std::size_t capacity;
+            std::size_t size_class;          // MAX_CLASSES if not pooled
+            thallium::bulk bulk;             // read_write
+        };
+
+        BulkPool(thallium::engine *engine);
+        ~BulkPool();
+
+        /** @description Register count regions that can hold size bytes ahead of time */
+        void reserve(const std::size_t size, const std::size_t count);
+
+        /** @description Get a region that can hold at least size bytes */
+        Region *acquire(const std::size_t size);
+
+        /** @description Return a region to the pool */
+        void release(Region *region);
+
+    private:
+        static const std::size_t MAX_CLASSES;
+
+        static std::size_t size_class(const std::size_t size);
+
+        Region *create(const std::size_t capacity, const std::size_t size_class);
+        void destroy(Region *region);
+
+        thallium::engine *engine;              // not owned by BulkPool
+
+        std::vector<std::vector<Region *> > free;
+        std::mutex mutex;
+};
+
+}
+}
+
+#endif
@@ -1,8 +1,15 @@
 #ifndef TRANSPORT_THALLIUM_ENDPOINT_GROUP_HPP
 #define TRANSPORT_THALLIUM_ENDPOINT_GROUP_HPP
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
+#include "transport/AddressBook.hpp"
+#include "transport/EndpointCache.hpp"
+#include "transport/Reachable.hpp"
 #include "transport/backend/Thallium/RangeServer.hpp"
 #include "transport/backend/Thallium/Utilities.hpp"
 #include "transport/transport.hpp"
@@ -10,6 +17,23 @@
 namespace Transport {
 namespace Thallium {
 
+/**
+ * Releases
+ * Addresses of large responses that have been pulled
+ * from a range server. They are sent to the range
+ * server along with the next request to it.
+ */
+struct Releases {
+    std::unordered_map<int, std::vector<uintptr_t> > addrs;
+    std::mutex mutex;
+};
+
+/** @description Endpoints stay alive while requests that use them are in flight */
+typedef std::shared_ptr<thallium::endpoint> Endpoint;
+
+/** @description Endpoints are looked up the first time they are used */
+typedef EndpointCache<Endpoint> Endpoints;
+
 /**
  * EndpointGroup
  * Collective communication endpoint implemented with thallium
@@ -17,17 +41,20 @@ namespace Thallium {
 class EndpointGroup : virtual public ::Transport::EndpointGroup {
     public:
         EndpointGroup(thallium::engine *engine,
-                      RangeServer *rs);
+                      RangeServer *rs,
+                      const std::shared_ptr<AddressBook> &addresses,
+                      const Reachable &reachable,
+                      const std::size_t cache_size);
         ~EndpointGroup();
 
-        /** @description Converts a string into an endpoint and adds it to the map_*/
-        int AddID(const int id, const std::string &address);
+        /** @description Converts a string into an endpoint and adds it to the cache */
+        int AddID(const int rank, const std::string &address);
 
-        /** @description Adds an endpoint to the map */
-        int AddID(const int id, thallium::endpoint *ep);
+        /** @description Adds an endpoint to the cache */
+        int AddID(const int rank, thallium::endpoint *ep);
 
         /** @description Removes an endpoint*/
-        void RemoveID(const int id);
+        void RemoveID(const int rank);
 
         /** @description Bulk Put to multiple endpoints       */
         Message::Response::BPut *communicate(const ReqList<Message::Request::BPut> &bpm_list);
@@ -45,10 +72,18 @@ class EndpointGroup : virtual public ::Transport::EndpointGroup {
         Message::Response::BHistogram *communicate(const ReqList<Message::Request::BHistogram> &bhm_list);
 
     private:
+        /** @description Looks up the endpoint of a rank that is not cached */
+        bool resolve(const int rank, Endpoint &ep);
+
         thallium::engine *engine;                                 /** take ownership */
         RangeServer *rs;                                          /** needed because thats where the rpc signatures are defined */
 
-        std::unordered_map<int, thallium::endpoint *> endpoints;  /** take ownership */
+        std::shared_ptr<AddressBook> addresses;
+        const Reachable reachable;
+        Endpoints endpoints;
+
+        /** @description Response leases that have not been acknowledged yet, by destination */
+        Releases releases;
 };
 
 }
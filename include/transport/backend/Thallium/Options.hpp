@@ -1,6 +1,7 @@
 #ifndef TRANSPORT_THALLIUM_OPTIONS_HPP
 #define TRANSPORT_THALLIUM_OPTIONS_HPP
 
+#include <cstddef>
 #include <string>
 
 #include "transport/constants.hpp"
@@ -10,14 +11,26 @@ namespace Transport {
 namespace Thallium {
 
 struct Options : ::Transport::Options {
-    Options(const std::string &module, const int thread_count)
+    /** @description Packets up to this size are carried in the RPC instead of through bulk transfers */
+    static const std::size_t DEFAULT_EAGER_SIZE = 4096;
+
+    /** @description Execution streams dedicated to each datastore; 0 runs requests in the RPC handler */
+    static const std::size_t DEFAULT_XSTREAMS_PER_DATASTORE = 1;
+
+    Options(const std::string &module, const int thread_count,
+            const std::size_t eager_size = DEFAULT_EAGER_SIZE,
+            const std::size_t xstreams_per_datastore = DEFAULT_XSTREAMS_PER_DATASTORE)
         : ::Transport::Options(TRANSPORT_THALLIUM),
           module(module),
-          thread_count(thread_count)
+          thread_count(thread_count),
+          eager_size(eager_size),
+          xstreams_per_datastore(xstreams_per_datastore)
     {}
 
     const std::string module;
     const int thread_count;
+    const std::size_t eager_size;
+    const std::size_t xstreams_per_datastore;
 };
 
 }
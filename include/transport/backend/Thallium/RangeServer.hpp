@@ -1,41 +1,112 @@
 #ifndef TRANSPORT_THALLIUM_RANGE_SERVER_HPP
 #define TRANSPORT_THALLIUM_RANGE_SERVER_HPP
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 #include <thallium.hpp>
 
 #include "hxhim/struct.h"
 #include "hxhim/options.h"
+#include "transport/Scheduler.hpp"
 #include "transport/transport.hpp"
+#include "transport/backend/Thallium/BulkPool.hpp"
 #include "transport/backend/Thallium/Utilities.hpp"
 
 namespace Transport {
 namespace Thallium {
 
+/**
+ * RangeServer
+ * Packets up to eager_size bytes are carried inside of
+ * the RPC arguments and return value. Larger packets are
+ * moved with bulk transfers through registered regions
+ * from a BulkPool, which is shared with the EndpointGroup
+ * of this process.
+ *
+ * A large response stays leased to the client until the
+ * client has pulled it. The client acknowledges the lease
+ * in its next request to this range server instead of
+ * sending a separate RPC. Leases that are never
+ * acknowledged are freed when the range server stops.
+ *
+ * RPC handlers only receive and unpack requests. The
+ * requests are then processed in an Argobots pool
+ * dedicated to the target datastore, so requests to
+ * different datastores proceed in parallel, and requests
+ * to the same datastore queue up without occupying
+ * handler threads. Queued requests are ordered by a
+ * Scheduler, so reads can go ahead of bulk writes.
+ */
 class RangeServer : virtual public ::Transport::RangeServer {
     public:
         /**
          * RPC name called by the client to send and receive data
          */
         static const std::string PROCESS_RPC_NAME;
-        static const std::string CLEANUP_RPC_NAME;
 
-        RangeServer(hxhim_t *hx, thallium::engine *engine);
+        RangeServer(hxhim_t *hx, thallium::engine *engine,
+                    const std::size_t eager_size,
+                    const std::size_t xstreams_per_datastore);
         ~RangeServer();
 
         // access RPCs using these functions
         const thallium::remote_procedure &process() const;
-        const thallium::remote_procedure &cleanup() const;
+
+        std::size_t EagerSize() const;
+
+        /** @description Registered regions used by both the client and the server */
+        BulkPool &Pool();
 
     private:
         hxhim_t *hx;
         thallium::engine *engine;  // not owned by RangeServer
         int rank;
+        const std::size_t eager_size;
+        BulkPool pool;
 
-        void process(const thallium::request &req, const std::size_t req_len, thallium::bulk &bulk);
+        void process(const thallium::request &req,
+                     const std::size_t req_len,
+                     const std::string &inline_req,
+                     thallium::bulk &bulk,
+                     const std::vector<uintptr_t> &released);
         const thallium::remote_procedure process_rpc;
 
-        void cleanup(const thallium::request &req, uintptr_t addr);
-        const thallium::remote_procedure cleanup_rpc;
+        /** @description Run a request through the datastores and send the response */
+        void respond(const thallium::request &req, Message::Request::Request *request);
+
+        /** @description Free response buffers that clients are done with */
+        void release(const std::vector<uintptr_t> &released);
+
+        /** @description Response regions that clients have not finished pulling */
+        std::unordered_set<uintptr_t> leases;
+        std::mutex leases_mutex;
+
+        /** @description A request waiting for its datastore */
+        struct Queued {
+            thallium::request *req;
+            Message::Request::Request *request;
+        };
+
+        /** @description Requests for one datastore */
+        struct DatastorePool {
+            DatastorePool(const SchedulePolicies &policies);
+
+            thallium::managed<thallium::pool> pool;
+            Scheduler<Queued> scheduled;
+            std::mutex mutex;                    // protects scheduled
+        };
+
+        /** @description Process the next scheduled request of a datastore */
+        void run(DatastorePool &dp);
+
+        /** @description One pool per datastore; empty if requests run in the handlers */
+        std::vector<std::unique_ptr<DatastorePool> > pools;
+        std::vector<thallium::managed<thallium::xstream> > xstreams;
 };
 
 }
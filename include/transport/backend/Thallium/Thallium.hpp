@@ -1,6 +1,7 @@
 #ifndef TRANSPORT_THALLIUM_HPP
 #define TRANSPORT_THALLIUM_HPP
 
+#include "transport/backend/Thallium/BulkPool.hpp"
 #include "transport/backend/Thallium/EndpointGroup.hpp"
 #include "transport/backend/Thallium/Init.hpp"
 #include "transport/backend/Thallium/Options.hpp"
@@ -3,6 +3,8 @@
 
 #include "transport/backend/local/local.hpp"
 #include "transport/backend/MPI/MPI.hpp"
+#include "transport/backend/SHM/SHM.hpp"
+#include "transport/backend/SIM/SIM.hpp"
 
 #if HXHIM_HAVE_THALLIUM
 #include "transport/backend/Thallium/Thallium.hpp"
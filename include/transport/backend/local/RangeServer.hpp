@@ -1,6 +1,8 @@
 #ifndef HXHIM_LOCAL_RANGE_SERVER_HPP
 #define HXHIM_LOCAL_RANGE_SERVER_HPP
 
+#include <vector>
+
 #include "datastore/datastore.hpp"
 #include "hxhim/constants.h"
 #include "hxhim/private/accessors.hpp"
@@ -15,6 +17,7 @@ namespace Transport {
 namespace local {
 
 Message::Response::Response *range_server(hxhim_t *hx, Message::Request::Request *req);
+Message::Response::Response *range_server(hxhim_t *hx, std::vector<::Datastore::Datastore *> &datastores, Message::Request::Request *req);
 
 /**
  * bput
@@ -23,13 +26,14 @@ Message::Response::Response *range_server(hxhim_t *hx, Message::Request::Request
  * @tparam Response_t  Message::Response::*
  * @tparam Request_t   Message::Request::*
  * @param hx           pointer to the main HXHIM struct
+ * @param datastores   the datastores of the range server that received the request
  * @param req          the request packet to operate on
  * @return             the response packet resulting from the request
  */
 template <typename Response_t, typename Request_t,
           typename = enable_if_t <is_child_of<Message::Request::Request,   Request_t> ::value &&
                                   is_child_of<Message::Response::Response, Response_t>::value> >
-Response_t *range_server(hxhim_t *hx, Request_t *req) {
+Response_t *range_server(hxhim_t *hx, std::vector<::Datastore::Datastore *> &datastores, Request_t *req) {
     req->timestamps.transport.start = ::Stats::now();
 
     int rank = -1;
@@ -41,6 +45,7 @@ Response_t *range_server(hxhim_t *hx, Request_t *req) {
     Response_t *res = construct<Response_t>(req->count);
     res->src = req->dst;
     res->dst = req->src;
+    res->seq = req->seq;
     res->steal_timestamps(req, false);
 
     // no packing
@@ -50,8 +55,7 @@ Response_t *range_server(hxhim_t *hx, Request_t *req) {
     // send to each datastore
     res->timestamps.transport.send_start = ::Stats::now();
 
-    decltype(hx->p->range_server.datastores) &datastores = hx->p->range_server.datastores;
-    Response_t *response = datastores.ds[req->dst % datastores.per_server]->operate(req);
+    Response_t *response = datastores[req->dst % hx->p->range_server.datastores.per_server]->operate(req);
 
     // if there were responses, copy them into the output variable
     if (response) {
@@ -83,6 +87,23 @@ Response_t *range_server(hxhim_t *hx, Request_t *req) {
     return res;
 }
 
+/**
+ * range_server
+ * Runs a request against the datastores of this rank
+ *
+ * @tparam Response_t  Message::Response::*
+ * @tparam Request_t   Message::Request::*
+ * @param hx           pointer to the main HXHIM struct
+ * @param req          the request packet to operate on
+ * @return             the response packet resulting from the request
+ */
+template <typename Response_t, typename Request_t,
+          typename = enable_if_t <is_child_of<Message::Request::Request,   Request_t> ::value &&
+                                  is_child_of<Message::Response::Response, Response_t>::value> >
+Response_t *range_server(hxhim_t *hx, Request_t *req) {
+    return range_server<Response_t, Request_t>(hx, hx->p->range_server.datastores.ds, req);
+}
+
 }
 }
 
@@ -9,6 +9,8 @@ namespace Transport {
 enum Type {
     TRANSPORT_NULL,
     TRANSPORT_MPI,
+    TRANSPORT_SHM,
+    TRANSPORT_SIM,
 
     #if HXHIM_HAVE_THALLIUM
     TRANSPORT_THALLIUM,
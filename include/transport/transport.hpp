@@ -5,16 +5,21 @@
 #ifndef TRANSPORT_HPP
 #define TRANSPORT_HPP
 
-#include <unordered_map>
+#include <atomic>
+#include <map>
 
 #include "message/Messages.hpp"
 #include "transport/constants.hpp"
 
 namespace Transport {
 
-// destination MPI rank -> single Request packet
+// destination MPI rank -> Request packets
+// a destination can have multiple packets in flight at once,
+// so responses are matched to requests by sequence ID
+// packets going to the same destination are kept in the order
+// they were added so that later writes are applied after earlier ones
 template <typename Req>
-using ReqList = std::unordered_map<int, Req *>;
+using ReqList = std::multimap<int, Req *>;
 
 /**
  * An abstract group of communication endpoints
@@ -88,10 +93,26 @@ class Transport {
         Message::Response::BHistogram *communicate(const ReqList<Message::Request::BHistogram> &bhm_list);
 
     private:
+        /** @description Give each packet a new sequence ID */
+        template <typename Req>
+        const ReqList<Req> &sequence(const ReqList<Req> &list);
+
         EndpointGroup *endpointgroup_;
         RangeServer *rangeserver_;
+
+        std::atomic<std::size_t> seq_;
 };
 
+template <typename Req>
+const ReqList<Req> &Transport::sequence(const ReqList<Req> &list) {
+    for(typename ReqList<Req>::value_type const &req : list) {
+        if (req.second) {
+            req.second->seq = seq_++;
+        }
+    }
+    return list;
+}
+
 }
 
 #endif //HXHIM_TRANSPORT
@@ -5,6 +5,7 @@
 
 #include "hxhim/struct.h"
 #include "message/Messages.hpp"
+#include "transport/Credits.hpp"
 #include "transport/Options.hpp"
 #include "transport/backend/backends.hpp"
 #include "transport/constants.hpp"
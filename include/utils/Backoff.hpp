@@ -0,0 +1,38 @@
+#ifndef BACKOFF_HPP
+#define BACKOFF_HPP
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * Backoff
+ * Adaptive delay for polling loops.
+ * The first few idle polls only spin so that
+ * latency stays low when traffic is arriving.
+ * After that, the caller yields and then sleeps
+ * for exponentially longer periods, up to a cap,
+ * so that an idle poller costs almost no CPU.
+ * Call reset() whenever progress is made.
+ */
+class Backoff {
+    public:
+        Backoff(const std::size_t spins = 64,
+                const std::chrono::microseconds &min = std::chrono::microseconds(1),
+                const std::chrono::microseconds &max = std::chrono::microseconds(1000));
+
+        void reset();
+        void wait();
+
+        /** @description how long the next wait will sleep (0 while spinning or yielding) */
+        std::chrono::microseconds delay() const;
+
+    private:
+        const std::size_t spins;
+        const std::chrono::microseconds min;
+        const std::chrono::microseconds max;
+
+        std::size_t idle;
+        std::chrono::microseconds sleep;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define HISTOGRAM_HPP
 
 #include <memory>
+#include <mutex>
 #include <ostream>
 
 #include "utils/memory.hpp"
@@ -21,6 +22,10 @@ struct Config {
  * Enough values have to be placed into the histogram for the
  * buckets to be generated.
  * Each bucket represents the left (lower) end of a range.
+ *
+ * Each histogram has its own lock, so values can be
+ * added while other threads read or pack it. Pointers
+ * returned by get and get_cache are not protected.
  */
 class Histogram {
     public:
@@ -69,6 +74,8 @@ class Histogram {
         double *buckets_;                       // the left end of the buckets (has size_ + 1 values)
         std::size_t *counts_;                   // the counts at the buckets
         std::size_t size_;                      // the number of buckets
+
+        mutable std::recursive_mutex mutex_;    // public functions call each other
 };
 
 // deleter for std::shared_ptr
@@ -0,0 +1,63 @@
+#ifndef RWLOCK_HPP
+#define RWLOCK_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * RWLock
+ * A reader/writer lock for C++11, which does not
+ * have std::shared_mutex.
+ *
+ * Any number of readers can hold the lock at once,
+ * while a writer holds it alone. Waiting writers
+ * block new readers so that a steady stream of
+ * readers cannot starve them.
+ *
+ * lock/unlock satisfy BasicLockable, so writers
+ * can use std::lock_guard<RWLock>. RWLock::Guard
+ * takes either mode, for callers that only know
+ * which one they need at runtime.
+ */
+class RWLock {
+    public:
+        RWLock();
+
+        void lock();
+        void unlock();
+
+        void lock_shared();
+        void unlock_shared();
+
+        enum Mode {
+            SHARED,
+            EXCLUSIVE
+        };
+
+        /**
+         * Guard
+         * Holds the lock for the lifetime of the object
+         */
+        class Guard {
+            public:
+                Guard(RWLock &rwlock, const Mode mode);
+                ~Guard();
+
+                Guard(const Guard &) = delete;
+                Guard &operator=(const Guard &) = delete;
+
+            private:
+                RWLock &rwlock;
+                const Mode mode;
+        };
+
+    private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t readers;            // readers holding the lock
+        std::size_t writers;            // writers waiting for the lock
+        bool writing;                   // whether or not a writer holds the lock
+};
+
+#endif
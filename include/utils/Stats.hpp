@@ -1,7 +1,9 @@
 #ifndef STATS_HPP
 #define STATS_HPP
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <sstream>
 #include <string>
@@ -28,6 +30,43 @@ uint64_t nano(const Chronostamp &duration);
 long double sec(const Chronopoint &start, const Chronopoint &end);
 long double sec(const Chronostamp &duration);
 
+/**
+ * Distribution
+ * A fixed size histogram of unsigned values that
+ * can be updated by many threads without locking.
+ *
+ * Values are placed into log-linear buckets: each
+ * power of 2 is split into SUB_BUCKETS buckets, so
+ * every value is within 25% of its bucket's bounds
+ * no matter how large it is.
+ */
+class Distribution {
+    public:
+        static const std::size_t SUB_BITS = 2;
+        static const std::size_t SUB_BUCKETS = 1 << SUB_BITS;
+        static const std::size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+        Distribution();
+
+        void add(const uint64_t value);
+
+        uint64_t count() const;
+        uint64_t sum() const;
+        uint64_t bucket(const std::size_t i) const;
+
+        /** @description The smallest bucket upper bound that at least q of the values are at or below */
+        uint64_t quantile(const double q) const;
+
+        static std::size_t index(const uint64_t value);
+        static uint64_t lower(const std::size_t i);
+        static uint64_t upper(const std::size_t i);
+
+    private:
+        std::atomic<uint64_t> count_;
+        std::atomic<uint64_t> sum_;
+        std::atomic<uint64_t> buckets[BUCKETS];
+};
+
 // /////////////////////////////////////////////////////////
 
 // Timestamps of each request from the user's perspective
@@ -55,6 +55,45 @@ int decode(T *dst, const char *src, const std::size_t count) {
     return run<T>(dst, src, sizeof(T) * count);
 }
 
+/**
+ * run_array
+ * Converts count fixed width values one value at a time.
+ * The loop over the values has no dependencies between
+ * iterations, so it can be vectorized.
+ */
+template <typename T>
+int run_array(void *dst, const void *src, const std::size_t count) {
+    if (!dst || !src) {
+        return HXHIM_ERROR;
+    }
+
+    #if SYSTEM_BIG_ENDIAN
+    char *dst_ptr = (char *) dst;
+    const char *src_ptr = (const char *) src;
+    for(std::size_t i = 0; i < count; i++) {
+        for(std::size_t j = 0; j < sizeof(T); j++) {
+            dst_ptr[i * sizeof(T) + j] = src_ptr[i * sizeof(T) + sizeof(T) - 1 - j];
+        }
+    }
+    #else
+    std::memcpy(dst, src, sizeof(T) * count);
+    #endif
+
+    return HXHIM_SUCCESS;
+}
+
+/** @description encoding of an array of values, each of which is encoded separately */
+template <typename T>
+int encode_array(char *dst, const T *src, const std::size_t count) {
+    return run_array<T>(dst, src, count);
+}
+
+/** @description decoding of an array of separately encoded values */
+template <typename T>
+int decode_array(T *dst, const char *src, const std::size_t count) {
+    return run_array<T>(dst, src, count);
+}
+
 }
 
 #endif
@@ -43,6 +43,8 @@
      "MPI"              => "MPI Transport",
      "THALLIUM"         => "Thallium Transport",
      "HISTOGRAM"        => "Histogram",
+     "SHM"              => "Shared Memory Transport",
+     "SIM"              => "Simulated Transport",
 );
 
 @mloglvls = (
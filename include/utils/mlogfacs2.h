@@ -51,7 +51,9 @@ static const char *mlog_facsarray[] = {
     "MPI",           /* 8 */
     "THALLIUM",      /* 9 */
     "HISTOGRAM",     /* 10 */
-    0,               /* 11 */
+    "SHM",           /* 11 */
+    "SIM",           /* 12 */
+    0,               /* 13 */
 };
 #endif /* MLOG_FACSARRAY || MLOG_AFACSARRAY */
 
@@ -68,7 +70,9 @@ static const char *mlog_lfacsarray[] = {
     "MPI Transport", /* 8 */
     "Thallium Transport", /* 9 */
     "Histogram",     /* 10 */
-    0,               /* 11 */
+    "Shared Memory Transport", /* 11 */
+    "Simulated Transport", /* 12 */
+    0,               /* 13 */
 };
 #endif /* MLOG_LFACSARRAY || MLOG_LFACSARRAY */
 
@@ -85,6 +89,8 @@ static const char *mlog_lfacsarray[] = {
 #define MLOGFAC_MPI       8 /* MPI Transport */
 #define MLOGFAC_THALLIUM  9 /* Thallium Transport */
 #define MLOGFAC_HISTOGRAM 10 /* Histogram */
+#define MLOGFAC_SHM      11 /* Shared Memory Transport */
+#define MLOGFAC_SIM      12 /* Simulated Transport */
 
 /*
  * HXHIM options MLOG levels
@@ -286,4 +292,44 @@ static const char *mlog_lfacsarray[] = {
 #define HISTOGRAM_DBG3   (10 | MLOG_DBG3)
 #define HISTOGRAM_DRARE   HISTOGRAM_DBG3
 
+/*
+ * Shared Memory Transport MLOG levels
+ */
+#define SHM_EMERG        (11 | MLOG_EMERG)
+#define SHM_ALERT        (11 | MLOG_ALERT)
+#define SHM_CRIT         (11 | MLOG_CRIT)
+#define SHM_ERR          (11 | MLOG_ERR)
+#define SHM_WARN         (11 | MLOG_WARN)
+#define SHM_NOTE         (11 | MLOG_NOTE)
+#define SHM_INFO         (11 | MLOG_INFO)
+#define SHM_DBG          (11 | MLOG_DBG)
+#define SHM_DBG0         (11 | MLOG_DBG0)
+#define SHM_DAPI          SHM_DBG0
+#define SHM_DBG1         (11 | MLOG_DBG1)
+#define SHM_DINTAPI       SHM_DBG1
+#define SHM_DBG2         (11 | MLOG_DBG2)
+#define SHM_DCOMMON       SHM_DBG2
+#define SHM_DBG3         (11 | MLOG_DBG3)
+#define SHM_DRARE         SHM_DBG3
+
+/*
+ * Simulated Transport MLOG levels
+ */
+#define SIM_EMERG        (12 | MLOG_EMERG)
+#define SIM_ALERT        (12 | MLOG_ALERT)
+#define SIM_CRIT         (12 | MLOG_CRIT)
+#define SIM_ERR          (12 | MLOG_ERR)
+#define SIM_WARN         (12 | MLOG_WARN)
+#define SIM_NOTE         (12 | MLOG_NOTE)
+#define SIM_INFO         (12 | MLOG_INFO)
+#define SIM_DBG          (12 | MLOG_DBG)
+#define SIM_DBG0         (12 | MLOG_DBG0)
+#define SIM_DAPI          SIM_DBG0
+#define SIM_DBG1         (12 | MLOG_DBG1)
+#define SIM_DINTAPI       SIM_DBG1
+#define SIM_DBG2         (12 | MLOG_DBG2)
+#define SIM_DCOMMON       SIM_DBG2
+#define SIM_DBG3         (12 | MLOG_DBG3)
+#define SIM_DRARE         SIM_DBG3
+
 #endif /* _MLOGFACS_H_ */
@@ -0,0 +1,520 @@
+#include <algorithm>
+#include <cstring>
+
+#include "datastore/BPlusTree.hpp"
+
+const std::size_t Datastore::BPlusTree::LEAF_RECORDS;
+const std::size_t Datastore::BPlusTree::LEAF_BYTES;
+const std::size_t Datastore::BPlusTree::INNER_CHILDREN;
+
+// size of the key length and value length in front of each record
+static const std::size_t HEADER = 2 * sizeof(std::size_t);
+
+/**
+ * compare
+ * Orders bytes the same way as std::string
+ *
+ * @param lhs      the left hand side
+ * @param lhs_len  the length of the left hand side
+ * @param rhs      the right hand side
+ * @return negative, 0, or positive, like memcmp
+ */
+static int compare(const char *lhs, const std::size_t lhs_len,
+                   const std::string &rhs) {
+    const int cmp = memcmp(lhs, rhs.data(), std::min(lhs_len, rhs.size()));
+    if (cmp) {
+        return cmp;
+    }
+
+    if (lhs_len < rhs.size()) {
+        return -1;
+    }
+
+    return (lhs_len > rhs.size())?1:0;
+}
+
+Datastore::BPlusTree::Slice::Slice(const char *ptr, const std::size_t len)
+    : ptr(ptr),
+      len(len)
+{}
+
+const char *Datastore::BPlusTree::Slice::data() const {
+    return ptr;
+}
+
+std::size_t Datastore::BPlusTree::Slice::size() const {
+    return len;
+}
+
+bool Datastore::BPlusTree::Slice::starts_with(const std::string &prefix) const {
+    return (len >= prefix.size()) && (memcmp(ptr, prefix.data(), prefix.size()) == 0);
+}
+
+Datastore::BPlusTree::Slice::operator std::string() const {
+    return std::string(ptr, len);
+}
+
+Datastore::BPlusTree::const_iterator::const_iterator()
+    : const_iterator(nullptr, nullptr, 0)
+{}
+
+Datastore::BPlusTree::const_iterator::const_iterator(const BPlusTree *tree, const Leaf *leaf, const std::size_t index)
+    : tree(tree),
+      leaf(leaf),
+      index(index),
+      record()
+{
+    load();
+}
+
+void Datastore::BPlusTree::const_iterator::load() {
+    if (leaf) {
+        record.first = leaf->key(index);
+        record.second = leaf->value(index);
+    }
+    else {
+        record.first = Slice();
+        record.second = Slice();
+    }
+}
+
+const Datastore::BPlusTree::Record &Datastore::BPlusTree::const_iterator::operator*() const {
+    return record;
+}
+
+const Datastore::BPlusTree::Record *Datastore::BPlusTree::const_iterator::operator->() const {
+    return &record;
+}
+
+Datastore::BPlusTree::const_iterator &Datastore::BPlusTree::const_iterator::operator++() {
+    if (leaf) {
+        *this = tree->make_iterator(leaf, index + 1);
+    }
+    return *this;
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::const_iterator::operator++(int) {
+    const_iterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+Datastore::BPlusTree::const_iterator &Datastore::BPlusTree::const_iterator::operator--() {
+    if (!leaf) {
+        leaf = tree->tail;
+        index = leaf->count();
+    }
+
+    if (index) {
+        index--;
+    }
+    else if (leaf->prev) {
+        leaf = leaf->prev;
+        index = leaf->count() - 1;
+    }
+
+    // the tree is empty
+    if (!leaf->count()) {
+        leaf = nullptr;
+        index = 0;
+    }
+
+    load();
+    return *this;
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::const_iterator::operator--(int) {
+    const_iterator copy = *this;
+    --*this;
+    return copy;
+}
+
+bool Datastore::BPlusTree::const_iterator::operator==(const const_iterator &rhs) const {
+    return (tree == rhs.tree) && (leaf == rhs.leaf) && (index == rhs.index);
+}
+
+bool Datastore::BPlusTree::const_iterator::operator!=(const const_iterator &rhs) const {
+    return !(*this == rhs);
+}
+
+Datastore::BPlusTree::Node::Node(const bool is_leaf)
+    : is_leaf(is_leaf)
+{}
+
+Datastore::BPlusTree::Node::~Node() {}
+
+Datastore::BPlusTree::Leaf::Leaf()
+    : Node(true),
+      offsets(),
+      slab(),
+      garbage(0),
+      prev(nullptr),
+      next(nullptr)
+{}
+
+std::size_t Datastore::BPlusTree::Leaf::count() const {
+    return offsets.size();
+}
+
+Datastore::BPlusTree::Slice Datastore::BPlusTree::Leaf::key(const std::size_t i) const {
+    const char *record = slab.data() + offsets[i];
+    std::size_t key_len = 0;
+    memcpy(&key_len, record, sizeof(key_len));
+    return Slice(record + HEADER, key_len);
+}
+
+Datastore::BPlusTree::Slice Datastore::BPlusTree::Leaf::value(const std::size_t i) const {
+    const char *record = slab.data() + offsets[i];
+    std::size_t key_len = 0;
+    std::size_t value_len = 0;
+    memcpy(&key_len, record, sizeof(key_len));
+    memcpy(&value_len, record + sizeof(key_len), sizeof(value_len));
+    return Slice(record + HEADER + key_len, value_len);
+}
+
+std::size_t Datastore::BPlusTree::Leaf::search(const std::string &key, const bool upper) const {
+    std::size_t low = 0;
+    std::size_t high = count();
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        const Slice mid_key = this->key(mid);
+        const int cmp = compare(mid_key.data(), mid_key.size(), key);
+        if ((cmp < 0) || (upper && (cmp == 0))) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * insert
+ * The record is appended to the slab, and
+ * its offset is placed at index i.
+ *
+ * @param i          the index of the new record
+ * @param key        the key
+ * @param key_len    the length of the key
+ * @param value      the value
+ * @param value_len  the length of the value
+ */
+void Datastore::BPlusTree::Leaf::insert(const std::size_t i,
+                                        const char *key, const std::size_t key_len,
+                                        const char *value, const std::size_t value_len) {
+    const std::size_t offset = slab.size();
+    slab.resize(offset + HEADER + key_len + value_len);
+
+    char *record = slab.data() + offset;
+    memcpy(record, &key_len, sizeof(key_len));
+    memcpy(record + sizeof(key_len), &value_len, sizeof(value_len));
+    memcpy(record + HEADER, key, key_len);
+    memcpy(record + HEADER + key_len, value, value_len);
+
+    offsets.insert(offsets.begin() + i, offset);
+}
+
+void Datastore::BPlusTree::Leaf::remove(const std::size_t i) {
+    garbage += HEADER + key(i).size() + value(i).size();
+    offsets.erase(offsets.begin() + i);
+
+    // reclaim the slab once most of it has been removed
+    if (garbage > slab.size() / 2) {
+        compact();
+    }
+}
+
+void Datastore::BPlusTree::Leaf::compact() {
+    std::vector<char> compacted;
+    compacted.reserve(slab.size() - garbage);
+    for(std::size_t i = 0; i < count(); i++) {
+        const std::size_t len = HEADER + key(i).size() + value(i).size();
+        const std::size_t new_offset = compacted.size();
+        compacted.insert(compacted.end(), slab.begin() + offsets[i], slab.begin() + offsets[i] + len);
+        offsets[i] = new_offset;
+    }
+
+    slab.swap(compacted);
+    garbage = 0;
+}
+
+Datastore::BPlusTree::Leaf *Datastore::BPlusTree::Leaf::split() {
+    const std::size_t half = count() / 2;
+
+    Leaf *right = new Leaf();
+    for(std::size_t i = half; i < count(); i++) {
+        const Slice k = key(i);
+        const Slice v = value(i);
+        right->insert(right->count(), k.data(), k.size(), v.data(), v.size());
+    }
+
+    offsets.resize(half);
+    compact();
+
+    right->prev = this;
+    right->next = next;
+    if (next) {
+        next->prev = right;
+    }
+    next = right;
+
+    return right;
+}
+
+Datastore::BPlusTree::Inner::Inner()
+    : Node(false),
+      keys(),
+      children()
+{}
+
+Datastore::BPlusTree::Inner::~Inner() {
+    for(Node *child : children) {
+        delete child;
+    }
+}
+
+std::size_t Datastore::BPlusTree::Inner::child(const std::string &key) const {
+    return std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+}
+
+Datastore::BPlusTree::BPlusTree()
+    : root(nullptr),
+      head(nullptr),
+      tail(nullptr),
+      count(0)
+{
+    clear();
+}
+
+Datastore::BPlusTree::~BPlusTree() {
+    delete root;
+}
+
+std::size_t Datastore::BPlusTree::size() const {
+    return count;
+}
+
+bool Datastore::BPlusTree::empty() const {
+    return !count;
+}
+
+/**
+ * clear
+ * An empty tree is a single empty leaf
+ */
+void Datastore::BPlusTree::clear() {
+    delete root;
+    head = tail = new Leaf();
+    root = head;
+    count = 0;
+}
+
+void Datastore::BPlusTree::put(const std::string &key, const std::string &value) {
+    put(key, value.data(), value.size());
+}
+
+/**
+ * put
+ * Overwritten values are removed from their leaf
+ * and the new record is added to the same leaf.
+ * Leaves and inner nodes that become too large
+ * are split, starting from the leaf.
+ *
+ * @param key        the key
+ * @param value      the value
+ * @param value_len  the length of the value
+ */
+void Datastore::BPlusTree::put(const std::string &key, const char *value, const std::size_t value_len) {
+    Path path;
+    Leaf *leaf = descend(key, &path);
+
+    const std::size_t i = leaf->search(key, false);
+    if ((i < leaf->count()) && (compare(leaf->key(i).data(), leaf->key(i).size(), key) == 0)) {
+        // removing the old record might compact the slab that value points into
+        const char *slab = leaf->slab.data();
+        if ((value >= slab) && (value < slab + leaf->slab.size())) {
+            const std::string copy(value, value_len);
+            leaf->remove(i);
+            leaf->insert(i, key.data(), key.size(), copy.data(), copy.size());
+        }
+        else {
+            leaf->remove(i);
+            leaf->insert(i, key.data(), key.size(), value, value_len);
+        }
+    }
+    else {
+        leaf->insert(i, key.data(), key.size(), value, value_len);
+        count++;
+    }
+
+    if ((leaf->count() <= LEAF_RECORDS) &&
+        ((leaf->slab.size() - leaf->garbage <= LEAF_BYTES) || (leaf->count() < 2))) {
+        return;
+    }
+
+    // split the leaf and push the first key of the new leaf up
+    Leaf *new_leaf = leaf->split();
+    if (tail == leaf) {
+        tail = new_leaf;
+    }
+
+    std::string separator = new_leaf->key(0);
+    Node *right = new_leaf;
+    Node *left = leaf;
+
+    while (path.size()) {
+        Inner *parent = path.back().first;
+        const std::size_t index = path.back().second;
+        path.pop_back();
+
+        parent->keys.insert(parent->keys.begin() + index, separator);
+        parent->children.insert(parent->children.begin() + index + 1, right);
+
+        if (parent->children.size() <= INNER_CHILDREN) {
+            return;
+        }
+
+        // split the inner node; the middle key moves up
+        const std::size_t half = parent->keys.size() / 2;
+        Inner *new_inner = new Inner();
+        separator = parent->keys[half];
+        new_inner->keys.assign(parent->keys.begin() + half + 1, parent->keys.end());
+        new_inner->children.assign(parent->children.begin() + half + 1, parent->children.end());
+        parent->keys.resize(half);
+        parent->children.resize(half + 1);
+
+        left = parent;
+        right = new_inner;
+    }
+
+    // the root split
+    Inner *new_root = new Inner();
+    new_root->keys.push_back(separator);
+    new_root->children.push_back(left);
+    new_root->children.push_back(right);
+    root = new_root;
+}
+
+/**
+ * erase
+ * Leaves that become empty are removed from the
+ * tree, as are inner nodes that lose all of their
+ * children. A root with a single child is replaced
+ * by its child.
+ *
+ * @param key  the key to remove
+ * @return whether or not the key was found
+ */
+bool Datastore::BPlusTree::erase(const std::string &key) {
+    Path path;
+    Leaf *leaf = descend(key, &path);
+
+    const std::size_t i = leaf->search(key, false);
+    if ((i == leaf->count()) || (compare(leaf->key(i).data(), leaf->key(i).size(), key) != 0)) {
+        return false;
+    }
+
+    leaf->remove(i);
+    count--;
+
+    if (leaf->count() || (leaf == root)) {
+        return true;
+    }
+
+    // unlink the empty leaf
+    if (leaf->prev) {
+        leaf->prev->next = leaf->next;
+    }
+    else {
+        head = leaf->next;
+    }
+
+    if (leaf->next) {
+        leaf->next->prev = leaf->prev;
+    }
+    else {
+        tail = leaf->prev;
+    }
+
+    // remove the empty node from its parent
+    Node *node = leaf;
+    while (path.size()) {
+        Inner *parent = path.back().first;
+        const std::size_t index = path.back().second;
+        path.pop_back();
+
+        parent->children.erase(parent->children.begin() + index);
+        delete node;
+
+        if (parent->keys.size()) {
+            parent->keys.erase(parent->keys.begin() + (index?index - 1:0));
+        }
+
+        if (parent->children.size()) {
+            break;
+        }
+
+        node = parent;
+    }
+
+    // shrink the tree
+    while (!root->is_leaf && (static_cast<Inner *>(root)->children.size() == 1)) {
+        Inner *old_root = static_cast<Inner *>(root);
+        root = old_root->children[0];
+        old_root->children.clear();
+        delete old_root;
+    }
+
+    return true;
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::begin() const {
+    return make_iterator(head, 0);
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::end() const {
+    return const_iterator(this, nullptr, 0);
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::find(const std::string &key) const {
+    const_iterator it = lower_bound(key);
+    if ((it != end()) && (compare(it->first.data(), it->first.size(), key) != 0)) {
+        return end();
+    }
+    return it;
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::lower_bound(const std::string &key) const {
+    const Leaf *leaf = descend(key, nullptr);
+    return make_iterator(leaf, leaf->search(key, false));
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::upper_bound(const std::string &key) const {
+    const Leaf *leaf = descend(key, nullptr);
+    return make_iterator(leaf, leaf->search(key, true));
+}
+
+Datastore::BPlusTree::Leaf *Datastore::BPlusTree::descend(const std::string &key, Path *path) const {
+    Node *node = root;
+    while (!node->is_leaf) {
+        Inner *inner = static_cast<Inner *>(node);
+        const std::size_t index = inner->child(key);
+        if (path) {
+            path->emplace_back(inner, index);
+        }
+        node = inner->children[index];
+    }
+
+    return static_cast<Leaf *>(node);
+}
+
+Datastore::BPlusTree::const_iterator Datastore::BPlusTree::make_iterator(const Leaf *leaf, const std::size_t index) const {
+    // only the root leaf can be empty, so the next leaf always has records
+    if (index >= leaf->count()) {
+        return (leaf->next)?const_iterator(this, leaf->next, 0):end();
+    }
+
+    return const_iterator(this, leaf, index);
+}
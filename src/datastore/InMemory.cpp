@@ -52,6 +52,10 @@ Message::Response::BPut *Datastore::InMemory::BPutImpl(Message::Request::BPut *r
 
     Message::Response::BPut *res = construct<Message::Response::BPut>(req->count);
 
+    // reused by every PUT in this packet
+    std::string key;
+    std::string value;
+
     for(std::size_t i = 0; i < req->count; i++) {
         void *subject = nullptr;
         std::size_t subject_len = 0;
@@ -64,13 +68,11 @@ Message::Response::BPut *Datastore::InMemory::BPutImpl(Message::Request::BPut *r
         if ((encode(callbacks, req->subjects[i],   &subject,   &subject_len)   == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->predicates[i], &predicate, &predicate_len) == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->objects[i],    &object,    &object_len)    == DATASTORE_SUCCESS)) {
-            // the current key address and length
-            Blob key;
             if (sp_to_key(ReferenceBlob(subject,   subject_len,   req->subjects[i].data_type()),
                           ReferenceBlob(predicate, predicate_len, req->predicates[i].data_type()),
-                          &key) == HXHIM_SUCCESS) {
-                Blob value = append_type(object, object_len, req->objects[i].data_type());
-                db[(std::string) key] = (std::string) value;
+                          key) == HXHIM_SUCCESS) {
+                append_type(object, object_len, req->objects[i].data_type(), value);
+                db.put(key, value);
 
                 event.size += key.size() + value.size();
                 status = DATASTORE_SUCCESS;
@@ -93,7 +95,7 @@ Message::Response::BPut *Datastore::InMemory::BPutImpl(Message::Request::BPut *r
     }
 
     event.time.end = ::Stats::now();
-    stats.puts.emplace_back(event);
+    AddEvent(stats.puts, event);
 
     return res;
 }
@@ -112,6 +114,8 @@ Message::Response::BGet *Datastore::InMemory::BGetImpl(Message::Request::BGet *r
 
     Message::Response::BGet *res = construct<Message::Response::BGet>(req->count);
 
+    std::string key; // reused by every GET in this packet
+
     for(std::size_t i = 0; i < req->count; i++) {
         void *subject = nullptr;
         std::size_t subject_len = 0;
@@ -125,11 +129,10 @@ Message::Response::BGet *Datastore::InMemory::BGetImpl(Message::Request::BGet *r
         if ((encode(callbacks, req->subjects[i],   &subject,   &subject_len)   == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->predicates[i], &predicate, &predicate_len) == DATASTORE_SUCCESS)) {
             // create the key from the subject and predicate
-            Blob key;
             if (sp_to_key(ReferenceBlob(subject,   subject_len,   req->subjects[i].data_type()),
                           ReferenceBlob(predicate, predicate_len, req->predicates[i].data_type()),
-                          &key) == HXHIM_SUCCESS) {
-                decltype(db)::const_iterator it = db.find((std::string) key);
+                          key) == HXHIM_SUCCESS) {
+                decltype(db)::const_iterator it = db.find(key);
                 if (it != db.end()) {
                     std::size_t value_len = it->second.size();
                     object_type = remove_type((void *) it->second.data(), value_len);
@@ -165,7 +168,7 @@ Message::Response::BGet *Datastore::InMemory::BGetImpl(Message::Request::BGet *r
     }
 
     event.time.end = ::Stats::now();
-    stats.gets.emplace_back(event);
+    AddEvent(stats.gets, event);
 
     return res;
 }
@@ -196,7 +199,40 @@ Message::Response::BGetOp *Datastore::InMemory::BGetOpImpl(Message::Request::BGe
         BGetOp_loop_init(req, res, i, subject, subject_len, predicate, predicate_len, key, prefix_len);
 
         if (res->statuses[i] == DATASTORE_UNSET) {
-            if (req->ops[i] == hxhim_getop_t::HXHIM_GETOP_EQ) {
+            if ((req->ops[i] != hxhim_getop_t::HXHIM_GETOP_EQ) && req->cursors[i].size()) {
+                // continue after the last record of the previous chunk
+                const std::string cursor((const char *) req->cursors[i].data(), req->cursors[i].size());
+
+                // LOWEST and HIGHEST stay within the original prefix
+                std::string prefix;
+                if ((req->ops[i] == hxhim_getop_t::HXHIM_GETOP_LOWEST) ||
+                    (req->ops[i] == hxhim_getop_t::HXHIM_GETOP_HIGHEST)) {
+                    prefix.assign((const char *) key.data(), prefix_len);
+                }
+
+                if (BGetOp_forward(req->ops[i])) {
+                    it = db.upper_bound(cursor);
+                    for(std::size_t j = 0;
+                        (j < req->num_recs[i]) &&
+                        (it != db.end()) &&
+                        it->first.starts_with(prefix);
+                        j++) {
+                        this->template BGetOp_copy_response(callbacks, it->first, it->second, req, res, i, j, event);
+                        it++;
+                    }
+                }
+                else {
+                    it = db.lower_bound(cursor);
+                    for(std::size_t j = 0; (j < req->num_recs[i]) && (it != db.begin()); j++) {
+                        it--;
+                        if (!it->first.starts_with(prefix)) {
+                            break;
+                        }
+                        this->template BGetOp_copy_response(callbacks, it->first, it->second, req, res, i, j, event);
+                    }
+                }
+            }
+            else if (req->ops[i] == hxhim_getop_t::HXHIM_GETOP_EQ) {
                 it = db.lower_bound(std::string((const char *) key.data(), prefix_len));
 
                 if (it != db.end()) {
@@ -300,21 +336,18 @@ Message::Response::BGetOp *Datastore::InMemory::BGetOpImpl(Message::Request::BGe
                 it = db.upper_bound(seek);
 
                 // go back one since the seek value is guaranteed to be past the last value found
-                if (it != db.end()) {
+                if (it != db.begin()) {
                     it--;
-                }
-                else {
-                    it = db.rbegin().base();
-                }
 
-                if (it != db.end()) {
                     // walk backwards to get values
                     for(std::size_t j = 0;
                         (j < req->num_recs[i]) &&
-                        (it != db.rend().base()) &&
                         (memcmp(key.data(), it->first.data(), prefix_len) == 0);
                         j++) {
                         this->template BGetOp_copy_response(callbacks, it->first, it->second, req, res, i, j, event);
+                        if (it == db.begin()) {
+                            break;
+                        }
                         it--;
                     }
                 }
@@ -346,7 +379,7 @@ Message::Response::BGetOp *Datastore::InMemory::BGetOpImpl(Message::Request::BGe
 
         event.count = res->num_recs[i];
         event.time.end = ::Stats::now();
-        stats.gets.emplace_back(event);
+        AddEvent(stats.gets, event);
     }
 
     return res;
@@ -366,6 +399,8 @@ Message::Response::BDelete *Datastore::InMemory::BDeleteImpl(Message::Request::B
 
     Message::Response::BDelete *res = construct<Message::Response::BDelete>(req->count);
 
+    std::string key; // reused by every DELETE in this packet
+
     for(std::size_t i = 0; i < req->count; i++) {
         void *subject = nullptr;
         std::size_t subject_len = 0;
@@ -376,19 +411,11 @@ Message::Response::BDelete *Datastore::InMemory::BDeleteImpl(Message::Request::B
         if ((encode(callbacks, req->subjects[i],   &subject,   &subject_len)   == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->predicates[i], &predicate, &predicate_len) == DATASTORE_SUCCESS)) {
             // create the key from the subject and predicate
-            Blob key;
             sp_to_key(ReferenceBlob(subject,   subject_len,   req->subjects[i].data_type()),
                       ReferenceBlob(predicate, predicate_len, req->predicates[i].data_type()),
-                      &key);
+                      key);
 
-            decltype(db)::const_iterator it = db.find((std::string) key);
-            if (it != db.end()) {
-                db.erase(it);
-                status = DATASTORE_SUCCESS;
-            }
-            else {
-                status = DATASTORE_ERROR;
-            }
+            status = db.erase(key)?DATASTORE_SUCCESS:DATASTORE_ERROR;
 
             event.size += key.size();
         }
@@ -408,7 +435,7 @@ Message::Response::BDelete *Datastore::InMemory::BDeleteImpl(Message::Request::B
     res->count = req->count;
 
     event.time.end = ::Stats::now();
-    stats.deletes.emplace_back(event);
+    AddEvent(stats.deletes, event);
 
     return res;
 }
@@ -431,7 +458,7 @@ int Datastore::InMemory::WriteHistogramsImpl() {
         hist.second->pack(&serial_hist, &serial_hist_len);
         ptrs.push_back(serial_hist);
 
-        db[key] = std::string((char *) serial_hist, serial_hist_len);
+        db.put(key, (char *) serial_hist, serial_hist_len);
     }
 
     for(void *ptr : ptrs) {
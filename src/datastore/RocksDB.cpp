@@ -56,6 +56,16 @@ bool Datastore::RocksDB::UsableImpl() const {
     return db;
 }
 
+/**
+ * ConcurrentWritesImpl
+ * RocksDB synchronizes its own reads and writes
+ *
+ * @return true
+ */
+bool Datastore::RocksDB::ConcurrentWritesImpl() const {
+    return true;
+}
+
 const std::string &Datastore::RocksDB::Name() const {
     return name;
 }
@@ -78,6 +88,11 @@ Message::Response::BPut *Datastore::RocksDB::BPutImpl(Message::Request::BPut *re
 
     // batch up PUTs
     ::rocksdb::WriteBatch batch;
+
+    // reused by every PUT in this packet since the batch copies them
+    std::string key;
+    std::string value;
+
     for(std::size_t i = 0; i < req->count; i++) {
         void *subject = nullptr;
         std::size_t subject_len = 0;
@@ -90,16 +105,14 @@ Message::Response::BPut *Datastore::RocksDB::BPutImpl(Message::Request::BPut *re
         if ((encode(callbacks, req->subjects[i],   &subject,   &subject_len)   == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->predicates[i], &predicate, &predicate_len) == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->objects[i],    &object,    &object_len)    == DATASTORE_SUCCESS)) {
-            // the current key address and length
-            Blob key;
             sp_to_key(ReferenceBlob(subject,   subject_len,   req->subjects[i].data_type()),
                       ReferenceBlob(predicate, predicate_len, req->predicates[i].data_type()),
-                      &key);
+                      key);
 
-            Blob value = append_type(object, object_len, req->objects[i].data_type());
+            append_type(object, object_len, req->objects[i].data_type(), value);
 
-            batch.Put(::rocksdb::Slice((char *) key.data(), key.size()),
-                      ::rocksdb::Slice((char *) value.data(), value.size()));
+            batch.Put(::rocksdb::Slice(key.data(), key.size()),
+                      ::rocksdb::Slice(value.data(), value.size()));
 
             event.size += key.size() + value.size();
             status = DATASTORE_UNSET;
@@ -122,13 +135,14 @@ Message::Response::BPut *Datastore::RocksDB::BPutImpl(Message::Request::BPut *re
     const int res_status = status.ok()?DATASTORE_SUCCESS:DATASTORE_ERROR;
 
     for(std::size_t i = 0; i < req->count; i++) {
+        // operations that failed before batching stay failed
         res->add(ReferenceBlob(req->orig.subjects[i], req->subjects[i].size(), req->subjects[i].data_type()),
                  ReferenceBlob(req->orig.predicates[i], req->predicates[i].size(), req->predicates[i].data_type()),
-                 res_status);
+                 (res->statuses[i] == DATASTORE_UNSET)?res_status:DATASTORE_ERROR);
     }
 
     event.time.end = ::Stats::now();
-    stats.puts.emplace_back(event);
+    AddEvent(stats.puts, event);
 
     mlog(ROCKSDB_INFO, "RocksDB BPut Completed");
     return res;
@@ -150,6 +164,10 @@ Message::Response::BGet *Datastore::RocksDB::BGetImpl(Message::Request::BGet *re
 
     Message::Response::BGet *res = construct<Message::Response::BGet>(req->count);
 
+    // reused by every GET in this packet
+    std::string key;
+    std::string value;
+
     // batch up GETs
     for(std::size_t i = 0; i < req->count; i++) {
         void *subject = nullptr;
@@ -164,14 +182,12 @@ Message::Response::BGet *Datastore::RocksDB::BGetImpl(Message::Request::BGet *re
         if ((encode(callbacks, req->subjects[i],   &subject,   &subject_len)   == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->predicates[i], &predicate, &predicate_len) == DATASTORE_SUCCESS)) {
             // create the key from the subject and predicate
-            Blob key;
             sp_to_key(ReferenceBlob(subject,   subject_len,   req->subjects[i].data_type()),
                       ReferenceBlob(predicate, predicate_len, req->predicates[i].data_type()),
-                      &key);
+                      key);
 
-            std::string value;
             ::rocksdb::Status s = db->Get(::rocksdb::ReadOptions(),
-                                          ::rocksdb::Slice((char *) key.data(), key.size()),
+                                          ::rocksdb::Slice(key.data(), key.size()),
                                           &value);
 
             if (s.ok()) {
@@ -210,7 +226,7 @@ Message::Response::BGet *Datastore::RocksDB::BGetImpl(Message::Request::BGet *re
     }
 
     event.time.end = ::Stats::now();
-    stats.gets.emplace_back(event);
+    AddEvent(stats.gets, event);
 
     mlog(ROCKSDB_INFO, "Rank %d RocksDB GET done processing %p", rank, req);
     return res;
@@ -240,8 +256,50 @@ Message::Response::BGetOp *Datastore::RocksDB::BGetOpImpl(Message::Request::BGet
 
         BGetOp_loop_init(req, res, i, subject, subject_len, predicate, predicate_len, key, prefix_len);
 
-        if (res->statuses[i] == DATASTORE_UNSET) {
-            if (req->ops[i] == hxhim_getop_t::HXHIM_GETOP_EQ) {
+        if (res->statuses[i] == DATASTORE_UrocksdbET) {
+            if ((req->ops[i] != hxhim_getop_t::HXHIM_GETOP_EQ) && req->cursors[i].size()) {
+                // continue after the last record of the previous chunk
+                const ::rocksdb::Slice cursor((char *) req->cursors[i].data(), req->cursors[i].size());
+
+                // LOWEST and HIGHEST stay within the original prefix
+                ::rocksdb::Slice prefix;
+                if ((req->ops[i] == hxhim_getop_t::HXHIM_GETOP_LOWEST) ||
+                    (req->ops[i] == hxhim_getop_t::HXHIM_GETOP_HIGHEST)) {
+                    prefix = ::rocksdb::Slice((char *) key.data(), prefix_len);
+                }
+
+                const bool forward = BGetOp_forward(req->ops[i]);
+
+                it->Seek(cursor);
+                if (forward) {
+                    if (it->Valid() && (it->key() == cursor)) {
+                        it->Next();
+                    }
+                }
+                else {
+                    if (it->Valid()) {
+                        it->Prev();
+                    }
+                    else {
+                        it->SeekToLast();
+                    }
+                }
+
+                for(std::size_t j = 0;
+                    (j < req->num_recs[i]) &&
+                    it->Valid() &&
+                    it->key().starts_with(prefix);
+                    j++) {
+                    this->template BGetOp_copy_response(callbacks, it->key(), it->value(), req, res, i, j, event);
+                    if (forward) {
+                        it->Next();
+                    }
+                    else {
+                        it->Prev();
+                    }
+                }
+            }
+            else if (req->ops[i] == hxhim_getop_t::HXHIM_GETOP_EQ) {
                 it->Seek(::rocksdb::Slice((char *) key.data(), prefix_len));
 
                 if (it->Valid()) {
@@ -388,7 +446,7 @@ Message::Response::BGetOp *Datastore::RocksDB::BGetOpImpl(Message::Request::BGet
 
         event.count = res->num_recs[i];
         event.time.end = ::Stats::now();
-        stats.gets.emplace_back(event);
+        AddEvent(stats.gets, event);
     }
 
     delete it;
@@ -412,6 +470,8 @@ Message::Response::BDelete *Datastore::RocksDB::BDeleteImpl(Message::Request::BD
 
     ::rocksdb::WriteBatch batch;
 
+    std::string key; // reused by every DELETE in this packet
+
     // batch delete
     for(std::size_t i = 0; i < req->count; i++) {
         void *subject = nullptr;
@@ -422,11 +482,10 @@ Message::Response::BDelete *Datastore::RocksDB::BDeleteImpl(Message::Request::BD
         if ((encode(callbacks, req->subjects[i],   &subject,   &subject_len)   == DATASTORE_SUCCESS) &&
             (encode(callbacks, req->predicates[i], &predicate, &predicate_len) == DATASTORE_SUCCESS)) {
             // create the key from the subject and predicate
-            Blob key;
             sp_to_key(ReferenceBlob(subject,   subject_len,   req->subjects[i].data_type()),
                       ReferenceBlob(predicate, predicate_len, req->predicates[i].data_type()),
-                      &key);
-            batch.Delete(::rocksdb::Slice((char *) key.data(), key.size()));
+                      key);
+            batch.Delete(::rocksdb::Slice(key.data(), key.size()));
             event.size += key.size();
         }
 
@@ -449,7 +508,7 @@ Message::Response::BDelete *Datastore::RocksDB::BDeleteImpl(Message::Request::BD
     }
 
     event.time.end = ::Stats::now();
-    stats.deletes.emplace_back(event);
+    AddEvent(stats.deletes, event);
 
     return res;
 }
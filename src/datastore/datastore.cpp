@@ -1,6 +1,13 @@
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
+#include <iterator>
+#include <list>
 #include <sstream>
+#include <vector>
 
 #include "datastore/datastore.hpp"
 #include "datastore/triplestore.hpp"
@@ -18,7 +25,12 @@ Datastore::Datastore::Datastore(const int rank,
       id(id),
       callbacks(callbacks),
       hists(),
-      mutex(),
+      getop_chunk(0),
+      rwlock(),
+      partials(),
+      partials_mutex(),
+      max_object_size(0),
+      partial_timeout(0),
       stats()
 {
     // default to basic callbacks
@@ -49,23 +61,13 @@ Datastore::Datastore::~Datastore() {
     destruct(callbacks);
     hists.clear();
 
-    long double put_time = 0;
-    std::size_t put_count = 0;
-    std::size_t put_size = 0;
-    for(Stats::Event const &event : stats.puts) {
-        put_time  += sec(event.time);
-        put_count += event.count;
-        put_size  += event.size;
-    }
+    const long double put_time = stats.puts.time() / 1e9;
+    const std::size_t put_count = stats.puts.count();
+    const std::size_t put_size = stats.puts.size();
 
-    long double get_time = 0;
-    std::size_t get_count = 0;
-    std::size_t get_size = 0;
-    for(Stats::Event const &event : stats.gets) {
-        get_time  += sec(event.time);
-        get_count += event.count;
-        get_size  += event.size;
-    }
+    const long double get_time = stats.gets.time() / 1e9;
+    const std::size_t get_count = stats.gets.count();
+    const std::size_t get_size = stats.gets.size();
 
     if (put_count) {
         mlog(DATASTORE_NOTE, "Rank %d Datastore %d: %zu PUTs (%zu bytes) in %.3Lf seconds (%.3Lf PUTs/sec, %s)", rank, id, put_count, put_size, put_time, put_count / put_time, hr_size(put_size, put_time).c_str());
@@ -81,6 +83,18 @@ Datastore::Datastore::~Datastore() {
         mlog(DATASTORE_NOTE, "Rank %d Datastore %d: %zu GETs (%zu bytes) in %.3Lf seconds", rank, id, get_count, get_size, get_time);
     }
 
+    const Stats::Op *ops[] = {&stats.puts, &stats.gets, &stats.getops, &stats.deletes};
+    const char *names[] = {"PUT", "GET", "GETOP", "DELETE"};
+    for(std::size_t i = 0; i < sizeof(ops) / sizeof(*ops); i++) {
+        if (ops[i]->events()) {
+            mlog(DATASTORE_NOTE, "Rank %d Datastore %d: %s latency p50 %" PRIu64 " ns, p99 %" PRIu64 " ns, max %" PRIu64 " ns",
+                 rank, id, names[i],
+                 ops[i]->latency.quantile(0.5),
+                 ops[i]->latency.quantile(0.99),
+                 ops[i]->latency.quantile(1));
+        }
+    }
+
     mlog(DATASTORE_INFO, "Rank %d Datastore shut down completed", rank);
 }
 
@@ -96,6 +110,13 @@ bool Datastore::Datastore::Open(const std::string &new_name,
 void Datastore::Datastore::Close(const bool write_histograms) {
     Sync(write_histograms);
     hists.clear();
+
+    {
+        // the remaining chunks cannot be written into this datastore
+        std::lock_guard<std::mutex> lock(partials_mutex);
+        partials.clear();
+    }
+
     CloseImpl();
 }
 
@@ -114,9 +135,38 @@ int Datastore::Datastore::ID() const {
     return id;
 }
 
+void Datastore::Datastore::SetGetOpChunk(const std::size_t records) {
+    std::lock_guard<RWLock> lock(rwlock);
+    getop_chunk = records;
+}
+
+void Datastore::Datastore::SetMaxObjectSize(const std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(partials_mutex);
+    max_object_size = bytes;
+}
+
+void Datastore::Datastore::SetPartialTimeout(const std::size_t milliseconds) {
+    std::lock_guard<std::mutex> lock(partials_mutex);
+    partial_timeout = milliseconds;
+}
+
+/**
+ * operate
+ * PUTs only take the datastore exclusively if the
+ * underlying datastore cannot handle concurrent writes.
+ *
+ * @param req  the packet requesting multiple PUTs
+ * @return pointer to a list of results
+ */
 Message::Response::BPut *Datastore::Datastore::operate(Message::Request::BPut *req) {
-    std::lock_guard<std::mutex> lock(mutex);
-    Message::Response::BPut *res = Usable()?BPutImpl(req):nullptr;
+    RWLock::Guard lock(rwlock, ConcurrentWritesImpl()?RWLock::SHARED:RWLock::EXCLUSIVE);
+
+    bool chunked = false;
+    for(std::size_t i = 0; !chunked && (i < req->count); i++) {
+        chunked = req->chunks[i].id;
+    }
+
+    Message::Response::BPut *res = Usable()?(chunked?BPutChunks(req):BPutImpl(req)):nullptr;
 
     if (hists.size() && res) {
         // if a predicate is HXHIM_DATA_BYTE and the PUT was successful
@@ -156,26 +206,252 @@ Message::Response::BPut *Datastore::Datastore::operate(Message::Request::BPut *r
     return res;
 }
 
+/**
+ * BPutChunks
+ * Only whole objects are passed to BPutImpl, so each
+ * object is written once no matter how many chunks it
+ * was split into or what order the chunks arrive in.
+ * Chunks that do not complete their objects are
+ * reported with DATASTORE_PARTIAL, which clients do
+ * not turn into results, so each object still only
+ * has one result.
+ *
+ * @param req  the packet requesting multiple PUTs, some of which are chunks
+ * @return pointer to a list of results
+ */
+Message::Response::BPut *Datastore::Datastore::BPutChunks(Message::Request::BPut *req) {
+    // DATASTORE_UNSET means that the PUT was passed to BPutImpl
+    std::vector<int> statuses(req->count, DATASTORE_UNSET);
+
+    // the completed objects, which must outlive whole
+    std::list<std::string> objects;
+
+    Message::Request::BPut whole(req->count);
+    for(std::size_t i = 0; i < req->count; i++) {
+        Blob object = ReferenceBlob(req->objects[i].data(), req->objects[i].size(), req->objects[i].data_type());
+
+        if (req->chunks[i].id) {
+            objects.emplace_back();
+            const int status = assemble(req->chunks[i], req->objects[i], objects.back());
+            if (status != DATASTORE_SUCCESS) {
+                statuses[i] = status;
+                objects.pop_back();
+                continue;
+            }
+
+            object = ReferenceBlob(&objects.back()[0], objects.back().size(), req->objects[i].data_type());
+        }
+
+        whole.add(ReferenceBlob(req->subjects[i].data(), req->subjects[i].size(), req->subjects[i].data_type()),
+                  ReferenceBlob(req->predicates[i].data(), req->predicates[i].size(), req->predicates[i].data_type()),
+                  object);
+
+        // responses go back to the addresses the client sent
+        whole.orig.subjects[whole.count - 1]   = req->orig.subjects[i];
+        whole.orig.predicates[whole.count - 1] = req->orig.predicates[i];
+    }
+
+    Message::Response::BPut *written = whole.count?BPutImpl(&whole):nullptr;
+
+    // merge the held chunks back in so that responses correspond to requests
+    Message::Response::BPut *res = construct<Message::Response::BPut>(req->count);
+    for(std::size_t i = 0, j = 0; i < req->count; i++) {
+        if ((statuses[i] == DATASTORE_UNSET) && written && (j < written->count)) {
+            res->steal(written, j++);
+            continue;
+        }
+
+        res->add(ReferenceBlob(req->orig.subjects[i], req->subjects[i].size(), req->subjects[i].data_type()),
+                 ReferenceBlob(req->orig.predicates[i], req->predicates[i].size(), req->predicates[i].data_type()),
+                 (statuses[i] == DATASTORE_UNSET)?DATASTORE_ERROR:statuses[i]);
+    }
+
+    destruct(written);
+
+    return res;
+}
+
+/**
+ * assemble
+ * Copies a chunk into the object it belongs to. The
+ * first chunk of an object to arrive allocates the full
+ * object, and the chunk that fills in the last of the
+ * missing bytes removes it from the partial objects.
+ * Duplicate and overlapping chunks do not count twice.
+ *
+ * Objects larger than max_object_size are not allocated.
+ * The chunk at the start of the object reports the error
+ * and the other chunks are dropped, so the object still
+ * only has one result.
+ *
+ * @param chunk   where the chunk belongs
+ * @param piece   the bytes of the chunk
+ * @param object  the full object, once all of its chunks have arrived
+ * @return DATASTORE_PARTIAL if there are chunks that have not arrived,
+ *         DATASTORE_SUCCESS if object was filled in, or DATASTORE_ERROR
+ */
+int Datastore::Datastore::assemble(const Message::Request::BPut::Chunk &chunk, const Blob &piece, std::string &object) {
+    std::lock_guard<std::mutex> lock(partials_mutex);
+
+    const ::Stats::Chronopoint now = ::Stats::now();
+    expire_partials(now);
+
+    if (max_object_size && (chunk.total > max_object_size)) {
+        mlog(DATASTORE_WARN, "Rank %d Datastore %d: object of chunk %" PRIu64 " is too large (%zu > %zu bytes)",
+             rank, id, chunk.id, chunk.total, max_object_size);
+        return chunk.offset?DATASTORE_PARTIAL:DATASTORE_ERROR;
+    }
+
+    REF(partials)::iterator it = partials.find(chunk.id);
+    if (it == partials.end()) {
+        Partial partial;
+        partial.object.resize(chunk.total);
+        partial.failed = false;
+        it = partials.emplace(chunk.id, std::move(partial)).first;
+    }
+
+    Partial &partial = it->second;
+    partial.updated = now;
+
+    if ((chunk.total != partial.object.size()) ||
+        (chunk.offset > partial.object.size()) ||
+        (piece.size() > partial.object.size() - chunk.offset)) {
+        // the bytes are not recorded, so the object
+        // only completes if other chunks cover them
+        partial.failed = true;
+    }
+    else if (piece.size()) {
+        memcpy(&partial.object[chunk.offset], piece.data(), piece.size());
+
+        // merge the new range with the ranges it overlaps or touches
+        std::size_t start = chunk.offset;
+        std::size_t end = chunk.offset + piece.size();
+
+        REF(partial.received)::iterator range = partial.received.upper_bound(start);
+        if (range != partial.received.begin()) {
+            REF(partial.received)::iterator prev = std::prev(range);
+            if (prev->second >= start) {
+                range = prev;
+            }
+        }
+
+        while ((range != partial.received.end()) && (range->first <= end)) {
+            start = std::min(start, range->first);
+            end = std::max(end, range->second);
+            range = partial.received.erase(range);
+        }
+
+        partial.received.emplace(start, end);
+    }
+
+    // complete once a single range covers the entire object
+    const bool complete = partial.object.empty() ||
+        ((partial.received.size() == 1) &&
+         (partial.received.begin()->first == 0) &&
+         (partial.received.begin()->second == partial.object.size()));
+    if (!complete) {
+        return DATASTORE_PARTIAL;
+    }
+
+    const int status = partial.failed?DATASTORE_ERROR:DATASTORE_SUCCESS;
+    object = std::move(partial.object);
+    partials.erase(it);
+
+    return status;
+}
+
+/**
+ * expire_partials
+ * Drops the objects that have not received a chunk in
+ * partial_timeout milliseconds, such as when a client
+ * stopped sending partway through an object. The
+ * dropped objects do not generate results.
+ * partials_mutex must be locked by the caller.
+ *
+ * @param now  the current time
+ */
+void Datastore::Datastore::expire_partials(const ::Stats::Chronopoint &now) {
+    if (!partial_timeout) {
+        return;
+    }
+
+    const std::chrono::milliseconds timeout(partial_timeout);
+    for(REF(partials)::iterator it = partials.begin(); it != partials.end();) {
+        if ((now - it->second.updated) > timeout) {
+            mlog(DATASTORE_WARN, "Rank %d Datastore %d: dropping incomplete object of chunk %" PRIu64,
+                 rank, id, it->first);
+            it = partials.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
 Message::Response::BGet *Datastore::Datastore::operate(Message::Request::BGet *req) {
-    std::lock_guard<std::mutex> lock(mutex);
+    RWLock::Guard lock(rwlock, RWLock::SHARED);
     return Usable()?BGetImpl(req):nullptr;
 }
 
+/**
+ * operate
+ * GETOPs return at most getop_chunk records at a time.
+ * Ops that are cut off return their original arguments
+ * and the key of their last record so that the client
+ * can request the next chunk, which continues after it.
+ *
+ * @param req  the packet requesting multiple GETOPs
+ * @return pointer to a list of results
+ */
 Message::Response::BGetOp *Datastore::Datastore::operate(Message::Request::BGetOp *req) {
-    std::lock_guard<std::mutex> lock(mutex);
-    return Usable()?BGetOpImpl(req):nullptr;
+    RWLock::Guard lock(rwlock, RWLock::SHARED);
+    if (!Usable()) {
+        return nullptr;
+    }
+
+    if (!getop_chunk) {
+        return BGetOpImpl(req);
+    }
+
+    // only get one chunk of each op
+    std::vector<std::size_t> wanted(req->num_recs, req->num_recs + req->count);
+    for(std::size_t i = 0; i < req->count; i++) {
+        req->num_recs[i] = std::min(wanted[i], getop_chunk);
+    }
+
+    Message::Response::BGetOp *res = BGetOpImpl(req);
+
+    for(std::size_t i = 0; res && (i < res->count); i++) {
+        if ((req->ops[i] != hxhim_getop_t::HXHIM_GETOP_EQ) &&
+            (res->statuses[i] == DATASTORE_SUCCESS)        &&
+            (res->num_recs[i] < wanted[i])                 &&
+            res->rest.cursors[i].size()) {
+            res->set_rest(i,
+                          std::move(req->subjects[i]),
+                          std::move(req->predicates[i]),
+                          req->object_types[i],
+                          wanted[i] - res->num_recs[i],
+                          req->ops[i],
+                          std::move(res->rest.cursors[i]));
+        }
+
+        req->num_recs[i] = wanted[i];
+    }
+
+    return res;
 }
 
 Message::Response::BDelete *Datastore::Datastore::operate(Message::Request::BDelete *req) {
-    std::lock_guard<std::mutex> lock(mutex);
+    RWLock::Guard lock(rwlock, ConcurrentWritesImpl()?RWLock::SHARED:RWLock::EXCLUSIVE);
     return Usable()?BDeleteImpl(req):nullptr;
 }
 
 Message::Response::BHistogram *Datastore::Datastore::operate(Message::Request::BHistogram *req) {
     /**
      * handle histograms right here because it is datastore agnostic
+     * the histograms synchronize themselves, so only the map is read
      */
-    std::lock_guard<std::mutex> lock(mutex);
+    RWLock::Guard lock(rwlock, RWLock::SHARED);
 
     Datastore::Stats::Event event;
     event.time.start = ::Stats::now();
@@ -202,7 +478,7 @@ Message::Response::BHistogram *Datastore::Datastore::operate(Message::Request::B
     }
 
     event.time.end = ::Stats::now();
-    stats.gets.emplace_back(event);
+    AddEvent(stats.gets, event);
 
     return res;
 }
@@ -339,77 +615,127 @@ int Datastore::Datastore::GetStats(uint64_t *put_time,
                                    std::size_t  *num_put,
                                    uint64_t *get_time,
                                    std::size_t  *num_get) {
-    std::lock_guard<std::mutex> lock(mutex);
-
     if (put_time) {
-        *put_time = 0;
-        for(Stats::Event const &event : stats.puts) {
-            *put_time += nano(event.time);
-        }
+        *put_time = stats.puts.time();
     }
 
     if (num_put) {
-        *num_put = stats.puts.size();
+        *num_put = stats.puts.events();
     }
 
     if (get_time) {
-        *get_time = 0;
-        for(Stats::Event const &event : stats.gets) {
-            *get_time += nano(event.time);
-        }
+        *get_time = stats.gets.time();
     }
 
     if (num_get) {
-        *num_get = stats.gets.size();
+        *num_get = stats.gets.events();
     }
 
     return DATASTORE_SUCCESS;
 }
 
+/**
+ * GetStats
+ *
+ * @param op   the operation type
+ * @return the statistics of the operation type, or nullptr
+ */
+const Datastore::Datastore::Stats::Op *Datastore::Datastore::GetStats(const hxhim_op_t op) const {
+    switch (op) {
+        case HXHIM_PUT:
+            return &stats.puts;
+        case HXHIM_GET:
+            return &stats.gets;
+        case HXHIM_GETOP:
+            return &stats.getops;
+        case HXHIM_DELETE:
+            return &stats.deletes;
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
 int Datastore::Datastore::Sync(const bool write_histograms) {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<RWLock> lock(rwlock);
     if (write_histograms) {
         WriteHistograms();
     }
     return Usable()?SyncImpl():DATASTORE_ERROR;
 }
 
+/**
+ * AddEvent
+ * Operations that share the datastore
+ * record their events at the same time
+ *
+ * @param op     the statistics to add to
+ * @param event  the event
+ */
+void Datastore::Datastore::AddEvent(Stats::Op &op, const Stats::Event &event) {
+    op.add(event);
+}
+
+/**
+ * encode
+ * Data types without an encoding function are not
+ * copied. *dst is set to the source pointer, so
+ * callers should only deallocate *dst if it is
+ * different from src.data().
+ *
+ * @param callbacks  the transform callbacks
+ * @param src        the data to encode
+ * @param dst        the encoded data
+ * @param dst_size   the size of the encoded data
+ * @return DATASTORE_SUCCESS or DATASTORE_ERROR
+ */
 int Datastore::Datastore::encode(Transform::Callbacks *callbacks,
                                  const Blob &src,
                                  void **dst, std::size_t *dst_size) {
-    REF(callbacks->encode)::const_iterator it = callbacks->encode.find(src.data_type());
-    if (it == callbacks->encode.end()) {
+    const Transform::Callbacks::Encode *callback = callbacks->get_encode(src.data_type());
+    if (!callback) {
         return DATASTORE_ERROR;
     }
 
-    // not found - just copy
-    if (!it->second.first) {
+    // no transform - pass the original data through
+    if (!callback->func) {
+        *dst = src.data();
         *dst_size = src.size();
-        *dst = alloc(*dst_size);
-        memcpy(*dst, src.data(), src.size());
         return DATASTORE_SUCCESS;
     }
 
-    return it->second.first(src.data(), src.size(), dst, dst_size, it->second.second);
+    return callback->func(src.data(), src.size(), dst, dst_size, callback->extra);
 }
 
+/**
+ * decode
+ * The source data usually belongs to the underlying
+ * datastore, so *dst is always a new allocation.
+ *
+ * @param callbacks  the transform callbacks
+ * @param src        the data to decode
+ * @param dst        the decoded data
+ * @param dst_size   the size of the decoded data
+ * @return DATASTORE_SUCCESS or DATASTORE_ERROR
+ */
 int Datastore::Datastore::decode(Transform::Callbacks *callbacks,
                                  const Blob &src,
                                  void **dst, std::size_t *dst_size) {
-    REF(callbacks->decode)::const_iterator it = callbacks->decode.find(src.data_type());
-    if (it == callbacks->decode.end()) {
+    const Transform::Callbacks::Decode *callback = callbacks->get_decode(src.data_type());
+    if (!callback) {
         return DATASTORE_ERROR;
     }
 
-    // not found - just copy
-    if (!it->second.first) {
+    // no transform - just copy
+    if (!callback->func) {
         *dst_size = src.size();
         *dst = alloc(*dst_size);
         memcpy(*dst, src.data(), src.size());
         return DATASTORE_SUCCESS;
     }
 
-    return it->second.first(src.data(), src.size(), dst, dst_size, it->second.second);
+    return callback->func(src.data(), src.size(), dst, dst_size, callback->extra);
 }
 
 Datastore::Datastore::Stats::Event::Event()
@@ -418,6 +744,34 @@ Datastore::Datastore::Stats::Event::Event()
       size(0)
 {}
 
+Datastore::Datastore::Stats::Op::Op()
+    : latency(),
+      sizes(),
+      count_(0)
+{}
+
+void Datastore::Datastore::Stats::Op::add(const Event &event) {
+    latency.add(nano(event.time));
+    sizes.add(event.size);
+    count_.fetch_add(event.count, std::memory_order_relaxed);
+}
+
+uint64_t Datastore::Datastore::Stats::Op::events() const {
+    return latency.count();
+}
+
+uint64_t Datastore::Datastore::Stats::Op::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t Datastore::Datastore::Stats::Op::size() const {
+    return sizes.sum();
+}
+
+uint64_t Datastore::Datastore::Stats::Op::time() const {
+    return latency.sum();
+}
+
 Blob Datastore::Datastore::append_type(void *ptr, std::size_t size, hxhim_data_t type) {
     std::size_t new_size = size + sizeof(type);
     void *out = alloc(new_size);
@@ -431,6 +785,22 @@ Blob Datastore::Datastore::append_type(void *ptr, std::size_t size, hxhim_data_t
     return std::move(RealBlob(out, new_size, hxhim_data_t::HXHIM_DATA_BYTE));
 }
 
+/**
+ * append_type
+ * Overwrites the contents of a string with the
+ * value and its type so that the same string
+ * can be reused for every value in a packet.
+ *
+ * @param ptr    the value
+ * @param size   the length of the value
+ * @param type   the type of the value
+ * @param value  the value with its type appended
+ */
+void Datastore::Datastore::append_type(void *ptr, std::size_t size, hxhim_data_t type, std::string &value) {
+    value.assign((char *) ptr, size);
+    value.append((char *) &type, sizeof(type));
+}
+
 hxhim_data_t Datastore::Datastore::remove_type(const void *ptr, std::size_t &size) {
     hxhim_data_t type;
     char *curr = (char *) ptr;
@@ -490,6 +860,12 @@ void Datastore::Datastore::BGetOp_loop_init(Message::Request::BGetOp *req,
     }
 }
 
+bool Datastore::Datastore::BGetOp_forward(const hxhim_getop_t op) {
+    return ((op == hxhim_getop_t::HXHIM_GETOP_NEXT)  ||
+            (op == hxhim_getop_t::HXHIM_GETOP_FIRST) ||
+            (op == hxhim_getop_t::HXHIM_GETOP_LOWEST));
+}
+
 std::string Datastore::Datastore::BGetOp_get_seek(const Blob &key,
                                                   std::size_t prefix_len,
                                                   std::size_t predicate_len,
@@ -96,6 +96,10 @@ Datastore::Init(hxhim_t *hx,
         return nullptr;
     }
 
+    ds->SetGetOpChunk(hx->p->range_server.getop_chunk);
+    ds->SetMaxObjectSize(hx->p->range_server.partials.max_size);
+    ds->SetPartialTimeout(hx->p->range_server.partials.timeout);
+
     // need to explicitly open the datastore
     if (do_open) {
         bool open_rc = false;
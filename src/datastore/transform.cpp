@@ -2,6 +2,7 @@
 
 #include "datastore/transform.h"
 #include "datastore/transform.hpp"
+#include "utils/macros.hpp"
 #include "utils/elen.hpp"
 #include "utils/memory.hpp"
 
@@ -12,50 +13,63 @@ Datastore::Transform::NumericExtra::NumericExtra()
       double_precision(elen::encode::DOUBLE_PRECISION)
 {}
 
+void Datastore::Transform::Callbacks::set_encode(const hxhim_data_t type, const Encode &callback) {
+    if (type < HXHIM_DATA_MAX_KNOWN) {
+        encode[type] = callback;
+    }
+    else {
+        other_encode[type] = callback;
+    }
+}
+
+void Datastore::Transform::Callbacks::set_decode(const hxhim_data_t type, const Decode &callback) {
+    if (type < HXHIM_DATA_MAX_KNOWN) {
+        decode[type] = callback;
+    }
+    else {
+        other_decode[type] = callback;
+    }
+}
+
+const Datastore::Transform::Callbacks::Encode *Datastore::Transform::Callbacks::get_encode(const hxhim_data_t type) const {
+    if (type < HXHIM_DATA_MAX_KNOWN) {
+        return encode[type].set?&encode[type]:nullptr;
+    }
+
+    REF(other_encode)::const_iterator it = other_encode.find(type);
+    return (it != other_encode.end())?&it->second:nullptr;
+}
+
+const Datastore::Transform::Callbacks::Decode *Datastore::Transform::Callbacks::get_decode(const hxhim_data_t type) const {
+    if (type < HXHIM_DATA_MAX_KNOWN) {
+        return decode[type].set?&decode[type]:nullptr;
+    }
+
+    REF(other_decode)::const_iterator it = other_decode.find(type);
+    return (it != other_decode.end())?&it->second:nullptr;
+}
+
 Datastore::Transform::Callbacks *Datastore::Transform::default_callbacks() {
     Callbacks *callbacks = construct<Callbacks>();
+    void *extra = &callbacks->numeric_extra;
+
+    callbacks->set_encode(HXHIM_DATA_INT32,   Callbacks::Encode(encode::integers<int32_t>,        extra, true));
+    callbacks->set_encode(HXHIM_DATA_INT64,   Callbacks::Encode(encode::integers<int64_t>,        extra, true));
+    callbacks->set_encode(HXHIM_DATA_UINT32,  Callbacks::Encode(encode::integers<uint32_t>,       extra, true));
+    callbacks->set_encode(HXHIM_DATA_UINT64,  Callbacks::Encode(encode::integers<uint64_t>,       extra, true));
+    callbacks->set_encode(HXHIM_DATA_FLOAT,   Callbacks::Encode(encode::floating_point<float>,    extra, true));
+    callbacks->set_encode(HXHIM_DATA_DOUBLE,  Callbacks::Encode(encode::floating_point<double>,   extra, true));
+    callbacks->set_encode(HXHIM_DATA_BYTE,    Callbacks::Encode(nullptr, nullptr, true));
+    callbacks->set_encode(HXHIM_DATA_POINTER, Callbacks::Encode(nullptr, nullptr, true));
 
-    callbacks->encode.emplace(HXHIM_DATA_INT32,
-                               std::make_pair(encode::integers<int32_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->encode.emplace(HXHIM_DATA_INT64,
-                               std::make_pair(encode::integers<int64_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->encode.emplace(HXHIM_DATA_UINT32,
-                               std::make_pair(encode::integers<uint32_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->encode.emplace(HXHIM_DATA_UINT64,
-                               std::make_pair(encode::integers<uint64_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->encode.emplace(HXHIM_DATA_FLOAT,
-                               std::make_pair(encode::floating_point<float>,
-                                              &callbacks->numeric_extra));
-    callbacks->encode.emplace(HXHIM_DATA_DOUBLE,
-                               std::make_pair(encode::floating_point<double>,
-                                              &callbacks->numeric_extra));
-    callbacks->encode.emplace(HXHIM_DATA_BYTE,    std::make_pair(nullptr, nullptr));
-    callbacks->encode.emplace(HXHIM_DATA_POINTER, std::make_pair(nullptr, nullptr));
-
-    callbacks->decode.emplace(HXHIM_DATA_INT32,
-                               std::make_pair(decode::integers<int32_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->decode.emplace(HXHIM_DATA_INT64,
-                               std::make_pair(decode::integers<int64_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->decode.emplace(HXHIM_DATA_UINT32,
-                               std::make_pair(decode::integers<uint32_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->decode.emplace(HXHIM_DATA_UINT64,
-                               std::make_pair(decode::integers<uint64_t>,
-                                              &callbacks->numeric_extra));
-    callbacks->decode.emplace(HXHIM_DATA_FLOAT,
-                               std::make_pair(decode::floating_point<float>,
-                                              &callbacks->numeric_extra));
-    callbacks->decode.emplace(HXHIM_DATA_DOUBLE,
-                               std::make_pair(decode::floating_point<double>,
-                                              &callbacks->numeric_extra));
-    callbacks->decode.emplace(HXHIM_DATA_BYTE,    std::make_pair(nullptr, nullptr));
-    callbacks->decode.emplace(HXHIM_DATA_POINTER, std::make_pair(nullptr, nullptr));
+    callbacks->set_decode(HXHIM_DATA_INT32,   Callbacks::Decode(decode::integers<int32_t>,        extra, true));
+    callbacks->set_decode(HXHIM_DATA_INT64,   Callbacks::Decode(decode::integers<int64_t>,        extra, true));
+    callbacks->set_decode(HXHIM_DATA_UINT32,  Callbacks::Decode(decode::integers<uint32_t>,       extra, true));
+    callbacks->set_decode(HXHIM_DATA_UINT64,  Callbacks::Decode(decode::integers<uint64_t>,       extra, true));
+    callbacks->set_decode(HXHIM_DATA_FLOAT,   Callbacks::Decode(decode::floating_point<float>,    extra, true));
+    callbacks->set_decode(HXHIM_DATA_DOUBLE,  Callbacks::Decode(decode::floating_point<double>,   extra, true));
+    callbacks->set_decode(HXHIM_DATA_BYTE,    Callbacks::Decode(nullptr, nullptr, true));
+    callbacks->set_decode(HXHIM_DATA_POINTER, Callbacks::Decode(nullptr, nullptr, true));
 
     return callbacks;
 }
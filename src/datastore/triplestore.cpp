@@ -6,31 +6,37 @@
 #include "utils/memory.hpp"
 
 /**
- * sp_to_key
- * Combines a subject and a predicate to form a key.
- * The buffer to store the key should be allocated
- * by the caller.
+ * sp_to_key_size
+ *
+ * @param subject        the subject of the triple
+ * @param predicate      the predicate of the triple
+ * @return the length of the key formed by sp_to_key
+ */
+std::size_t sp_to_key_size(const Blob &subject,
+                           const Blob &predicate) {
+    // add 1 to both for types
+    return subject.pack_size(false) +
+           predicate.pack_size(false) +
+           3 * sizeof(uint8_t);
+}
+
+/**
+ * sp_to_key_write
+ * Writes the key into a buffer that is
+ * at least sp_to_key_size bytes long.
  *
  * subject + predicate + '\xff' + subject len + predicate_len + subject type + predicate type
  *
  * The '\xff' terminates the key when one subject + predicate
  * is a prefix of another subject + predicate
  *
- *
  * @param subject        the subject of the triple
  * @param predicate      the predicate of the triple
- * @param key            the formatted key - will be filled in
- * @return HXHIM_SUCCESS or HXHIM_ERROR
+ * @param buf            the buffer to write the key into
  */
-int sp_to_key(const Blob &subject,
-              const Blob &predicate,
-              Blob *key) {
-    // add 1 to both for types
-    const std::size_t len = subject.pack_size(false) +
-                            predicate.pack_size(false) +
-                            3 * sizeof(uint8_t);
-
-    char *buf = (char *) alloc(len);
+static void sp_to_key_write(const Blob &subject,
+                            const Blob &predicate,
+                            char *buf) {
     char *curr = buf;
 
     // copy the subject value
@@ -60,12 +66,51 @@ int sp_to_key(const Blob &subject,
     // the predicate type
     *curr = predicate.data_type();
     curr += sizeof(uint8_t);
+}
+
+/**
+ * sp_to_key
+ * Combines a subject and a predicate to form a key.
+ * The key is placed into a new buffer.
+ *
+ * @param subject        the subject of the triple
+ * @param predicate      the predicate of the triple
+ * @param key            the formatted key - will be filled in
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int sp_to_key(const Blob &subject,
+              const Blob &predicate,
+              Blob *key) {
+    const std::size_t len = sp_to_key_size(subject, predicate);
+    char *buf = (char *) alloc(len);
+    sp_to_key_write(subject, predicate, buf);
 
     *key = std::move(RealBlob(buf, len, hxhim_data_t::HXHIM_DATA_BYTE));
 
     return HXHIM_SUCCESS;
 }
 
+/**
+ * sp_to_key
+ * Combines a subject and a predicate to form a key.
+ * The key overwrites the contents of a string, so
+ * reusing the same string for many keys only
+ * allocates when a key is longer than all of the
+ * previous keys.
+ *
+ * @param subject        the subject of the triple
+ * @param predicate      the predicate of the triple
+ * @param key            the formatted key - will be overwritten
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int sp_to_key(const Blob &subject,
+              const Blob &predicate,
+              std::string &key) {
+    key.resize(sp_to_key_size(subject, predicate));
+    sp_to_key_write(subject, predicate, &key[0]);
+    return HXHIM_SUCCESS;
+}
+
 /**
  * key_to_sp
  * Splits a key into a subject key pair.
@@ -138,6 +138,12 @@ hxhim::Result::Result *hxhim::Result::init(hxhim_t *hx, Message::Response::Respo
             break;
     }
 
+    // GETOPs that found no records and chunks of
+    // objects that are not complete have no results
+    if (!ret) {
+        return nullptr;
+    }
+
     // set timestamps
     if (i == 0) {
         ret->timestamps.alloc = construct<::Stats::Chronostamp>(res->timestamps.allocate);
@@ -153,6 +159,11 @@ hxhim::Result::Result *hxhim::Result::init(hxhim_t *hx, Message::Response::Respo
 }
 
 hxhim::Result::Put *hxhim::Result::init(hxhim_t *hx, Message::Response::BPut *bput, const std::size_t i) {
+    // only the last chunk of an object to arrive reports the status of the PUT
+    if (bput->statuses[i] == DATASTORE_PARTIAL) {
+        return nullptr;
+    }
+
     hxhim::Result::Put *out = construct<hxhim::Result::Put>(hx, bput->src, bput->statuses[i]);
 
     out->subject = std::move(bput->orig.subjects[i]);
@@ -177,6 +188,12 @@ hxhim::Result::Get *hxhim::Result::init(hxhim_t *hx, Message::Response::BGet *bg
 hxhim::Result::GetOp *hxhim::Result::init(hxhim_t *hx, Message::Response::BGetOp *bgetop, const std::size_t i) {
     const int status = bgetop->statuses[i];
 
+    // GETOPs can succeed without finding any records,
+    // such as when the previous chunk ended at the last record
+    if (!bgetop->num_recs[i]) {
+        return nullptr;
+    }
+
     hxhim::Result::GetOp *top = construct<hxhim::Result::GetOp>(hx, bgetop->src, status);
 
     hxhim::Result::GetOp *prev = nullptr;
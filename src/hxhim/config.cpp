@@ -7,6 +7,10 @@
 #include "hxhim/constants.h"
 #include "hxhim/options.hpp"
 #include "hxhim/private/hxhim.hpp"
+#include "transport/backend/SIM/Options.hpp"
+#if HXHIM_HAVE_THALLIUM
+#include "transport/backend/Thallium/Options.hpp"
+#endif
 #include "utils/Histogram.hpp"
 #include "utils/type_traits.hpp"
 
@@ -180,10 +184,67 @@ static bool parse_transport(hxhim_t *hx, const Config::Config &config) {
                         return false;
                     }
 
-                    return ((hxhim_set_transport_mpi(hx, listeners) == HXHIM_SUCCESS) &&
+                    std::size_t ingest_window = 0;
+                    if (Config::get_value(config, hxhim::config::MPI_INGEST_WINDOW, ingest_window) == Config::ERROR) {
+                        return false;
+                    }
+
+                    return ((hxhim_set_transport_mpi_ingest(hx, listeners, ingest_window) == HXHIM_SUCCESS) &&
+                           parse_hash(hx, config));
+                }
+                break;
+            case Transport::TRANSPORT_SHM:
+                {
+                    std::size_t ring_size;
+                    if (Config::get_value(config, hxhim::config::SHM_RING_SIZE, ring_size) != Config::FOUND) {
+                        return false;
+                    }
+
+                    std::size_t listeners;
+                    if (Config::get_value(config, hxhim::config::MPI_LISTENERS, listeners) != Config::FOUND) {
+                        return false;
+                    }
+
+                    return ((hxhim_set_transport_shm(hx, ring_size, listeners) == HXHIM_SUCCESS) &&
                            parse_hash(hx, config));
                 }
                 break;
+            case Transport::TRANSPORT_SIM:
+                {
+                    std::size_t ranks;
+                    if (Config::get_value(config, hxhim::config::SIM_RANKS, ranks) != Config::FOUND) {
+                        return false;
+                    }
+
+                    std::size_t latency = Transport::SIM::Options::DEFAULT_LATENCY;
+                    if (Config::get_value(config, hxhim::config::SIM_LATENCY, latency) == Config::ERROR) {
+                        return false;
+                    }
+
+                    std::size_t bandwidth = Transport::SIM::Options::DEFAULT_BANDWIDTH;
+                    if (Config::get_value(config, hxhim::config::SIM_BANDWIDTH, bandwidth) == Config::ERROR) {
+                        return false;
+                    }
+
+                    std::size_t jitter = Transport::SIM::Options::DEFAULT_JITTER;
+                    if (Config::get_value(config, hxhim::config::SIM_JITTER, jitter) == Config::ERROR) {
+                        return false;
+                    }
+
+                    std::size_t workers = Transport::SIM::Options::DEFAULT_WORKERS;
+                    if (Config::get_value(config, hxhim::config::SIM_WORKERS, workers) == Config::ERROR) {
+                        return false;
+                    }
+
+                    std::size_t seed = Transport::SIM::Options::DEFAULT_SEED;
+                    if (Config::get_value(config, hxhim::config::SIM_SEED, seed) == Config::ERROR) {
+                        return false;
+                    }
+
+                    return ((hxhim_set_transport_sim(hx, ranks, latency, bandwidth, jitter, workers, seed) == HXHIM_SUCCESS) &&
+                            parse_hash(hx, config));
+                }
+                break;
             #if HXHIM_HAVE_THALLIUM
             case Transport::TRANSPORT_THALLIUM:
                 {
@@ -204,9 +265,21 @@ static bool parse_transport(hxhim_t *hx, const Config::Config &config) {
                         thread_count = -1;
                     }
 
+                    std::size_t eager_size = Transport::Thallium::Options::DEFAULT_EAGER_SIZE;
+                    if (Config::get_value(config, hxhim::config::THALLIUM_EAGER_SIZE, eager_size) == Config::ERROR) {
+                        return false;
+                    }
+
+                    std::size_t xstreams = Transport::Thallium::Options::DEFAULT_XSTREAMS_PER_DATASTORE;
+                    if (Config::get_value(config, hxhim::config::THALLIUM_DATASTORE_XSTREAMS, xstreams) == Config::ERROR) {
+                        return false;
+                    }
+
                     return ((hxhim_set_transport_thallium(hx,
                                                           thallium_module->second,
-                                                          thread_count) == HXHIM_SUCCESS) &&
+                                                          thread_count,
+                                                          eager_size,
+                                                          xstreams) == HXHIM_SUCCESS) &&
                             parse_hash(hx, config));
                 }
                 break;
@@ -224,24 +297,19 @@ static bool parse_endpointgroup(hxhim_t *hx, const Config::Config &config) {
     if (endpointgroup != config.end()) {
         hxhim_clear_endpoint_group(hx);
         if (endpointgroup->second == "ALL") {
-            int size = -1;
-            if (MPI_Comm_size(hx->p->bootstrap.comm, &size) != MPI_SUCCESS) {
-                return false;
-            }
-
-            for(int rank = 0; rank < size; rank++) {
-                hxhim_add_endpoint_to_group(hx, rank);
-            }
+            // an empty endpoint group contains every rank
             return true;
         }
         else {
+            std::stringstream s(endpointgroup->second);
             int id;
-            while (std::stringstream(endpointgroup->second) >> id) {
+            while (s >> id) {
                 if (hxhim_add_endpoint_to_group(hx, id) != HXHIM_SUCCESS) {
                     // should probably write to mlog and continue instead of returning
                     return false;
                 }
             }
+            return true;
         }
     }
     return false;
@@ -324,6 +392,51 @@ static bool parse_histogram(hxhim_t *hx, const Config::Config &config) {
     return true;
 }
 
+/**
+ * parse_collective
+ * Parses the settings used by collective flushes.
+ * Node aggregation defaults to off if it is not found.
+ *
+ * @param hx      the hxhim instance being built
+ * @param config  the configuration to use
+ * @param true, or false on error
+ */
+static bool parse_collective(hxhim_t *hx, const Config::Config &config) {
+    bool node_aggregation = false;
+    const int ret = Config::get_value(config, hxhim::config::NODE_AGGREGATION, node_aggregation);
+    if ((ret == Config::ERROR)                                                                ||
+        ((ret == Config::FOUND) && (hxhim_set_node_aggregation(hx, node_aggregation) != HXHIM_SUCCESS))) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * parse_schedule
+ * Parses the request scheduling settings.
+ * Operations that are not found keep their
+ * current settings.
+ *
+ * @param hx      the hxhim instance being built
+ * @param config  the configuration to use
+ * @param true, or false on error
+ */
+static bool parse_schedule(hxhim_t *hx, const Config::Config &config) {
+    for(decltype(hxhim::config::SCHEDULED_OPS)::value_type const &op : hxhim::config::SCHEDULED_OPS) {
+        std::size_t priority = hx->p->range_server.schedule[op.second].priority;
+        std::size_t weight   = hx->p->range_server.schedule[op.second].weight;
+
+        if ((Config::get_value(config, hxhim::config::SCHEDULE_PRIORITY_PREFIX + op.first, priority) == Config::ERROR) ||
+            (Config::get_value(config, hxhim::config::SCHEDULE_WEIGHT_PREFIX   + op.first, weight)   == Config::ERROR) ||
+            (hxhim_set_request_schedule(hx, op.second, priority, weight) != HXHIM_SUCCESS)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /**
  * fill_options
  * Fills up hx as best it can using config.
@@ -351,9 +464,18 @@ static int fill_options(hxhim_t *hx, const Config::Config &config) {
         parse_datastore(hx, config)                                                                   &&
         parse_transport(hx, config)                                                                   &&
         parse_endpointgroup(hx, config)                                                               &&
+        parse_value(hx, config, ENDPOINT_CACHE_SIZE,           hxhim_set_endpoint_cache_size)         &&
         parse_value(hx, config, START_ASYNC_PUTS_AT,           hxhim_set_start_async_puts_at)         &&
         parse_value(hx, config, MAXIMUM_OPS_PER_REQUEST,       hxhim_set_maximum_ops_per_request)     &&
         parse_value(hx, config, MAXIMUM_SIZE_PER_REQUEST,      hxhim_set_maximum_size_per_request)    &&
+        parse_value(hx, config, MAXIMUM_REQUESTS_IN_FLIGHT,    hxhim_set_maximum_requests_in_flight)  &&
+        parse_collective(hx, config)                                                                  &&
+        parse_schedule(hx, config)                                                                    &&
+        parse_value(hx, config, RANGE_SERVER_CREDIT_BYTES,     hxhim_set_range_server_credit_bytes)   &&
+        parse_value(hx, config, RANGE_SERVER_CREDIT_OPS,       hxhim_set_range_server_credit_ops)     &&
+        parse_value(hx, config, RANGE_SERVER_GETOP_CHUNK,      hxhim_set_range_server_getop_chunk)    &&
+        parse_value(hx, config, RANGE_SERVER_MAX_OBJECT_SIZE,  hxhim_set_range_server_max_object_size) &&
+        parse_value(hx, config, RANGE_SERVER_PARTIAL_TIMEOUT,  hxhim_set_range_server_partial_timeout) &&
         parse_elen(hx, config)                                                                        &&
         parse_histogram(hx, config)                                                                   &&
         true?HXHIM_SUCCESS:HXHIM_ERROR;
@@ -10,6 +10,18 @@
  * @return HXHIM_SUCCESS on success or HXHIM_ERROR
  */
 int hxhim::destroy::bootstrap(hxhim_t *hx) {
+    if (hx->p->collective.node != MPI_COMM_NULL) {
+        MPI_Comm_free(&hx->p->collective.node);
+    }
+
+    if (hx->p->collective.leaders != MPI_COMM_NULL) {
+        MPI_Comm_free(&hx->p->collective.leaders);
+    }
+
+    hx->p->collective.node_rank = -1;
+    hx->p->collective.node_of.clear();
+    hx->p->collective.node_rank_of.clear();
+
     hx->p->bootstrap.comm = MPI_COMM_NULL;
     hx->p->bootstrap.rank = -1;
     hx->p->bootstrap.size = -1;
@@ -24,6 +24,46 @@ int hxhim::init::bootstrap(hxhim_t *hx) {
         return HXHIM_ERROR;
     }
 
+    // this process is rank 0 of the simulated ranks
+    if (hx->p->transport.config && (hx->p->transport.config->type == Transport::TRANSPORT_SIM)) {
+        if (hx->p->bootstrap.size != 1) {
+            mlog(HXHIM_CLIENT_ERR, "The simulated transport can only be used by 1 MPI rank (found %d)", hx->p->bootstrap.size);
+            return HXHIM_ERROR;
+        }
+
+        Transport::SIM::Options *opts = static_cast<Transport::SIM::Options *>(hx->p->transport.config);
+        if (!opts->ranks) {
+            mlog(HXHIM_CLIENT_ERR, "There must be at least 1 simulated rank");
+            return HXHIM_ERROR;
+        }
+
+        hx->p->bootstrap.size = opts->ranks;
+        mlog(HXHIM_CLIENT_INFO, "Simulating %d ranks", hx->p->bootstrap.size);
+    }
+
+    // group ranks by node for collective flushes
+    if (hx->p->collective.node_aggregation) {
+        decltype(hx->p->collective) &collective = hx->p->collective;
+        const int rank = hx->p->bootstrap.rank;
+        const int size = hx->p->bootstrap.size;
+
+        int node_id = -1;
+        collective.node_of.resize(size);
+        collective.node_rank_of.resize(size);
+        if ((MPI_Comm_split_type(hx->p->bootstrap.comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &collective.node)    != MPI_SUCCESS) ||
+            (MPI_Comm_rank(collective.node, &collective.node_rank)                                                       != MPI_SUCCESS) ||
+            (MPI_Comm_split(hx->p->bootstrap.comm, collective.node_rank?MPI_UNDEFINED:0, rank, &collective.leaders)     != MPI_SUCCESS) ||
+            ((collective.leaders != MPI_COMM_NULL) && (MPI_Comm_rank(collective.leaders, &node_id)                       != MPI_SUCCESS)) ||
+            (MPI_Bcast(&node_id, 1, MPI_INT, 0, collective.node)                                                         != MPI_SUCCESS) ||
+            (MPI_Allgather(&node_id, 1, MPI_INT, collective.node_of.data(), 1, MPI_INT, hx->p->bootstrap.comm)           != MPI_SUCCESS) ||
+            (MPI_Allgather(&collective.node_rank, 1, MPI_INT, collective.node_rank_of.data(), 1, MPI_INT, hx->p->bootstrap.comm) != MPI_SUCCESS)) {
+            mlog(HXHIM_CLIENT_ERR, "Failed to group ranks by node");
+            return HXHIM_ERROR;
+        }
+
+        mlog(HXHIM_CLIENT_INFO, "Rank %d is rank %d on node %d", rank, collective.node_rank, node_id);
+    }
+
     mlog(HXHIM_CLIENT_INFO, "Completed MPI Bootstrap Intialization");
 
     return HXHIM_SUCCESS;
@@ -59,6 +99,7 @@ int hxhim::init::queues(hxhim_t *hx) {
         #endif
         hx->p->queues.puts.queue.resize(hx->p->range_server.datastores.total);
         hx->p->queues.puts.count = 0;
+        hx->p->queues.puts.chunked = 0;
     }
     hx->p->queues.gets.resize      (hx->p->range_server.datastores.total);
     hx->p->queues.getops.resize    (hx->p->range_server.datastores.total);
@@ -81,18 +122,35 @@ int hxhim::init::queues(hxhim_t *hx) {
 
 namespace hxhim {
 namespace init {
-static ::Datastore::Transform::Callbacks *transform(hxhim_t *hx) {
+/**
+ * transform
+ * Combines the default callbacks with the callbacks
+ * set in the options. Every datastore takes ownership
+ * of its own copy.
+ *
+ * @param hx   the HXHIM instance
+ * @return a new set of callbacks
+ */
+::Datastore::Transform::Callbacks *transform(hxhim_t *hx) {
     decltype(hx->p->range_server.datastores.transform) &transform = hx->p->range_server.datastores.transform;
     ::Datastore::Transform::Callbacks *callbacks = ::Datastore::Transform::default_callbacks();
 
     callbacks->numeric_extra = transform.numeric_extra;
 
     // overwrite existing callbacks with those set in opts
-    for(decltype(transform.encode)::value_type const &callback : transform.encode) {
-        callbacks->encode.emplace(callback);
+    for(int type = 0; type < HXHIM_DATA_MAX_KNOWN; type++) {
+        if (transform.encode[type].set) {
+            callbacks->set_encode((hxhim_data_t) type, transform.encode[type]);
+        }
+        if (transform.decode[type].set) {
+            callbacks->set_decode((hxhim_data_t) type, transform.decode[type]);
+        }
+    }
+    for(decltype(transform.other_encode)::value_type const &callback : transform.other_encode) {
+        callbacks->set_encode(callback.first, callback.second);
     }
-    for(decltype(transform.decode)::value_type const &callback : transform.decode) {
-        callbacks->decode.emplace(callback);
+    for(decltype(transform.other_decode)::value_type const &callback : transform.other_decode) {
+        callbacks->set_decode(callback.first, callback.second);
     }
 
     return callbacks;
@@ -1,5 +1,6 @@
 #include "hxhim/hxhim.hpp"
 #include "hxhim/private/hxhim.hpp"
+#include "hxhim/private/collective.hpp"
 #include "hxhim/private/process.hpp"
 
 /**
@@ -244,3 +245,81 @@ hxhim::Results *hxhim::Flush(hxhim_t *hx) {
 hxhim_results_t *hxhimFlush(hxhim_t *hx) {
     return hxhim_results_init(hx, hxhim::Flush(hx));
 }
+
+/**
+ * FlushCollective
+ * Collective version of Flush for bulk-synchronous
+ * applications where every rank flushes at the same time.
+ * Queued packets are exchanged with MPI_Alltoall/MPI_Alltoallv
+ * instead of point-to-point messages, processed by the
+ * receiving ranks, and returned with a second all-to-all.
+ *     1. Do all PUTs
+ *     2. Do all GETs
+ *     3. Do all GET_OPs
+ *     4. Do all DELs
+ *     5. Do all HISTOGRAMs
+ *
+ * This function is a collective. The simulated
+ * transport falls back to Flush.
+ *
+ * @param hx the HXHIM session
+ * @return A list of results
+ */
+hxhim::Results *hxhim::FlushCollective(hxhim_t *hx) {
+    const int rank = hx->p->bootstrap.rank;
+
+    // simulated ranks are not MPI processes, so there is nothing to exchange with
+    if (hx->p->transport.config && (hx->p->transport.config->type == Transport::TRANSPORT_SIM)) {
+        return hxhim::Flush(hx);
+    }
+
+    mlog(HXHIM_CLIENT_INFO, "Rank %d Flushing Collectively", rank);
+    hxhim::Results *res = construct<hxhim::Results>();
+
+    if (hx->p->async_puts.enabled) {
+        // wait for the background thread to finish
+        hxhim::wait_for_background_puts(hx, false);
+
+        // move internal results to res to give to caller
+        res->Append(hx->p->async_puts.results);
+        destruct(hx->p->async_puts.results);
+        hx->p->async_puts.results = nullptr;
+
+        hx->p->queues.puts.mutex.lock();
+    }
+
+    hxhim::Results *puts = hxhim::collective::process<Message::Request::BPut, Message::Response::BPut>(hx, hx->p->queues.puts.queue);
+    hx->p->queues.puts.count = 0;
+
+    if (hx->p->async_puts.enabled) {
+        hx->p->queues.puts.mutex.unlock();
+    }
+
+    res->Append(puts);     destruct(puts);
+
+    hxhim::Results *gets   = hxhim::collective::process<Message::Request::BGet,       Message::Response::BGet>      (hx, hx->p->queues.gets);
+    res->Append(gets);     destruct(gets);
+
+    hxhim::Results *getops = hxhim::collective::process<Message::Request::BGetOp,     Message::Response::BGetOp>    (hx, hx->p->queues.getops);
+    res->Append(getops);   destruct(getops);
+
+    hxhim::Results *dels   = hxhim::collective::process<Message::Request::BDelete,    Message::Response::BDelete>   (hx, hx->p->queues.deletes);
+    res->Append(dels);     destruct(dels);
+
+    hxhim::Results *hists  = hxhim::collective::process<Message::Request::BHistogram, Message::Response::BHistogram>(hx, hx->p->queues.histograms);
+    res->Append(hists);    destruct(hists);
+
+    mlog(HXHIM_CLIENT_INFO, "Rank %d Completed Flushing Collectively", rank);
+    return res;
+}
+
+/**
+ * hxhimFlushCollective
+ * Collectively push all queued work into MDHIM
+ *
+ * @param hx
+ * @return An array of results
+ */
+hxhim_results_t *hxhimFlushCollective(hxhim_t *hx) {
+    return hxhim_results_init(hx, hxhim::FlushCollective(hx));
+}
@@ -91,12 +91,73 @@ Request_t *get_packet(hxhim_t *hx,
     return req;
 }
 
+/**
+ * put_size
+ * Calculates the number of bytes a single PUT
+ * adds to a serialized request packet
+ *
+ * @param subject    the subject of the PUT
+ * @param predicate  the predicate of the PUT
+ * @param object     the object (or chunk of an object) of the PUT
+ * @param chunk      where the object belongs within the full object
+ * @return the number of bytes the PUT will take up
+ */
+static std::size_t put_size(const Blob &subject, const Blob &predicate, const Blob &object,
+                            const Message::Request::BPut::Chunk &chunk) {
+    return subject.pack_size(true)   + sizeof(subject.data()) +
+           predicate.pack_size(true) + sizeof(predicate.data()) +
+           object.pack_size(true)    + Message::Request::BPut::chunk_size(chunk);
+}
+
+/**
+ * object_chunk_size
+ * Calculates how many bytes of an object can be placed
+ * into an otherwise empty packet along with its subject
+ * and predicate. Only HXHIM_DATA_BYTE objects are split
+ * since other types are not meaningful in pieces.
+ *
+ * @param hx         the HXHIM session
+ * @param subject    the subject of the PUT
+ * @param predicate  the predicate of the PUT
+ * @param object     the object of the PUT
+ * @return the number of bytes per chunk, or 0 if the object should not be split
+ */
+static std::size_t object_chunk_size(hxhim_t *hx, const Blob &subject, const Blob &predicate, const Blob &object) {
+    const std::size_t max_size = hx->p->queues.max_per_request.size;
+    if (!max_size || (object.data_type() != hxhim_data_t::HXHIM_DATA_BYTE)) {
+        return 0;
+    }
+
+    // size of a packet holding only the subject, predicate, and an empty chunk
+    Message::Request::BPut::Chunk chunk;
+    chunk.id = 1;
+    const std::size_t overhead = Message::Request::BPut().size() +
+                                 put_size(subject, predicate, Blob(nullptr, 0, object.data_type()), chunk);
+
+    // not even the key fits, so there is no point in splitting the object
+    if (overhead >= max_size) {
+        return 0;
+    }
+
+    const std::size_t chunk_size = max_size - overhead;
+    return (chunk_size < object.size())?chunk_size:0;
+}
+
 /**
  * PutImpl
  * Add a PUT into the work queue
  * hx and hx->p are not checked because they must have been
  * valid for this function to be called.
  *
+ * HXHIM_DATA_BYTE objects that do not fit into a single packet
+ * are split into chunks, each of which is placed into its own
+ * packet, so no request is ever larger than the maximum request
+ * size. All chunks of an object share an id that is unique to
+ * this rank and carry the size of the full object, so the range
+ * server can reassemble the object no matter what order the
+ * chunks arrive in. Only the chunk that completes the object
+ * generates a PUT result.
+ *
  * @param hx             the HXHIM session
  * @param puts           the queue to place the PUT in
  * @param subject        the subject to put
@@ -171,20 +232,40 @@ int hxhim::PutImpl(hxhim_t *hx,
 
         mlog(HXHIM_CLIENT_DBG, "Foreground PUT Insert SPO into queue");
 
-        ::Stats::Chronostamp insert;
-        insert.start = ::Stats::now();
+        // objects that are too large are sent in multiple chunks
+        const std::size_t chunk_size = object_chunk_size(hx, *sub, *pred, *obj);
+
+        Message::Request::BPut::Chunk chunk = {};
+        if (chunk_size) {
+            // ids are never 0, even when the counter wraps around
+            // mutex is locked by caller
+            chunk.id = (((std::uint64_t) hx->p->bootstrap.rank + 1) << 32) | hx->p->queues.puts.chunked++;
+            chunk.total = obj->size();
+        }
+
+        do {
+            ::Stats::Chronostamp insert;
+            insert.start = ::Stats::now();
 
-        // add the triple to the last packet in the queue
-        Message::Request::BPut *put = setup_packet(hx, puts[rs_id],
-                                                   sub->pack_size(true) +
-                                                   pred->pack_size(true) +
-                                                   obj->pack_size(true));
-        put->add(*sub, *pred, *obj);
-        hx->p->queues.puts.count++; // mutex is locked by caller
+            std::size_t len = obj->size() - chunk.offset;
+            if (chunk_size && (len > chunk_size)) {
+                len = chunk_size;
+            }
 
-        put->timestamps.reqs[put->count - 1].hash = hash;
-        put->timestamps.reqs[put->count - 1].insert = insert;
-        put->timestamps.reqs[put->count - 1].insert.end = ::Stats::now();
+            Blob piece = ReferenceBlob((char *) obj->data() + chunk.offset, len, obj->data_type());
+
+            // add the triple to the last packet in the queue
+            Message::Request::BPut *put = setup_packet(hx, puts[rs_id],
+                                                       put_size(*sub, *pred, piece, chunk));
+            put->add(*sub, *pred, piece, chunk);
+            hx->p->queues.puts.count++; // mutex is locked by caller
+
+            put->timestamps.reqs[put->count - 1].hash = hash;
+            put->timestamps.reqs[put->count - 1].insert = insert;
+            put->timestamps.reqs[put->count - 1].insert.end = ::Stats::now();
+
+            chunk.offset += len;
+        } while (chunk.offset < obj->size());
     }
 
     // trigger background PUTs in higher scope in order to allow for all BPUTs to queue up before flushing
@@ -265,6 +346,55 @@ int hxhim::GetOpImpl(hxhim_t *hx,
     return HXHIM_SUCCESS;
 }
 
+/**
+ * next_chunks
+ * Queue GETOPs for the next chunks of the GETOPs that
+ * were cut off by the range server. The GETOPs go back
+ * to the datastore that sent the response and continue
+ * after the last record of the response.
+ *
+ * @param hx         the HXHIM session
+ * @param getops     the queue to place the GETOPs in
+ * @param response   the list of responses from range servers
+ */
+void hxhim::next_chunks(hxhim_t *hx,
+                        hxhim::Queues<Message::Request::BGetOp> &getops,
+                        Message::Response::BGetOp *response) {
+    for(Message::Response::BGetOp *res = response; res;
+        res = static_cast<Message::Response::BGetOp *>(res->next)) {
+        if ((res->src < 0) || ((std::size_t) res->src >= getops.size())) {
+            continue;
+        }
+
+        for(std::size_t i = 0; i < res->count; i++) {
+            if (!res->rest.num_recs[i]) {
+                continue;
+            }
+
+            ::Stats::Chronopoint insert_start = ::Stats::now();
+
+            Message::Request::BGetOp *getop = setup_packet(hx, getops[res->src],
+                                                           res->rest.subjects[i].pack_size(true) +
+                                                           res->rest.predicates[i].pack_size(true) +
+                                                           Blob::pack_size(res->rest.cursors[i].size(), false));
+            getop->timestamps.reqs[getop->count].insert.start = insert_start;
+
+            getop->add(std::move(res->rest.subjects[i]),
+                       std::move(res->rest.predicates[i]),
+                       res->rest.object_types[i],
+                       res->rest.num_recs[i],
+                       res->rest.ops[i],
+                       std::move(res->rest.cursors[i]));
+            getop->timestamps.reqs[getop->count - 1].insert.end = ::Stats::now();
+
+            mlog(HXHIM_CLIENT_DBG, "GETOP queued next chunk of %zu records from datastore %d",
+                 res->rest.num_recs[i], res->src);
+
+            res->rest.num_recs[i] = 0;
+        }
+    }
+}
+
 /**
  * DeleteImpl
  * Add a DELETE into the work queue
@@ -5,6 +5,8 @@
 #include "hxhim/options.hpp"
 #include "hxhim/private/hxhim.hpp"
 #include "transport/backend/MPI/Options.hpp"
+#include "transport/backend/SHM/Options.hpp"
+#include "transport/backend/SIM/Options.hpp"
 #if HXHIM_HAVE_THALLIUM
 #include "transport/backend/Thallium/Options.hpp"
 #endif
@@ -320,8 +322,8 @@ int hxhim_set_transform_function(hxhim_t *hx, const enum hxhim_data_t type,
         return HXHIM_ERROR;
     }
 
-    hx->p->range_server.datastores.transform.encode.emplace(type, std::make_pair(encode, encode_extra));
-    hx->p->range_server.datastores.transform.decode.emplace(type, std::make_pair(decode, decode_extra));
+    hx->p->range_server.datastores.transform.set_encode(type, ::Datastore::Transform::Callbacks::Encode(encode, encode_extra, true));
+    hx->p->range_server.datastores.transform.set_decode(type, ::Datastore::Transform::Callbacks::Decode(decode, decode_extra, true));
 
     return HXHIM_SUCCESS;
 }
@@ -369,11 +371,81 @@ int hxhim_set_transport_null(hxhim_t *hx) {
  * Sets the values needed to set up a mpi Transport
  *
  * @param hx           the hxhim instance being built
- * @param listeners    the number of listeners
+ * @param listeners    the number of range server worker threads
  * @return HXHIM_SUCCESS or HXHIM_ERROR
  */
 int hxhim_set_transport_mpi(hxhim_t *hx, const size_t listeners) {
-    Transport::Options *config = construct<Transport::MPI::Options>(hx->p->bootstrap.comm, listeners);
+    return hxhim_set_transport_mpi_ingest(hx, listeners, 0);
+}
+
+/**
+ * hxhim_set_transport_mpi_ingest
+ * Sets the values needed to set up a mpi Transport
+ * where PUTs are appended to windows on the range
+ * servers with one-sided MPI instead of being sent.
+ * The range servers respond to appended PUTs the
+ * same way they respond to sent PUTs. PUTs that do
+ * not fit into a window are sent.
+ *
+ * @param hx             the hxhim instance being built
+ * @param listeners      the number of range server worker threads
+ * @param ingest_window  the number of bytes in each window (0 to disable)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_mpi_ingest(hxhim_t *hx, const size_t listeners, const size_t ingest_window) {
+    Transport::Options *config = construct<Transport::MPI::Options>(hx->p->bootstrap.comm, listeners, ingest_window);
+    if (hxhim_set_transport(hx, config) != HXHIM_SUCCESS) {
+        destruct(config);
+        return HXHIM_ERROR;
+    }
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_transport_shm
+ * Sets the values needed to set up a shared memory Transport
+ * Ranks on other nodes are reached with MPI.
+ *
+ * @param hx           the hxhim instance being built
+ * @param ring_size    the number of bytes in each shared memory ring
+ * @param listeners    the number of MPI range server worker threads
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_shm(hxhim_t *hx, const size_t ring_size, const size_t listeners) {
+    Transport::Options *config = construct<Transport::SHM::Options>(ring_size, listeners);
+    if (hxhim_set_transport(hx, config) != HXHIM_SUCCESS) {
+        destruct(config);
+        return HXHIM_ERROR;
+    }
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_transport_sim
+ * Sets the values needed to set up a simulated Transport
+ * This process becomes rank 0 of ranks simulated ranks,
+ * and the range servers of the other simulated ranks are
+ * run by worker threads. Messages are delayed according
+ * to a latency, bandwidth, and jitter model. The MPI
+ * bootstrap communicator must only contain this process.
+ *
+ * @param hx         the hxhim instance being built
+ * @param ranks      the number of simulated ranks
+ * @param latency    the one-way latency of each message (microseconds)
+ * @param bandwidth  the bytes per second of each rank (0 is unlimited)
+ * @param jitter     the largest random delay added to each message (microseconds)
+ * @param workers    the number of threads running the simulated range servers
+ * @param seed       the seed of the jitter
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_sim(hxhim_t *hx, const size_t ranks, const size_t latency, const size_t bandwidth, const size_t jitter, const size_t workers, const size_t seed) {
+    if (!ranks) {
+        return HXHIM_ERROR;
+    }
+
+    Transport::Options *config = construct<Transport::SIM::Options>(ranks, latency, bandwidth, jitter, workers, seed);
     if (hxhim_set_transport(hx, config) != HXHIM_SUCCESS) {
         destruct(config);
         return HXHIM_ERROR;
@@ -392,7 +464,43 @@ int hxhim_set_transport_mpi(hxhim_t *hx, const size_t listeners) {
  * @return HXHIM_SUCCESS or HXHIM_ERROR
  */
 int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const int thread_count) {
-    Transport::Options *config = construct<Transport::Thallium::Options>(module, thread_count);
+    return hxhim_set_transport_thallium(hx, module, thread_count, Transport::Thallium::Options::DEFAULT_EAGER_SIZE);
+}
+
+/**
+ * hxhim_set_transport_thallium
+ * Sets the values needed to set up a thallium Transport
+ * Requests and responses up to eager_size bytes are
+ * sent inside of the RPC instead of through bulk transfers.
+ *
+ * @param hx            the hxhim instance being built
+ * @param module        the name of the thallium module to use
+ * @param thread_count  the number of threads thallium should use
+ * @param eager_size    the largest packet that is sent inline
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const int thread_count, const std::size_t eager_size) {
+    return hxhim_set_transport_thallium(hx, module, thread_count, eager_size, Transport::Thallium::Options::DEFAULT_XSTREAMS_PER_DATASTORE);
+}
+
+/**
+ * hxhim_set_transport_thallium
+ * Sets the values needed to set up a thallium Transport
+ * Each datastore gets its own Argobots pool, served by
+ * xstreams_per_datastore execution streams, so requests
+ * to different datastores do not wait on each other.
+ * If xstreams_per_datastore is 0, requests are processed
+ * by the RPC handler threads.
+ *
+ * @param hx                      the hxhim instance being built
+ * @param module                  the name of the thallium module to use
+ * @param thread_count            the number of threads thallium should use
+ * @param eager_size              the largest packet that is sent inline
+ * @param xstreams_per_datastore  the number of execution streams dedicated to each datastore
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const int thread_count, const std::size_t eager_size, const std::size_t xstreams_per_datastore) {
+    Transport::Options *config = construct<Transport::Thallium::Options>(module, thread_count, eager_size, xstreams_per_datastore);
     if (hxhim_set_transport(hx, config) != HXHIM_SUCCESS) {
         destruct(config);
         return HXHIM_ERROR;
@@ -412,11 +520,42 @@ int hxhim_set_transport_thallium(hxhim_t *hx, const std::string &module, const i
 int hxhim_set_transport_thallium(hxhim_t *hx, const char *module, const int thread_count) {
     return hxhim_set_transport_thallium(hx, std::string(module), thread_count);
 }
+
+/**
+ * hxhim_set_transport_thallium_eager
+ * Sets the values needed to set up a thallium Transport
+ *
+ * @param hx            the hxhim instance being built
+ * @param module        the name of the thallium module to use
+ * @param thread_count  the number of threads thallium should use
+ * @param eager_size    the largest packet that is sent inline
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_thallium_eager(hxhim_t *hx, const char *module, const int thread_count, const size_t eager_size) {
+    return hxhim_set_transport_thallium(hx, std::string(module), thread_count, eager_size);
+}
+
+/**
+ * hxhim_set_transport_thallium_xstreams
+ * Sets the values needed to set up a thallium Transport
+ *
+ * @param hx                      the hxhim instance being built
+ * @param module                  the name of the thallium module to use
+ * @param thread_count            the number of threads thallium should use
+ * @param eager_size              the largest packet that is sent inline
+ * @param xstreams_per_datastore  the number of execution streams dedicated to each datastore
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_transport_thallium_xstreams(hxhim_t *hx, const char *module, const int thread_count, const size_t eager_size, const size_t xstreams_per_datastore) {
+    return hxhim_set_transport_thallium(hx, std::string(module), thread_count, eager_size, xstreams_per_datastore);
+}
 #endif
 
 /**
  * hxhim_add_endpoint_to_group
  * Adds an endpoint to the endpoint group
+ * Once an endpoint has been added, only the
+ * endpoints in the group can be sent requests.
  *
  * @param hx   the hxhim instance being built
  * @param id   the unique id to add
@@ -439,6 +578,7 @@ int hxhim_add_endpoint_to_group(hxhim_t *hx, const int id) {
 /**
  * hxhim_clear_endpoint_group
  * Removes all endpoints in the endpoint group
+ * An empty endpoint group contains every rank.
  *
  * @param hx    the hxhim instance being built
  * @return HXHIM_SUCCESS or HXHIM_ERROR
@@ -453,6 +593,27 @@ int hxhim_clear_endpoint_group(hxhim_t *hx) {
     return HXHIM_SUCCESS;
 }
 
+/**
+ * hxhim_set_endpoint_cache_size
+ * Set the number of endpoints that are kept after being
+ * resolved. Endpoints are resolved the first time they
+ * are used, and the least recently used endpoint is
+ * dropped when the cache is full.
+ *
+ * @param hx     the hxhim instance being built
+ * @param count  the number of endpoints (positive)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_endpoint_cache_size(hxhim_t *hx, const std::size_t count) {
+    if (!hx || !hx->p || hx->p->running || !count) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->transport.endpoint_cache = count;
+
+    return HXHIM_SUCCESS;
+}
+
 /**
  * hxhim_set_start_async_puts_at
  * Set the number of bulk PUTs to queue up before flushing in the background thread
@@ -508,6 +669,177 @@ int hxhim_set_maximum_size_per_request(hxhim_t *hx, const std::size_t size) {
     return HXHIM_SUCCESS;
 }
 
+/**
+ * hxhim_set_maximum_requests_in_flight
+ * Set the number of packets that can be outstanding at a
+ * single range server. When a few range servers hold most
+ * of the queued packets, their packets are sent together
+ * instead of taking one round trip each.
+ *
+ * @param hx     the hxhim instance being built
+ * @param count  the number of packets (positive)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_maximum_requests_in_flight(hxhim_t *hx, const std::size_t count) {
+    if (!hx || !hx->p || hx->p->running || !count) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->queues.max_in_flight = count;
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_node_aggregation
+ * Set whether or not collective flushes funnel packets
+ * through one leader rank per node. Leaders merge the
+ * packets of all ranks on their node and exchange them
+ * with the other leaders.
+ *
+ * @param hx      the hxhim instance being built
+ * @param enable  whether or not to aggregate by node
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_node_aggregation(hxhim_t *hx, const int enable) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->collective.node_aggregation = enable;
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_request_schedule
+ * Set how range servers order the queued requests of an operation.
+ * Operations with lower priority values are processed first, but
+ * only weight requests of an operation are processed before every
+ * other waiting operation gets a turn.
+ *
+ * @param hx        the hxhim instance being built
+ * @param op        the operation
+ * @param priority  lower values are processed first
+ * @param weight    the number of requests processed per round (positive)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_request_schedule(hxhim_t *hx, const enum hxhim_op_t op, const size_t priority, const size_t weight) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    if ((op >= HXHIM_INVALID) || !weight) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->range_server.schedule[op] = {priority, weight};
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_range_server_credit_bytes
+ * Set the number of bytes of packets that each range
+ * server allows to be outstanding. The bytes are split
+ * evenly between the clients that are sending to the
+ * range server.
+ *
+ * @param hx     the hxhim instance being built
+ * @param bytes  the number of bytes (0 is unlimited)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_range_server_credit_bytes(hxhim_t *hx, const size_t bytes) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->range_server.credits.bytes = bytes;
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_range_server_credit_ops
+ * Set the number of operations that each range server
+ * allows to be outstanding. The operations are split
+ * evenly between the clients that are sending to the
+ * range server.
+ *
+ * @param hx   the hxhim instance being built
+ * @param ops  the number of operations (0 is unlimited)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_range_server_credit_ops(hxhim_t *hx, const size_t ops) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->range_server.credits.ops = ops;
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_range_server_getop_chunk
+ * Set the maximum number of records a range server
+ * returns for a GETOP at once. GETOPs that ask for
+ * more records are returned in chunks, which the
+ * client requests one after another.
+ *
+ * @param hx       the hxhim instance being built
+ * @param records  the number of records (0 is unlimited)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_range_server_getop_chunk(hxhim_t *hx, const size_t records) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->range_server.getop_chunk = records;
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_range_server_max_object_size
+ * Set the size of the largest object that a range
+ * server reassembles from chunks. PUTs of larger
+ * objects fail without allocating the object.
+ *
+ * @param hx     the hxhim instance being built
+ * @param bytes  the size of the object (0 is unlimited)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_range_server_max_object_size(hxhim_t *hx, const size_t bytes) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->range_server.partials.max_size = bytes;
+
+    return HXHIM_SUCCESS;
+}
+
+/**
+ * hxhim_set_range_server_partial_timeout
+ * Set how long a range server keeps an object whose
+ * chunks stopped arriving before dropping it.
+ *
+ * @param hx            the hxhim instance being built
+ * @param milliseconds  the time since the last chunk arrived (0 is unlimited)
+ * @return HXHIM_SUCCESS or HXHIM_ERROR
+ */
+int hxhim_set_range_server_partial_timeout(hxhim_t *hx, const size_t milliseconds) {
+    if (!hx || !hx->p || hx->p->running) {
+        return HXHIM_ERROR;
+    }
+
+    hx->p->range_server.partials.timeout = milliseconds;
+
+    return HXHIM_SUCCESS;
+}
+
 /**
  * hxhim_set_histogram_first_n
  * Set the number of datapoints to use to generate the histogram buckets
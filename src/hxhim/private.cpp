@@ -11,8 +11,9 @@ hxhim_private::hxhim_private()
       running(false),
       queues(),
       async_puts(),
+      collective({false, MPI_COMM_NULL, MPI_COMM_NULL, -1, {}, {}}),
       hash(),
-      transport({nullptr, {}, nullptr}),
+      transport(),
       histograms(),
       range_server(),
       stats(),
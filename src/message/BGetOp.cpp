@@ -4,7 +4,8 @@ Message::Request::BGetOp::BGetOp(const std::size_t max)
     : SubjectPredicate(hxhim_op_t::HXHIM_GETOP),
       object_types(nullptr),
       num_recs(nullptr),
-      ops(nullptr)
+      ops(nullptr),
+      cursors(nullptr)
 {
     alloc(max);
 }
@@ -21,18 +22,21 @@ void Message::Request::BGetOp::alloc(const std::size_t max) {
         object_types = alloc_array<hxhim_data_t>(max);
         num_recs     = alloc_array<std::size_t>(max);
         ops          = alloc_array<hxhim_getop_t>(max);
+        cursors      = alloc_array<Blob>(max);
     }
 }
 
 std::size_t Message::Request::BGetOp::add(Blob subject, Blob predicate,
                                             hxhim_data_t object_type,
                                             std::size_t num_rec,
-                                            hxhim_getop_t op) {
+                                            hxhim_getop_t op,
+                                            Blob cursor) {
     subjects[count] = subject;
     predicates[count] = predicate;
     object_types[count] = object_type;
     num_recs[count] = num_rec;
     ops[count] = op;
+    cursors[count] = std::move(cursor);
 
     // use Request::add instead of SubjectPredicate::add
     // to have mroe control of values added
@@ -45,7 +49,8 @@ std::size_t Message::Request::BGetOp::add(Blob subject, Blob predicate,
     }
 
     return Request::add(sizeof(object_type) +
-                 sizeof(num_rec) + sizeof(op),
+                 sizeof(num_rec) + sizeof(op) +
+                 Blob::pack_size(cursors[count].size(), false),
                  true);
 }
 
@@ -65,6 +70,9 @@ int Message::Request::BGetOp::cleanup() {
     dealloc_array(ops, max_count);
     ops = nullptr;
 
+    dealloc_array(cursors, max_count);
+    cursors = nullptr;
+
     return SubjectPredicate::cleanup();
 }
 
@@ -73,7 +81,8 @@ Message::Response::BGetOp::BGetOp(const std::size_t max)
       num_recs(nullptr),
       subjects(nullptr),
       predicates(nullptr),
-      objects(nullptr)
+      objects(nullptr),
+      rest()
 {
     alloc(max);
 }
@@ -91,6 +100,13 @@ void Message::Response::BGetOp::alloc(const std::size_t max) {
         subjects     = alloc_array<Blob *>(max);
         predicates   = alloc_array<Blob *>(max);
         objects      = alloc_array<Blob *>(max);
+
+        rest.num_recs     = alloc_array<std::size_t>(max);
+        rest.ops          = alloc_array<hxhim_getop_t>(max);
+        rest.object_types = alloc_array<hxhim_data_t>(max);
+        rest.subjects     = alloc_array<Blob>(max);
+        rest.predicates   = alloc_array<Blob>(max);
+        rest.cursors      = alloc_array<Blob>(max);
     }
 }
 
@@ -111,9 +127,10 @@ std::size_t Message::Response::BGetOp::add(Blob *subject,
     predicates[count] = predicate;
     objects[count] = object;
     num_recs[count] = num_rec;
+    rest.num_recs[count] = 0;
 
     // status is shared by all responses
-    return Response::add(status, sizeof(num_rec) + ds, true);
+    return Response::add(status, sizeof(num_rec) + ds + sizeof(rest.num_recs[count]), true);
 }
 
 std::size_t Message::Response::BGetOp::update_size(const std::size_t index) {
@@ -129,7 +146,33 @@ std::size_t Message::Response::BGetOp::update_size(const std::size_t index) {
     return size();
 }
 
+std::size_t Message::Response::BGetOp::set_rest(const std::size_t i,
+                                                  Blob subject, Blob predicate,
+                                                  hxhim_data_t object_type,
+                                                  std::size_t num_rec,
+                                                  hxhim_getop_t op,
+                                                  Blob cursor) {
+    rest.subjects[i]     = std::move(subject);
+    rest.predicates[i]   = std::move(predicate);
+    rest.object_types[i] = object_type;
+    rest.num_recs[i]     = num_rec;
+    rest.ops[i]          = op;
+    rest.cursors[i]      = std::move(cursor);
+
+    // subject and predicate are not sent for FIRST and LAST
+    std::size_t ds = sizeof(op) + sizeof(object_type) +
+        Blob::pack_size(rest.cursors[i].size(), false);
+    if ((op != hxhim_getop_t::HXHIM_GETOP_FIRST) &&
+        (op != hxhim_getop_t::HXHIM_GETOP_LAST)) {
+        ds += rest.subjects[i].pack_size(true) + rest.predicates[i].pack_size(true);
+    }
+
+    return Message::add(ds, false);
+}
+
 int Message::Response::BGetOp::steal(BGetOp *from, const std::size_t i) {
+    const std::size_t index = count;
+
     add(from->subjects[i],
         from->predicates[i],
         from->objects[i],
@@ -140,6 +183,17 @@ int Message::Response::BGetOp::steal(BGetOp *from, const std::size_t i) {
     from->predicates[i] = nullptr;
     from->objects[i]    = nullptr;
 
+    if (from->rest.num_recs[i]) {
+        set_rest(index,
+                 std::move(from->rest.subjects[i]),
+                 std::move(from->rest.predicates[i]),
+                 from->rest.object_types[i],
+                 from->rest.num_recs[i],
+                 from->rest.ops[i],
+                 std::move(from->rest.cursors[i]));
+        from->rest.num_recs[i] = 0;
+    }
+
     return HXHIM_SUCCESS;
 }
 
@@ -162,5 +216,23 @@ int Message::Response::BGetOp::cleanup() {
     dealloc_array(objects, max_count);
     objects = nullptr;
 
+    dealloc_array(rest.num_recs, max_count);
+    rest.num_recs = nullptr;
+
+    dealloc_array(rest.ops, max_count);
+    rest.ops = nullptr;
+
+    dealloc_array(rest.object_types, max_count);
+    rest.object_types = nullptr;
+
+    dealloc_array(rest.subjects, max_count);
+    rest.subjects = nullptr;
+
+    dealloc_array(rest.predicates, max_count);
+    rest.predicates = nullptr;
+
+    dealloc_array(rest.cursors, max_count);
+    rest.cursors = nullptr;
+
     return Response::cleanup();
 }
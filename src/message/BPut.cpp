@@ -2,8 +2,13 @@
 
 Message::Request::BPut::BPut(const std::size_t max)
     : SubjectPredicate(hxhim_op_t::HXHIM_PUT),
-      objects(nullptr)
+      objects(nullptr),
+      chunks(nullptr),
+      single_type_objects()
 {
+    // type of the objects if they are all the same fixed width type
+    Request::add(sizeof(hxhim_data_t), false);
+
     alloc(max);
 }
 
@@ -17,12 +22,14 @@ void Message::Request::BPut::alloc(const std::size_t max) {
     if (max) {
         SubjectPredicate::alloc(max);
         objects = alloc_array<Blob>(max);
+        chunks = alloc_array<Chunk>(max);
     }
 }
 
-std::size_t Message::Request::BPut::add(Blob subject, Blob predicate, Blob object) {
+std::size_t Message::Request::BPut::add(Blob subject, Blob predicate, Blob object, const Chunk &chunk) {
     objects[count] = object;
-    Request::add(object.pack_size(true), false);
+    chunks[count] = chunk;
+    Request::add(object.pack_size(true) + chunk_size(chunk), false);
     return SubjectPredicate::add(subject, predicate, true);
 }
 
@@ -30,9 +37,65 @@ int Message::Request::BPut::cleanup() {
     dealloc_array(objects, max_count);
     objects = nullptr;
 
+    dealloc_array(chunks, max_count);
+    chunks = nullptr;
+
+    single_type_objects.dealloc();
+
     return SubjectPredicate::cleanup();
 }
 
+std::size_t Message::Request::BPut::chunk_size(const Chunk &chunk) {
+    // the offset and total are only sent with chunks of larger objects
+    return sizeof(chunk.id) + (chunk.id?(sizeof(chunk.offset) + sizeof(chunk.total)):0);
+}
+
+std::size_t Message::Request::BPut::fixed_width(const hxhim_data_t type) {
+    switch (type) {
+        case hxhim_data_t::HXHIM_DATA_INT32:
+            return sizeof(int32_t);
+        case hxhim_data_t::HXHIM_DATA_INT64:
+            return sizeof(int64_t);
+        case hxhim_data_t::HXHIM_DATA_UINT32:
+            return sizeof(uint32_t);
+        case hxhim_data_t::HXHIM_DATA_UINT64:
+            return sizeof(uint64_t);
+        case hxhim_data_t::HXHIM_DATA_FLOAT:
+            return sizeof(float);
+        case hxhim_data_t::HXHIM_DATA_DOUBLE:
+            return sizeof(double);
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+hxhim_data_t Message::Request::BPut::single_type(std::size_t *width) const {
+    if (!count) {
+        return hxhim_data_t::HXHIM_DATA_INVALID;
+    }
+
+    const hxhim_data_t type = objects[0].data_type();
+    const std::size_t type_width = fixed_width(type);
+    if (!type_width) {
+        return hxhim_data_t::HXHIM_DATA_INVALID;
+    }
+
+    for(std::size_t i = 0; i < count; i++) {
+        if ((objects[i].data_type() != type) ||
+            (objects[i].size() != type_width)) {
+            return hxhim_data_t::HXHIM_DATA_INVALID;
+        }
+    }
+
+    if (width) {
+        *width = type_width;
+    }
+
+    return type;
+}
+
 Message::Response::BPut::BPut(const std::size_t max)
     : SubjectPredicate(hxhim_op_t::HXHIM_PUT)
 {
@@ -5,11 +5,12 @@ Message::Message::Message(const Direction dir, const enum hxhim_op_t op, const s
       op(op),
       src(-1),
       dst(-1),
+      seq(0),
       max_count(max_count),
       count(0),
       serialized_size(sizeof(direction) + sizeof(op) +
                       sizeof(src) + sizeof(dst) +
-                      sizeof(count)),
+                      sizeof(seq) + sizeof(count)),
       timestamps()
 {}
 
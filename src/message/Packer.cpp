@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "datastore/constants.hpp"
 #include "message/Packer.hpp"
 #include "utils/little_endian.hpp"
@@ -16,6 +18,37 @@ static char *pack_addr(char *&dst, void *ptr) {
     return dst;
 }
 
+/**
+ * pack_objects
+ * Packs the objects of a single type BPut as one
+ * array of values without lengths or types
+ *
+ * @tparam T   the type of all of the objects
+ * @param dst  the buffer to pack into; moved past the array
+ * @param bpm  the packet whose objects are being packed
+ */
+template <typename T>
+static void pack_objects(char *&dst, const Request::BPut *bpm) {
+    for(std::size_t i = 0; i < bpm->count; i++) {
+        little_endian::encode(dst, * (const T *) bpm->objects[i].data());
+        dst += sizeof(T);
+    }
+}
+
+// cursors may be empty, so the length is always written
+static char *pack_cursor(char *&dst, const Blob &cursor) {
+    const std::size_t len = cursor.size();
+    little_endian::encode(dst, len);
+    dst += sizeof(len);
+
+    if (len) {
+        memcpy(dst, cursor.data(), len);
+        dst += len;
+    }
+
+    return dst;
+}
+
 int Packer::pack(const Request::Request *req, void **buf, std::size_t *bufsize) {
     int ret = MESSAGE_ERROR;
     if (!req) {
@@ -55,6 +88,12 @@ int Packer::pack(const Request::BPut *bpm, void **buf, std::size_t *bufsize) {
         return MESSAGE_ERROR;
     }
 
+    // objects that all have the same fixed width type are
+    // packed as one array after the subjects and predicates
+    const hxhim_data_t single_type = bpm->single_type();
+    little_endian::encode(curr, single_type);
+    curr += sizeof(single_type);
+
     for(std::size_t i = 0; i < bpm->count; i++) {
         // subject + len
         bpm->subjects[i].pack(curr, true);
@@ -68,8 +107,53 @@ int Packer::pack(const Request::BPut *bpm, void **buf, std::size_t *bufsize) {
         // predicate addr
         pack_addr(curr, bpm->predicates[i].data());
 
-        // object + len
-        bpm->objects[i].pack(curr, true);
+        if (single_type == hxhim_data_t::HXHIM_DATA_INVALID) {
+            // object + len
+            bpm->objects[i].pack(curr, true);
+
+            // chunk id
+            const Request::BPut::Chunk &chunk = bpm->chunks[i];
+            little_endian::encode(curr, chunk.id, sizeof(chunk.id));
+            curr += sizeof(chunk.id);
+
+            // chunk offset + total object size
+            if (chunk.id) {
+                little_endian::encode(curr, chunk.offset, sizeof(chunk.offset));
+                curr += sizeof(chunk.offset);
+
+                little_endian::encode(curr, chunk.total, sizeof(chunk.total));
+                curr += sizeof(chunk.total);
+            }
+        }
+    }
+
+    if (single_type != hxhim_data_t::HXHIM_DATA_INVALID) {
+        // objects without lengths, types, or chunk ids
+        switch (single_type) {
+            case hxhim_data_t::HXHIM_DATA_INT32:
+                pack_objects<int32_t>(curr, bpm);
+                break;
+            case hxhim_data_t::HXHIM_DATA_INT64:
+                pack_objects<int64_t>(curr, bpm);
+                break;
+            case hxhim_data_t::HXHIM_DATA_UINT32:
+                pack_objects<uint32_t>(curr, bpm);
+                break;
+            case hxhim_data_t::HXHIM_DATA_UINT64:
+                pack_objects<uint64_t>(curr, bpm);
+                break;
+            case hxhim_data_t::HXHIM_DATA_FLOAT:
+                pack_objects<float>(curr, bpm);
+                break;
+            case hxhim_data_t::HXHIM_DATA_DOUBLE:
+                pack_objects<double>(curr, bpm);
+                break;
+            default:
+                return MESSAGE_ERROR;
+        }
+
+        // the serialized size assumes every object has a length, type, and chunk id
+        *bufsize = curr - (char *) *buf;
     }
 
     return MESSAGE_SUCCESS;
@@ -129,6 +213,9 @@ int Packer::pack(const Request::BGetOp *bgm, void **buf, std::size_t *bufsize) {
         // number of records to get back
         little_endian::encode(curr, bgm->num_recs[i], sizeof(bgm->num_recs[i]));
         curr += sizeof(bgm->num_recs[i]);
+
+        // where to continue from
+        pack_cursor(curr, bgm->cursors[i]);
     }
 
     return MESSAGE_SUCCESS;
@@ -276,6 +363,26 @@ int Packer::pack(const Response::BGetOp *bgm, void **buf, std::size_t *bufsize)
                 bgm->objects[i][j].pack(curr, true);
             }
         }
+
+        // records that did not fit into this chunk
+        little_endian::encode(curr, bgm->rest.num_recs[i], sizeof(bgm->rest.num_recs[i]));
+        curr += sizeof(bgm->rest.num_recs[i]);
+
+        if (bgm->rest.num_recs[i]) {
+            little_endian::encode(curr, bgm->rest.ops[i], sizeof(bgm->rest.ops[i]));
+            curr += sizeof(bgm->rest.ops[i]);
+
+            if ((bgm->rest.ops[i] != hxhim_getop_t::HXHIM_GETOP_FIRST) &&
+                (bgm->rest.ops[i] != hxhim_getop_t::HXHIM_GETOP_LAST))  {
+                bgm->rest.subjects[i].pack(curr, true);
+                bgm->rest.predicates[i].pack(curr, true);
+            }
+
+            little_endian::encode(curr, bgm->rest.object_types[i], sizeof(bgm->rest.object_types[i]));
+            curr += sizeof(bgm->rest.object_types[i]);
+
+            pack_cursor(curr, bgm->rest.cursors[i]);
+        }
     }
 
     return MESSAGE_SUCCESS;
@@ -351,6 +458,9 @@ int Packer::pack(const Message *msg, void **buf, std::size_t *bufsize, char **cu
     little_endian::encode(*curr, msg->dst);
     *curr += sizeof(msg->dst);
 
+    little_endian::encode(*curr, msg->seq);
+    *curr += sizeof(msg->seq);
+
     little_endian::encode(*curr, msg->count);
     *curr += sizeof(msg->count);
 
@@ -362,7 +472,17 @@ int Packer::pack(const Request::Request *req, void **buf, std::size_t *bufsize,
 }
 
 int Packer::pack(const Response::Response *res, void **buf, std::size_t *bufsize, char **curr) {
-    return pack(static_cast<const Message *>(res), buf, bufsize, curr);
+    if (pack(static_cast<const Message *>(res), buf, bufsize, curr) != MESSAGE_SUCCESS) {
+        return MESSAGE_ERROR;
+    }
+
+    little_endian::encode(*curr, res->grant.bytes);
+    *curr += sizeof(res->grant.bytes);
+
+    little_endian::encode(*curr, res->grant.ops);
+    *curr += sizeof(res->grant.ops);
+
+    return MESSAGE_SUCCESS;
 }
 
 }
@@ -3,8 +3,11 @@
 Message::Response::Response::Response(const enum hxhim_op_t type)
     : Message(Direction::RESPONSE, type, 0),
       statuses(nullptr),
+      grant(),
       next(nullptr)
-{}
+{
+    serialized_size += sizeof(grant.bytes) + sizeof(grant.ops);
+}
 
 Message::Response::Response::~Response()
 {}
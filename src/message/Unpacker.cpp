@@ -18,6 +18,45 @@ static char *unpack_addr(void **dst, char *&src) {
     return src;
 }
 
+/**
+ * unpack_objects
+ * Decodes the array of objects of a single type BPut
+ * in one loop over the entire array instead of one
+ * object at a time, and points each object into the
+ * decoded array.
+ *
+ * @tparam T   the type of all of the objects
+ * @param out  the packet being unpacked
+ * @param src  the packed array; moved past the array
+ * @param type the type of all of the objects
+ */
+template <typename T>
+static void unpack_objects(Request::BPut *out, char *&src, const hxhim_data_t type) {
+    const std::size_t size = out->count * sizeof(T);
+    T *objects = (T *) alloc(size);
+    little_endian::decode_array(objects, src, out->count);
+    src += size;
+
+    out->single_type_objects = RealBlob(objects, size, type);
+    for(std::size_t i = 0; i < out->count; i++) {
+        out->objects[i] = ReferenceBlob(&objects[i], sizeof(T), type);
+    }
+}
+
+// cursors may be empty, so the length is always read
+static char *unpack_cursor(Blob *dst, char *&src) {
+    std::size_t len = 0;
+    little_endian::decode(len, src);
+    src += sizeof(len);
+
+    if (len) {
+        *dst = RealBlob(len, src, hxhim_data_t::HXHIM_DATA_BYTE);
+        src += len;
+    }
+
+    return src;
+}
+
 int Unpacker::unpack(Request::Request **req, void *buf, const std::size_t bufsize) {
     int ret = MESSAGE_ERROR;
     if (!req) {
@@ -96,6 +135,11 @@ int Unpacker::unpack(Request::BPut **bpm, void *buf, const std::size_t bufsize)
         return MESSAGE_ERROR;
     }
 
+    hxhim_data_t single_type = hxhim_data_t::HXHIM_DATA_INVALID;
+    little_endian::decode(single_type, curr);
+    curr += sizeof(single_type);
+    const std::size_t width = Request::BPut::fixed_width(single_type);
+
     for(std::size_t i = 0; i < out->max_count; i++) {
         // subject + len
         out->subjects[i].unpack(curr, true);
@@ -109,12 +153,59 @@ int Unpacker::unpack(Request::BPut **bpm, void *buf, const std::size_t bufsize)
         // predicate addr
         unpack_addr(&out->orig.predicates[i], curr);
 
-        // object + len
-        out->objects[i].unpack(curr, true);
+        if (!width) {
+            // object + len
+            out->objects[i].unpack(curr, true);
+
+            // chunk id
+            Request::BPut::Chunk &chunk = out->chunks[i];
+            little_endian::decode(chunk.id, curr);
+            curr += sizeof(chunk.id);
+
+            // chunk offset + total object size
+            if (chunk.id) {
+                little_endian::decode(chunk.offset, curr);
+                curr += sizeof(chunk.offset);
+
+                little_endian::decode(chunk.total, curr);
+                curr += sizeof(chunk.total);
+            }
+            else {
+                chunk.offset = 0;
+                chunk.total = 0;
+            }
+        }
+        else {
+            // fixed width objects are never split
+            out->chunks[i] = Request::BPut::Chunk();
+        }
 
         out->count++;
     }
 
+    switch (single_type) {
+        case hxhim_data_t::HXHIM_DATA_INT32:
+            unpack_objects<int32_t>(out, curr, single_type);
+            break;
+        case hxhim_data_t::HXHIM_DATA_INT64:
+            unpack_objects<int64_t>(out, curr, single_type);
+            break;
+        case hxhim_data_t::HXHIM_DATA_UINT32:
+            unpack_objects<uint32_t>(out, curr, single_type);
+            break;
+        case hxhim_data_t::HXHIM_DATA_UINT64:
+            unpack_objects<uint64_t>(out, curr, single_type);
+            break;
+        case hxhim_data_t::HXHIM_DATA_FLOAT:
+            unpack_objects<float>(out, curr, single_type);
+            break;
+        case hxhim_data_t::HXHIM_DATA_DOUBLE:
+            unpack_objects<double>(out, curr, single_type);
+            break;
+        default:
+            break;
+    }
+
     *bpm = out;
     return MESSAGE_SUCCESS;
 }
@@ -181,6 +272,9 @@ int Unpacker::unpack(Request::BGetOp **bgm, void *buf, const std::size_t bufsize
         little_endian::decode(out->num_recs[i], curr);
         curr += sizeof(out->num_recs[i]);
 
+        // where to continue from
+        unpack_cursor(&out->cursors[i], curr);
+
         out->count++;
     }
 
@@ -394,6 +488,26 @@ int Unpacker::unpack(Response::BGetOp **bgm, void *buf, const std::size_t bufsiz
             }
         }
 
+        // records that did not fit into this chunk
+        little_endian::decode(out->rest.num_recs[i], curr);
+        curr += sizeof(out->rest.num_recs[i]);
+
+        if (out->rest.num_recs[i]) {
+            little_endian::decode(out->rest.ops[i], curr);
+            curr += sizeof(out->rest.ops[i]);
+
+            if ((out->rest.ops[i] != hxhim_getop_t::HXHIM_GETOP_FIRST) &&
+                (out->rest.ops[i] != hxhim_getop_t::HXHIM_GETOP_LAST))  {
+                out->rest.subjects[i].unpack(curr, true);
+                out->rest.predicates[i].unpack(curr, true);
+            }
+
+            little_endian::decode(out->rest.object_types[i], curr);
+            curr += sizeof(out->rest.object_types[i]);
+
+            unpack_cursor(&out->rest.cursors[i], curr);
+        }
+
         out->count++;
     }
 
@@ -451,6 +565,38 @@ int Unpacker::unpack(Response::BHistogram **bhm, void *buf, const std::size_t bu
     return MESSAGE_SUCCESS;
 }
 
+/**
+ * peek
+ * Reads the operation and destination out of the header
+ * of a packed message, so that it can be routed before
+ * it is unpacked.
+ *
+ * @param buf      the packed message
+ * @param bufsize  the size of the packed message
+ * @param op       where to place the operation
+ * @param dst      where to place the destination
+ * @return MESSAGE_SUCCESS or MESSAGE_ERROR
+ */
+int Unpacker::peek(void *buf, const std::size_t bufsize, enum hxhim_op_t *op, int *dst) {
+    Direction direction;
+    int src = -1;
+    if (!buf || !op || !dst ||
+        (bufsize < (sizeof(direction) + sizeof(*op) + sizeof(src) + sizeof(*dst)))) {
+        return MESSAGE_ERROR;
+    }
+
+    char *curr = ((char *) buf) + sizeof(direction);
+
+    little_endian::decode(*op, curr);
+    curr += sizeof(*op);
+
+    curr += sizeof(src);
+
+    little_endian::decode(*dst, curr);
+
+    return MESSAGE_SUCCESS;
+}
+
 int Unpacker::unpack(Message **msg, void *buf, const std::size_t bufsize) {
     if (!msg) {
         return MESSAGE_ERROR;
@@ -488,6 +634,9 @@ int Unpacker::unpack(Message *msg, void *buf, const std::size_t, char **curr) {
     little_endian::decode(msg->dst, *curr);
     *curr += sizeof(msg->dst);
 
+    little_endian::decode(msg->seq, *curr);
+    *curr += sizeof(msg->seq);
+
     std::size_t count = 0;
     little_endian::decode(count, *curr);
     *curr += sizeof(msg->count);
@@ -497,4 +646,18 @@ int Unpacker::unpack(Message *msg, void *buf, const std::size_t, char **curr) {
     return MESSAGE_SUCCESS;
 }
 
+int Unpacker::unpack(Response::Response *res, void *buf, const std::size_t bufsize, char **curr) {
+    if (unpack(static_cast<Message *>(res), buf, bufsize, curr) != MESSAGE_SUCCESS) {
+        return MESSAGE_ERROR;
+    }
+
+    little_endian::decode(res->grant.bytes, *curr);
+    *curr += sizeof(res->grant.bytes);
+
+    little_endian::decode(res->grant.ops, *curr);
+    *curr += sizeof(res->grant.ops);
+
+    return MESSAGE_SUCCESS;
+}
+
 }
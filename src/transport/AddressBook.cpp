@@ -0,0 +1,217 @@
+#include <cstring>
+#include <vector>
+
+#include "transport/AddressBook.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+Transport::AddressBook::AddressBook(const MPI_Comm comm, const std::string &self, const bool publish)
+    : size(0),
+      node(MPI_COMM_NULL),
+      win(MPI_WIN_NULL),
+      offsets(nullptr),
+      addresses(nullptr)
+{
+    if (!exchange(comm, self, publish)) {
+        mlog(HXHIM_CLIENT_ERR, "Could not exchange addresses");
+    }
+}
+
+Transport::AddressBook::~AddressBook() {
+    if (win != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(win);
+        MPI_Win_free(&win);
+    }
+
+    if (node != MPI_COMM_NULL) {
+        MPI_Comm_free(&node);
+    }
+}
+
+bool Transport::AddressBook::Valid() const {
+    return offsets;
+}
+
+int Transport::AddressBook::Size() const {
+    return size;
+}
+
+/**
+ * get
+ *
+ * @param rank     the rank whose address is needed
+ * @param address  where to place the address
+ * @return whether or not the rank has an address
+ */
+bool Transport::AddressBook::get(const int rank, std::string &address) const {
+    if (!Valid() || (rank < 0) || (rank >= size) ||
+        (offsets[rank] == offsets[rank + 1])) {
+        return false;
+    }
+
+    address.assign(addresses + offsets[rank], offsets[rank + 1] - offsets[rank]);
+    return true;
+}
+
+/**
+ * exchange
+ *     1. Every rank sends its address to its node leader.
+ *     2. The node leaders gather the addresses of all
+ *        nodes from each other.
+ *     3. Each node leader writes the addresses, ordered
+ *        by rank, into a window shared with its node.
+ *
+ * @param comm     the communicator whose addresses are exchanged
+ * @param self     the address of this rank
+ * @param publish  whether or not this rank has an address
+ * @return whether or not the exchange succeeded
+ */
+bool Transport::AddressBook::exchange(const MPI_Comm comm, const std::string &self, const bool publish) {
+    int rank = -1;
+    if ((MPI_Comm_rank(comm, &rank) != MPI_SUCCESS) ||
+        (MPI_Comm_size(comm, &size) != MPI_SUCCESS)) {
+        return false;
+    }
+
+    if (MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node) != MPI_SUCCESS) {
+        node = MPI_COMM_NULL;
+        return false;
+    }
+
+    int node_rank = -1;
+    int node_size = 0;
+    MPI_Comm_rank(node, &node_rank);
+    MPI_Comm_size(node, &node_size);
+
+    const bool leader = (node_rank == 0);
+
+    // (rank, length) of every address, followed by the addresses
+    int entry[2] = {rank, publish?(int) self.size():0};
+    std::vector<int> entries;
+    std::vector<char> chars;
+
+    // 1. gather the addresses of this node to the node leader
+    std::vector<int> node_entries(leader?(2 * node_size):0);
+    if (MPI_Gather(entry, 2, MPI_INT, node_entries.data(), 2, MPI_INT, 0, node) != MPI_SUCCESS) {
+        return false;
+    }
+
+    std::vector<int> counts(leader?node_size:0);
+    std::vector<int> displs(leader?node_size:0);
+    int node_chars = 0;
+    for(int i = 0; i < (leader?node_size:0); i++) {
+        counts[i] = node_entries[2 * i + 1];
+        displs[i] = node_chars;
+        node_chars += counts[i];
+    }
+
+    std::vector<char> node_addresses(node_chars);
+    if (MPI_Gatherv(self.data(), entry[1], MPI_CHAR,
+                    node_addresses.data(), counts.data(), displs.data(), MPI_CHAR,
+                    0, node) != MPI_SUCCESS) {
+        return false;
+    }
+
+    // 2. exchange between node leaders
+    if (leader) {
+        MPI_Comm leaders = MPI_COMM_NULL;
+        if (MPI_Comm_split(comm, 0, rank, &leaders) != MPI_SUCCESS) {
+            return false;
+        }
+
+        int leader_count = 0;
+        MPI_Comm_size(leaders, &leader_count);
+
+        int totals[2] = {2 * node_size, node_chars};
+        std::vector<int> all_totals(2 * leader_count);
+        bool ok = (MPI_Allgather(totals, 2, MPI_INT, all_totals.data(), 2, MPI_INT, leaders) == MPI_SUCCESS);
+
+        std::vector<int> entry_counts(leader_count);
+        std::vector<int> entry_displs(leader_count);
+        std::vector<int> char_counts(leader_count);
+        std::vector<int> char_displs(leader_count);
+        int total_entries = 0;
+        int total_chars = 0;
+        for(int i = 0; i < leader_count; i++) {
+            entry_counts[i] = all_totals[2 * i];
+            entry_displs[i] = total_entries;
+            total_entries += entry_counts[i];
+
+            char_counts[i] = all_totals[2 * i + 1];
+            char_displs[i] = total_chars;
+            total_chars += char_counts[i];
+        }
+
+        entries.resize(total_entries);
+        chars.resize(total_chars);
+        ok = ok &&
+            (MPI_Allgatherv(node_entries.data(), 2 * node_size, MPI_INT,
+                            entries.data(), entry_counts.data(), entry_displs.data(), MPI_INT,
+                            leaders) == MPI_SUCCESS) &&
+            (MPI_Allgatherv(node_addresses.data(), node_chars, MPI_CHAR,
+                            chars.data(), char_counts.data(), char_displs.data(), MPI_CHAR,
+                            leaders) == MPI_SUCCESS);
+
+        MPI_Comm_free(&leaders);
+
+        if (!ok) {
+            return false;
+        }
+    }
+    else {
+        // every rank of comm has to take part in the split
+        MPI_Comm leaders = MPI_COMM_NULL;
+        if (MPI_Comm_split(comm, MPI_UNDEFINED, rank, &leaders) != MPI_SUCCESS) {
+            return false;
+        }
+    }
+
+    // 3. the node leader allocates the table and everyone else maps it
+    const MPI_Aint table_size = leader?((size + 1) * sizeof(std::int64_t) + chars.size()):0;
+    char *base = nullptr;
+    if (MPI_Win_allocate_shared(table_size, 1, MPI_INFO_NULL, node, &base, &win) != MPI_SUCCESS) {
+        win = MPI_WIN_NULL;
+        return false;
+    }
+
+    if (!leader) {
+        MPI_Aint leader_size = 0;
+        int disp_unit = 0;
+        if (MPI_Win_shared_query(win, 0, &leader_size, &disp_unit, &base) != MPI_SUCCESS) {
+            return false;
+        }
+    }
+
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+    if (leader) {
+        std::int64_t *table = (std::int64_t *) base;
+        char *dst = base + (size + 1) * sizeof(std::int64_t);
+
+        // where each rank's address starts in chars
+        std::vector<std::int64_t> starts(size, 0);
+        std::vector<int> lens(size, 0);
+        std::int64_t start = 0;
+        for(std::size_t i = 0; i < entries.size(); i += 2) {
+            starts[entries[i]] = start;
+            lens[entries[i]] = entries[i + 1];
+            start += entries[i + 1];
+        }
+
+        table[0] = 0;
+        for(int i = 0; i < size; i++) {
+            memcpy(dst + table[i], chars.data() + starts[i], lens[i]);
+            table[i + 1] = table[i] + lens[i];
+        }
+    }
+
+    MPI_Win_sync(win);
+    MPI_Barrier(node);
+    MPI_Win_sync(win);
+
+    offsets = (const std::int64_t *) base;
+    addresses = base + (size + 1) * sizeof(std::int64_t);
+
+    mlog(HXHIM_CLIENT_INFO, "Rank %d mapped the addresses of %d ranks (%d ranks on this node)", rank, size, node_size);
+    return true;
+}
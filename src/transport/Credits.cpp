@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <chrono>
+
+#include "transport/Credits.hpp"
+#include "utils/macros.hpp"
+
+Transport::Credits::Credits()
+    : accounts(),
+      returned(0),
+      mutex(),
+      cv()
+{}
+
+/**
+ * grant
+ * Set the credits granted by a range server.
+ * Outstanding credits are kept.
+ *
+ * @param rank   the rank of the range server
+ * @param bytes  the number of bytes granted to this client (0 is unlimited)
+ * @param ops    the number of operations granted to this client (0 is unlimited)
+ */
+void Transport::Credits::grant(const int rank, const std::size_t bytes, const std::size_t ops) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Account &account = accounts[rank];
+    account.granted = true;
+    account.granted_bytes = bytes;
+    account.granted_ops = ops;
+    cv.notify_all();
+}
+
+/**
+ * acquire
+ * Takes credits for a packet if they are available.
+ * A packet that is larger than the grant is only
+ * sent when nothing else is outstanding at the
+ * range server, so a client never has more than
+ * max(grant, size of one packet) outstanding.
+ *
+ * @param rank   the rank of the range server the packet is going to
+ * @param bytes  the size of the packet
+ * @param ops    the number of operations in the packet
+ * @return whether or not the packet can be sent
+ */
+bool Transport::Credits::acquire(const int rank, const std::size_t bytes, const std::size_t ops) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // range servers are not known until a packet is sent to them
+    Account &account = accounts[rank];
+
+    // always allow one packet so that oversized packets can be sent
+    if (account.packets &&
+        (!account.granted ||
+         (account.granted_bytes && ((account.bytes + bytes) > account.granted_bytes)) ||
+         (account.granted_ops   && ((account.ops   + ops)   > account.granted_ops)))) {
+        return false;
+    }
+
+    account.bytes += bytes;
+    account.ops += ops;
+    account.packets++;
+    return true;
+}
+
+/**
+ * release
+ * Returns the credits taken by acquire.
+ *
+ * @param rank   the rank of the range server the packet went to
+ * @param bytes  the size of the packet
+ * @param ops    the number of operations in the packet
+ */
+void Transport::Credits::release(const int rank, const std::size_t bytes, const std::size_t ops) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::unordered_map<int, Account>::iterator it = accounts.find(rank);
+    if (it == accounts.end()) {
+        return;
+    }
+
+    Account &account = it->second;
+    account.bytes -= std::min(account.bytes, bytes);
+    account.ops -= std::min(account.ops, ops);
+    account.packets -= std::min(account.packets, (std::size_t) 1);
+
+    returned++;
+    cv.notify_all();
+}
+
+std::size_t Transport::Credits::generation() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return returned;
+}
+
+/**
+ * wait
+ * Blocks until credits are returned. Reading the
+ * generation before trying to acquire credits
+ * prevents missing credits that are returned
+ * between the failed acquire and the wait.
+ *
+ * @param since the value of generation() before acquiring
+ */
+void Transport::Credits::wait(const std::size_t since) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock,
+            [this, since]() -> bool {
+                return returned != since;
+            });
+}
+
+/**
+ * share
+ * The share is at least 1, so a nonzero budget
+ * always results in a limited grant.
+ *
+ * @param budget   the budget of a range server (0 is unlimited)
+ * @param clients  the number of clients of the range server
+ * @return the grant of each client (0 is unlimited)
+ */
+std::size_t Transport::Credits::share(const std::size_t budget, const std::size_t clients) {
+    if (!budget) {
+        return 0;
+    }
+
+    return std::max(budget / std::max(clients, (std::size_t) 1), (std::size_t) 1);
+}
+
+const std::size_t Transport::Grants::ACTIVE_MS;
+
+Transport::Grants::Grants()
+    : bytes(0),
+      ops(0),
+      seen(),
+      swept(::Stats::now()),
+      mutex()
+{}
+
+void Transport::Grants::budget(const std::size_t bytes, const std::size_t ops) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->bytes = bytes;
+    this->ops = ops;
+}
+
+/**
+ * issue
+ * Marks the client as active and places its share of
+ * the budget into the header of the response. The
+ * client is counted, so it is never granted more than
+ * the entire budget.
+ *
+ * @param client  the rank of the client that sent the request
+ * @param res     the response going back to the client
+ */
+void Transport::Grants::issue(const int client, Message::Response::Response *res) {
+    if (!res) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const ::Stats::Chronopoint now = ::Stats::now();
+    seen[client] = now;
+
+    // clients that have gone idle no longer take up part of the budget
+    // sweeping once per period keeps each request O(1), so
+    // idle clients are counted for up to two periods
+    const std::chrono::milliseconds period(ACTIVE_MS);
+    if ((now - swept) > period) {
+        for(REF(seen)::iterator it = seen.begin(); it != seen.end();) {
+            if ((now - it->second) > period) {
+                it = seen.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        swept = now;
+    }
+
+    res->grant.bytes = Credits::share(bytes, seen.size());
+    res->grant.ops   = Credits::share(ops,   seen.size());
+}
+
+std::size_t Transport::Grants::active() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return seen.size();
+}
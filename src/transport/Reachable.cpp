@@ -0,0 +1,27 @@
+#include "hxhim/RangeServer.hpp"
+#include "transport/Reachable.hpp"
+
+Transport::Reachable::Reachable(const int rank,
+                                const int size,
+                                const std::size_t client_ratio,
+                                const std::size_t server_ratio,
+                                const std::set<int> &endpointgroup)
+    : rank(rank),
+      size(size),
+      client_ratio(client_ratio),
+      server_ratio(server_ratio),
+      endpointgroup(endpointgroup)
+{}
+
+/**
+ * operator()
+ *
+ * @param dst the rank requests would be sent to
+ * @return whether or not requests can be sent to dst
+ */
+bool Transport::Reachable::operator()(const int dst) const {
+    return ((dst != rank) &&
+            (dst >= 0) && (dst < size) &&
+            hxhim::RangeServer::is_range_server(dst, size, client_ratio, server_ratio) &&
+            (endpointgroup.empty() || (endpointgroup.find(dst) != endpointgroup.end())));
+}
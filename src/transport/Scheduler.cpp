@@ -0,0 +1,23 @@
+#include "transport/Scheduler.hpp"
+
+/**
+ * default_schedule
+ * GET and GETOP requests are served first, and up to
+ * four of them can be served before a PUT or DELETE.
+ * HISTOGRAM requests are also reads, but are not
+ * latency sensitive, so they are served with the writes.
+ *
+ * @return the default policy of each operation
+ */
+Transport::SchedulePolicies Transport::default_schedule() {
+    SchedulePolicies policies;
+    for(SchedulePolicy &policy : policies) {
+        policy.priority = 1;
+        policy.weight = 1;
+    }
+
+    policies[HXHIM_GET]   = {0, 4};
+    policies[HXHIM_GETOP] = {0, 4};
+
+    return policies;
+}
@@ -1,59 +1,119 @@
 #include <cmath>
 
 #include "transport/backend/MPI/EndpointGroup.hpp"
+#include "utils/macros.hpp"
 #include "utils/memory.hpp"
 
 namespace Transport {
 namespace MPI {
 
 EndpointGroup::EndpointGroup(const MPI_Comm comm,
-                             volatile std::atomic_bool &running)
+                             volatile std::atomic_bool &running,
+                             const std::size_t preposted_size,
+                             const Reachable &reachable,
+                             const std::shared_ptr<IngestWindow> &ingest)
   : ::Transport::EndpointGroup(),
     EndpointBase(comm),
-    ranks(),
     running(running),
-    lens(new std::size_t[size]),
-    dsts(new int[size]),
-    srvs(new int[size])
+    preposted_size(preposted_size),
+    reachable(reachable),
+    ingest(ingest),
+    mutex(),
+    lens(),
+    dsts(),
+    srvs(),
+    seqs(),
+    bufs(),
+    reqs(),
+    indices()
 {}
 
-EndpointGroup::~EndpointGroup() {
-    delete [] srvs;
-    delete [] dsts;
-    delete [] lens;
-}
+EndpointGroup::~EndpointGroup() {}
 
 /**
- * AddID
- * Add a mapping from a unique ID to a MPI rank
+ * BPut
  *
- * @param id the unique ID associated with the rank
- * @param rank the rank associated with the unique ID
+ * @param num_rangesrvs the total number of range servers
+ * @param bpm_list the list of BPUT messages to send
+ * @return a linked list of response messages, or nullptr
  */
-void EndpointGroup::AddID(const int id, const int rank) {
-    ranks[id] = rank;
-}
+Message::Response::BPut *EndpointGroup::communicate(const ReqList<Message::Request::BPut> &bpm_list) {
+    std::lock_guard<std::mutex> lock(mutex);
 
-/**
- * RemoveID
- * Remove a mapping from a unique ID to a rank
- * If the unique ID is not found, nothing is done
- *
- * @param id the unique ID to remove
- */
-void EndpointGroup::RemoveID(const int id) {
-    ranks.erase(id);
+    if (!ingest) {
+        return return_msgs<Message::Response::BPut>(bpm_list);
+    }
+
+    // the range servers respond to appended PUTs like they do to sent PUTs
+    ReqList<Message::Request::BPut> rejected;
+    Message::Response::BPut *head = collect<Message::Response::BPut>(ingest_puts(bpm_list, rejected));
+
+    // PUTs that do not fit into the ingest windows are sent normally
+    // after the appended PUTs have been applied
+    if (rejected.size()) {
+        Message::Response::BPut *sent = return_msgs<Message::Response::BPut>(rejected);
+        if (head) {
+            Message::Response::Response *tail = head;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            tail->next = sent;
+        }
+        else {
+            head = sent;
+        }
+    }
+
+    return head;
 }
 
 /**
- * BPut
+ * ingest_puts
+ * Appends each BPut to the ingest window of its range server.
+ * The range servers and sequence IDs of the appended BPuts
+ * are recorded in srvs and seqs for collect.
  *
- * @param num_rangesrvs the total number of range servers
- * @param bpm_list the list of BPUT messages to send
- * @return a linked list of response messages, or nullptr
+ * @param bpm_list  the list of BPUT messages to send
+ * @param rejected  BPUT messages that could not be appended
+ * @return the number of BPUT messages that were appended
  */
-Message::Response::BPut *EndpointGroup::communicate(const ReqList<Message::Request::BPut> &bpm_list) {
-    return return_msgs<Message::Response::BPut>(bpm_list);
+std::size_t EndpointGroup::ingest_puts(const ReqList<Message::Request::BPut> &bpm_list,
+                                       ReqList<Message::Request::BPut> &rejected) {
+    srvs.resize(bpm_list.size());
+    seqs.resize(bpm_list.size());
+    std::size_t appended = 0;
+
+    for(REF(bpm_list)::value_type const &message : bpm_list) {
+        Message::Request::BPut *msg = message.second;
+        if (!msg) {
+            continue;
+        }
+
+        if (!reachable(message.first)) {
+            continue;
+        }
+
+        void *buf = nullptr;
+        std::size_t len = 0;
+        if (Message::Packer::pack(msg, &buf, &len) != MESSAGE_SUCCESS) {
+            mlog(MPI_ERR, "Failed to pack PUT message (%d -> %d)", msg->src, msg->dst);
+            continue;
+        }
+
+        const int rc = ingest->append(message.first, buf, len, running);
+        dealloc(buf);
+
+        if (rc != TRANSPORT_SUCCESS) {
+            rejected.emplace(message.first, msg);
+            continue;
+        }
+
+        srvs[appended] = message.first;
+        seqs[appended] = msg->seq;
+        appended++;
+    }
+
+    return appended;
 }
 
 /**
@@ -64,6 +124,7 @@ Message::Response::BPut *EndpointGroup::communicate(const ReqList<Message::Reque
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BGet *EndpointGroup::communicate(const ReqList<Message::Request::BGet> &bgm_list) {
+    std::lock_guard<std::mutex> lock(mutex);
     return return_msgs<Message::Response::BGet>(bgm_list);
 }
 
@@ -75,6 +136,7 @@ Message::Response::BGet *EndpointGroup::communicate(const ReqList<Message::Reque
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BGetOp *EndpointGroup::communicate(const ReqList<Message::Request::BGetOp> &bgm_list) {
+    std::lock_guard<std::mutex> lock(mutex);
     return return_msgs<Message::Response::BGetOp>(bgm_list);
 }
 
@@ -86,6 +148,7 @@ Message::Response::BGetOp *EndpointGroup::communicate(const ReqList<Message::Req
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BDelete *EndpointGroup::communicate(const ReqList<Message::Request::BDelete> &bdm_list) {
+    std::lock_guard<std::mutex> lock(mutex);
     return return_msgs<Message::Response::BDelete>(bdm_list);
 }
 
@@ -97,6 +160,7 @@ Message::Response::BDelete *EndpointGroup::communicate(const ReqList<Message::Re
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BHistogram *EndpointGroup::communicate(const ReqList<Message::Request::BHistogram> &bhm_list) {
+    std::lock_guard<std::mutex> lock(mutex);
     return return_msgs<Message::Response::BHistogram>(bhm_list);
 }
 
@@ -0,0 +1,222 @@
+#include "transport/backend/MPI/IngestWindow.hpp"
+#include "utils/Backoff.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+namespace Transport {
+namespace MPI {
+
+const MPI_Aint IngestWindow::TAIL = 0;
+const MPI_Aint IngestWindow::HEAD = sizeof(std::uint64_t);
+const MPI_Aint IngestWindow::LOCK = 2 * sizeof(std::uint64_t);
+const MPI_Aint IngestWindow::DATA = 4 * sizeof(std::uint64_t);   // padded to keep records aligned
+
+// records are aligned so that headers never straddle the end of the ring
+static const std::size_t ALIGNMENT = sizeof(std::uint64_t) * 2;
+
+static std::size_t align(const std::size_t len) {
+    return ((len + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+}
+
+IngestWindow::IngestWindow(const MPI_Comm comm, const std::size_t capacity, const bool expose)
+    : comm(comm),
+      rank(-1),
+      win(MPI_WIN_NULL),
+      base(nullptr),
+      capacity(align(capacity)),
+      consumed(0),
+      wrapped()
+{
+    MPI_Comm_rank(comm, &rank);
+
+    const MPI_Aint size = expose?(DATA + this->capacity):0;
+    if (MPI_Win_allocate(size, 1, MPI_INFO_NULL, comm, &base, &win) != MPI_SUCCESS) {
+        mlog(MPI_ERR, "Could not allocate %zu byte ingest window", (std::size_t) size);
+        win = MPI_WIN_NULL;
+        return;
+    }
+
+    if (size) {
+        memset(base, 0, size);
+    }
+
+    // passive target for the lifetime of the window
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+    MPI_Barrier(comm);
+}
+
+IngestWindow::~IngestWindow() {
+    if (win != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(win);
+        MPI_Win_free(&win);
+    }
+}
+
+bool IngestWindow::Valid() const {
+    return (win != MPI_WIN_NULL);
+}
+
+/**
+ * MaxMessage
+ * A record has to fit into an empty ring.
+ *
+ * @return the largest packed message that can be appended
+ */
+std::size_t IngestWindow::MaxMessage() const {
+    return capacity - sizeof(Record);
+}
+
+std::size_t IngestWindow::record_size(const std::size_t len) {
+    return align(sizeof(Record) + len);
+}
+
+/**
+ * append
+ * Reserves space in the ring of a range server
+ * and copies the message into it with MPI_Put.
+ * The message is not appended if the ring does
+ * not have room for it before running becomes false.
+ *
+ * @param rank     the range server
+ * @param data     the packed message
+ * @param len      the length of the packed message
+ * @param running  stop waiting when this becomes false
+ * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR
+ */
+int IngestWindow::append(const int rank, const void *data, const std::size_t len,
+                         volatile std::atomic_bool &running) {
+    if (!Valid() || (len > MaxMessage())) {
+        return TRANSPORT_ERROR;
+    }
+
+    const std::uint64_t need = record_size(len);
+    std::uint64_t offset = 0;
+    if (reserve(rank, need, offset, running) != TRANSPORT_SUCCESS) {
+        return TRANSPORT_ERROR;
+    }
+
+    // the space is free, so the record is always published from here on
+
+    // write the length and the message
+    const std::size_t pos = offset % capacity;
+    const std::uint64_t record_len = len;
+    put(rank, pos, &record_len, sizeof(record_len));
+    put(rank, (pos + sizeof(Record)) % capacity, data, len);
+    MPI_Win_flush(rank, win);
+
+    // publish the record
+    const std::uint64_t seq = offset + 1;
+    MPI_Accumulate(&seq, 1, MPI_UINT64_T, rank, DATA + pos + offsetof(Record, seq), 1, MPI_UINT64_T, MPI_REPLACE, win);
+    MPI_Win_flush(rank, win);
+
+    return TRANSPORT_SUCCESS;
+}
+
+/**
+ * reserve
+ * Waits for the range server to drain enough of its
+ * ring and then moves the tail past the new record.
+ * The tail is only read and moved while holding the
+ * reservation lock of the range server, so the
+ * reserved space is always free. This function does
+ * not keep any state, so multiple threads can append
+ * at the same time.
+ *
+ * MPI_Compare_and_swap would not need the lock, but
+ * it is not usable with every MPI implementation.
+ * MPI_Fetch_and_op(MPI_SUM) on the tail would reserve
+ * space before it is free, which can leave holes.
+ *
+ * @param rank     the range server
+ * @param need     the number of bytes to reserve
+ * @param offset   the offset of the reserved space
+ * @param running  stop waiting when this becomes false
+ * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR
+ */
+int IngestWindow::reserve(const int rank, const std::uint64_t need, std::uint64_t &offset,
+                          volatile std::atomic_bool &running) {
+    static const std::uint64_t LOCKED = 1;
+    static const std::uint64_t UNLOCKED = 0;
+
+    Backoff backoff;
+    while (true) {
+        // take the lock
+        std::uint64_t prev = LOCKED;
+        if (MPI_Fetch_and_op(&LOCKED, &prev, MPI_UINT64_T, rank, LOCK, MPI_REPLACE, win) != MPI_SUCCESS) {
+            mlog(MPI_ERR, "Could not lock the ingest window of %d", rank);
+            return TRANSPORT_ERROR;
+        }
+        MPI_Win_flush(rank, win);
+
+        bool reserved = false;
+        if (prev == UNLOCKED) {
+            std::uint64_t tail = 0;
+            std::uint64_t head = 0;
+            MPI_Fetch_and_op(nullptr, &tail, MPI_UINT64_T, rank, TAIL, MPI_NO_OP, win);
+            MPI_Fetch_and_op(nullptr, &head, MPI_UINT64_T, rank, HEAD, MPI_NO_OP, win);
+            MPI_Win_flush(rank, win);
+
+            if ((tail + need - head) <= capacity) {
+                const std::uint64_t end = tail + need;
+                MPI_Accumulate(&end, 1, MPI_UINT64_T, rank, TAIL, 1, MPI_UINT64_T, MPI_REPLACE, win);
+
+                // accumulates to different locations are not ordered, so the
+                // new tail has to be visible before the lock is released
+                MPI_Win_flush(rank, win);
+
+                offset = tail;
+                reserved = true;
+            }
+
+            MPI_Accumulate(&UNLOCKED, 1, MPI_UINT64_T, rank, LOCK, 1, MPI_UINT64_T, MPI_REPLACE, win);
+            MPI_Win_flush(rank, win);
+        }
+
+        if (reserved) {
+            return TRANSPORT_SUCCESS;
+        }
+
+        if (!running) {
+            return TRANSPORT_ERROR;
+        }
+
+        backoff.wait();
+    }
+}
+
+/**
+ * put
+ * Writes to the ring of a range server,
+ * splitting the write at the end of the ring
+ *
+ * @param rank  the range server
+ * @param pos   the position in the ring to start writing at
+ * @param data  the data to write
+ * @param len   the length of the data
+ */
+void IngestWindow::put(const int rank, const std::size_t pos, const void *data, const std::size_t len) {
+    const std::size_t first = std::min(len, capacity - pos);
+    MPI_Put(data, first, MPI_CHAR, rank, DATA + pos, first, MPI_CHAR, win);
+    if (first < len) {
+        MPI_Put(((char *) data) + first, len - first, MPI_CHAR, rank, DATA, len - first, MPI_CHAR, win);
+    }
+}
+
+/**
+ * published
+ * Atomically reads the sequence number of the record at
+ * pos in the local ring. The sequence number is written
+ * after the rest of the record is visible.
+ *
+ * @param pos the position of the record header
+ * @return the sequence number, or 0 if nothing is there
+ */
+std::uint64_t IngestWindow::published(const std::size_t pos) {
+    std::uint64_t seq = 0;
+    MPI_Fetch_and_op(nullptr, &seq, MPI_UINT64_T, rank, DATA + pos + offsetof(Record, seq), MPI_NO_OP, win);
+    MPI_Win_flush(rank, win);
+    return seq;
+}
+
+}
+}
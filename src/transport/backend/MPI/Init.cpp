@@ -1,3 +1,5 @@
+#include <memory>
+
 #include "hxhim/private/hxhim.hpp"
 #include "hxhim/RangeServer.hpp"
 #include "transport/backend/MPI/MPI.hpp"
@@ -25,33 +27,36 @@ Transport::Transport *Transport::MPI::init(hxhim_t *hx,
         return nullptr;
     }
 
+    const bool is_rs = hxhim::RangeServer::is_range_server(hx->p->bootstrap.rank, client_ratio, server_ratio);
+
+    // one-sided PUTs (collective)
+    std::shared_ptr<IngestWindow> ingest;
+    if (opts->ingest_window) {
+        ingest = std::make_shared<IngestWindow>(hx->p->bootstrap.comm, opts->ingest_window, is_rs);
+        if (!ingest->Valid()) {
+            return nullptr;
+        }
+        mlog(MPI_INFO, "Created %zu byte MPI ingest window on rank %d", opts->ingest_window, hx->p->bootstrap.rank);
+    }
+
     // create a range server
     RangeServer *rs = nullptr;
-    if (hxhim::RangeServer::is_range_server(hx->p->bootstrap.rank, client_ratio, server_ratio)) {
-        rs = construct<RangeServer>(hx, opts->listeners);
+    if (is_rs) {
+        rs = construct<RangeServer>(hx, opts->listeners, ingest);
         mlog(MPI_INFO, "Created MPI Range Server on rank %d", hx->p->bootstrap.rank);
     }
 
     EndpointGroup *eg = construct<EndpointGroup>(hx->p->bootstrap.comm,
-                                                 hx->p->running);
-
-    // logical
-    int rs_id = 0;
-
-    // create mapping between logical IDs and endpoint ranks
-    for(int i = 0; i < hx->p->bootstrap.size; i++) {
-        if (hxhim::RangeServer::is_range_server(i, hx->p->bootstrap.size, client_ratio, server_ratio)) {
-            if (hx->p->bootstrap.rank != i) { // skip adding the local range server
-                // if the rank was specified as part of the endpoint
-                // group, add the rank to the endpoint group
-                if (endpointgroup.find(i) != endpointgroup.end()) {
-                    eg->AddID(rs_id, i);
-                }
-            }
-
-            rs_id++;
-        }
-    }
+                                                 hx->p->running,
+                                                 hx->p->queues.max_per_request.size,
+                                                 Reachable(hx->p->bootstrap.rank,
+                                                           hx->p->bootstrap.size,
+                                                           client_ratio,
+                                                           server_ratio,
+                                                           endpointgroup),
+                                                 ingest);
+
+    // MPI ranks are addresses, so nothing has to be looked up or exchanged
 
     mlog(MPI_INFO, "Completed MPI Initialization");
     return construct<Transport>(eg, rs);
@@ -3,6 +3,7 @@
 #include "transport/backend/MPI/RangeServer.hpp"
 #include "transport/backend/MPI/constants.h"
 #include "transport/backend/local/RangeServer.hpp"
+#include "utils/Backoff.hpp"
 #include "utils/memory.hpp"
 #include "utils/mlog2.h"
 #include "utils/mlogfacs2.h"
@@ -10,17 +11,68 @@
 namespace Transport {
 namespace MPI {
 
-RangeServer::RangeServer(hxhim_t *hx, const std::size_t listener_count)
+const std::size_t RangeServer::SLOTS_PER_WORKER = 4;
+
+RangeServer::Packet::Packet(void *data, const std::size_t len, const int rank, const int slot)
+    : data(data),
+      len(len),
+      rank(rank),
+      slot(slot)
+{}
+
+RangeServer::Scheduled::Scheduled(const std::size_t datastores, const SchedulePolicies &policies)
+    : queue(datastores, policies),
+      mutex(),
+      ready()
+{}
+
+RangeServer::RangeServer(hxhim_t *hx, const std::size_t worker_count,
+                         const std::shared_ptr<IngestWindow> &ingest)
     : hx(hx),
-      listeners(listener_count)
+      receiver(),
+      workers(worker_count?worker_count:1),
+      sender(),
+      ingest(ingest),
+      ingester(),
+      requests(hx->p->range_server.datastores.per_server, hx->p->range_server.schedule),
+      responses(),
+      admitted(0),
+      pool()
 {
     mlog(MPI_INFO, "Started MPI Range Server Initialization");
-    mlog(MPI_DBG, "Starting up %zu listeners", listener_count);
+    mlog(MPI_DBG, "Starting up %zu workers", workers.size());
+
+    // pre-post receives for requests up to the maximum request size
+    pool.slab = nullptr;
+    pool.slot_size = hx->p->queues.max_per_request.size;
+    if (pool.slot_size) {
+        pool.reqs.resize(workers.size() * SLOTS_PER_WORKER, MPI_REQUEST_NULL);
+        if (MPI_Alloc_mem(pool.slot_size * pool.reqs.size(), MPI_INFO_NULL, &pool.slab) != MPI_SUCCESS) {
+            mlog(MPI_WARN, "Could not allocate receive pool; all requests will be matched and allocated");
+            pool.slab = nullptr;
+            pool.reqs.clear();
+        }
+
+        for(std::size_t i = 0; i < pool.reqs.size(); i++) {
+            MPI_Recv_init(pool.slab + i * pool.slot_size, pool.slot_size, MPI_CHAR,
+                          MPI_ANY_SOURCE, TRANSPORT_MPI_REQUEST_TAG, hx->p->bootstrap.comm, &pool.reqs[i]);
+            MPI_Start(&pool.reqs[i]);
+            pool.posted.push_back(i);
+        }
+        mlog(MPI_DBG, "Pre-posted %zu receives of %zu bytes", pool.reqs.size(), pool.slot_size);
+    }
+
+    //Initialize worker threads before anything can be queued
+    for(std::size_t i = 0; i < workers.size(); i++) {
+        workers[i] = std::thread(&RangeServer::worker_thread, this);
+        mlog(MPI_DBG, "MPI Range Server Worker Thread %zu Started", i);
+    }
+
+    sender = std::thread(&RangeServer::sender_thread, this);
+    receiver = std::thread(&RangeServer::receiver_thread, this);
 
-    //Initialize listener threads
-    for(std::size_t i = 0; i < listener_count; i++) {
-        listeners[i] = std::thread(&RangeServer::listener_thread, this);
-        mlog(MPI_DBG, "MPI Range Server Thread %lu Started", i);
+    if (ingest) {
+        ingester = std::thread(&RangeServer::ingest_thread, this);
     }
 
     mlog(MPI_INFO, "Completed MPI Range Server Initialization");
@@ -28,178 +80,496 @@ RangeServer::RangeServer(hxhim_t *hx, const std::size_t listener_count)
 
 RangeServer::~RangeServer() {
     mlog(MPI_INFO, "Stopping MPI Range Server");
+
+    // wake up any threads waiting on empty queues
+    {
+        std::lock_guard<std::mutex> lock(requests.mutex);
+        requests.ready.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(responses.mutex);
+        responses.ready.notify_all();
+    }
+
     mlog(MPI_DBG, "Waiting for MPI Range Server threads");
-    for(std::size_t i = 0; i < listeners.size(); i++) {
-        listeners[i].join();
-        mlog(MPI_DBG, "MPI Range Server Thread %lu Stopped", i);
+    receiver.join();
+    mlog(MPI_DBG, "MPI Range Server Receiver Thread Stopped");
+
+    for(std::size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+        mlog(MPI_DBG, "MPI Range Server Worker Thread %zu Stopped", i);
     }
+
+    sender.join();
+    mlog(MPI_DBG, "MPI Range Server Sender Thread Stopped");
+
+    if (ingester.joinable()) {
+        ingester.join();
+
+        // PUTs that were appended right before shutdown
+        drain_ingest();
+        mlog(MPI_DBG, "MPI Range Server Ingest Thread Stopped");
+    }
+
+    // drop anything that was not processed
+    for(Packet &packet : requests.queue.clear()) {
+        release(packet);
+    }
+
+    for(Packet &packet : responses.queue) {
+        release(packet);
+    }
+    responses.queue.clear();
+
+    // cancel the pre-posted receives that are still waiting
+    for(MPI_Request &req : pool.reqs) {
+        int done = 0;
+        MPI_Request_get_status(req, &done, MPI_STATUS_IGNORE);
+        if (!done) {
+            MPI_Cancel(&req);
+        }
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        MPI_Request_free(&req);
+    }
+    pool.reqs.clear();
+    pool.posted.clear();
+
+    if (pool.slab) {
+        MPI_Free_mem(pool.slab);
+        pool.slab = nullptr;
+    }
+
     mlog(MPI_INFO, "MPI Range Server stopped");
 }
 
 /*
- * listener_thread
- * Function for the thread that listens for new messages
+ * receiver_thread
+ * Function for the thread that receives
+ * requests and queues them for the workers
  */
-void RangeServer::listener_thread() {
-    //Mlog statements could cause a deadlock on range_server_stop due to canceling of threads
-    mlog(MPI_INFO, "MPI Range Server Thread Started");
-    while (hx->p->running){
-        // wait for request
-        void *req = nullptr;
-        std::size_t len = 0;
-        if (recv(&req, &len) != TRANSPORT_SUCCESS) {
+void RangeServer::receiver_thread() {
+    mlog(MPI_INFO, "MPI Range Server Receiver Thread Started");
+    Backoff backoff;
+    const std::size_t budget = hx->p->range_server.credits.bytes;
+    while (hx->p->running) {
+        restart_slots();
+
+        // leave requests with the clients until the workers catch up
+        if (budget && (admitted.load() >= budget)) {
+            backoff.wait();
             continue;
         }
 
-        // decode request
-        Message::Request::Request *request = nullptr;
-        Message::Unpacker::unpack(&request, req, len);
-        dealloc(req);
+        Packet packet;
+        if (recv(packet) != TRANSPORT_SUCCESS) {
+            // an idle receiver sleeps for longer and longer between checks
+            backoff.wait();
+            continue;
+        }
 
-        // process request
-        Message::Response::Response *response = local::range_server(hx, request);
-        dealloc(request);
+        backoff.reset();
+        admitted += packet.len;
 
-        // encode result
-        void *res = nullptr;
-        len = 0;
-        Message::Packer::pack(response, &res, &len);
+        // route the request by its header without unpacking it
+        enum hxhim_op_t op = HXHIM_INVALID;
+        int dst = -1;
+        if (Message::Unpacker::peek(packet.data, packet.len, &op, &dst) != MESSAGE_SUCCESS) {
+            mlog(MPI_WARN, "Could not read the header of %zu byte request from %d", packet.len, packet.rank);
+            admitted -= packet.len;
+            release(packet);
+            continue;
+        }
 
-        // send result
-        const int ret = send(response->dst, res, len);
-        dealloc(response);
-        dealloc(res);
+        std::lock_guard<std::mutex> lock(requests.mutex);
+        requests.queue.push((std::size_t) dst, op, packet);
+        requests.ready.notify_one();
+    }
+    mlog(MPI_INFO, "MPI Range Server Receiver Thread Stopped");
+}
 
-        if (ret != TRANSPORT_SUCCESS) {
-            continue;
+/*
+ * worker_thread
+ * Function for the threads that unpack requests,
+ * run them against the local datastores, and
+ * queue the packed responses for the sender.
+ * A datastore is only given to one worker at a
+ * time, so its requests are not reordered.
+ */
+void RangeServer::worker_thread() {
+    mlog(MPI_INFO, "MPI Range Server Worker Thread Started");
+    while (hx->p->running) {
+        Packet req;
+        std::size_t ds = 0;
+        {
+            std::unique_lock<std::mutex> lock(requests.mutex);
+            requests.ready.wait(lock,
+                                [this]() -> bool {
+                                    return (!hx->p->running || requests.queue.acquirable());
+                                });
+
+            if (!requests.queue.acquire(req, ds)) {
+                continue;
+            }
+        }
+
+        process(req);
+
+        // let another worker take the next request of this datastore
+        std::lock_guard<std::mutex> lock(requests.mutex);
+        requests.queue.release(ds);
+        if (requests.queue.acquirable()) {
+            requests.ready.notify_one();
         }
     }
-    mlog(MPI_INFO, "MPI Range Server Thread Stopped");
+    mlog(MPI_INFO, "MPI Range Server Worker Thread Stopped");
 }
 
 /**
- * recv
- * Waits for a length from any source and
- * then waits for data from the same source
- * Although MPI_Irecv is used, it is blocked
- * on immediately after.
+ * process
+ * Unpacks a request, runs it against the local
+ * datastores, and queues the packed response
+ * for the sender
  *
- * @param data the data to receive
- * @param len  the length of the data
- * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR on error
+ * @param req the request packet, which is released
  */
-int RangeServer::recv(void **data, std::size_t *len) {
-    if (!data || !len) {
-        return TRANSPORT_ERROR;
+void RangeServer::process(const Packet &req) {
+
+    // decode request
+    Message::Request::Request *request = nullptr;
+    const int unpacked = Message::Unpacker::unpack(&request, req.data, req.len);
+    release(req);
+
+    if (unpacked != MESSAGE_SUCCESS) {
+        mlog(MPI_WARN, "Could not unpack %zu byte request from %d", req.len, req.rank);
+        admitted -= req.len;
+        return;
     }
 
-    MPI_Request request = {};
-    MPI_Status status = {};
+    // process request
+    Message::Response::Response *response = local::range_server(hx, request);
+    destruct(request);
+    admitted -= req.len;
 
-    // wait for the size of the data
-    mlog(MPI_DBG, "MPI Range Server waiting for size");
-    if ((MPI_Irecv(len, sizeof(*len), MPI_CHAR, MPI_ANY_SOURCE, TRANSPORT_MPI_SIZE_REQUEST_TAG, hx->p->bootstrap.comm, &request) != MPI_SUCCESS) ||
-        (Flush(request, status) != TRANSPORT_SUCCESS)) {
-        mlog(MPI_DBG, "MPI Range Server errored while waiting for size");
-        return TRANSPORT_ERROR;
+    reply(response);
+}
+
+/**
+ * reply
+ * Packs a response and queues it for the sender
+ *
+ * @param response the response, which is destroyed
+ */
+void RangeServer::reply(Message::Response::Response *response) {
+    if (!response) {
+        return;
     }
-    mlog(MPI_DBG, "MPI Range Server got size %zu", *len);
 
-    *data = alloc(*len);
+    // encode result
+    Packet res(nullptr, 0, response->dst);
+    const int packed = Message::Packer::pack(response, &res.data, &res.len);
+    destruct(response);
 
-    // wait for the data
-    // mlog(MPI_DBG, "MPI Range Server waiting for data");
-    if ((MPI_Irecv(*data, *len, MPI_CHAR, status.MPI_SOURCE, TRANSPORT_MPI_DATA_REQUEST_TAG, hx->p->bootstrap.comm, &request) != MPI_SUCCESS) ||
-        (Flush(request) != TRANSPORT_SUCCESS)) {
-        // mlog(MPI_ERR, "MPI_Range Server errored while getting data of size %zu", *len);
-        return TRANSPORT_ERROR;
+    if (packed != MESSAGE_SUCCESS) {
+        mlog(MPI_WARN, "Could not pack response to %d", res.rank);
+        dealloc(res.data);
+        return;
     }
 
-    // mlog(MPI_DBG, "MPI Range Server got data of size %zu", *len);
-    return TRANSPORT_SUCCESS;
+    std::lock_guard<std::mutex> lock(responses.mutex);
+    responses.queue.emplace_back(res);
+    responses.ready.notify_one();
+}
+
+/*
+ * sender_thread
+ * Function for the thread that starts sending
+ * queued responses and completes them in batches.
+ * Response buffers are freed once their sends complete.
+ */
+void RangeServer::sender_thread() {
+    mlog(MPI_INFO, "MPI Range Server Sender Thread Started");
+
+    std::vector<MPI_Request> reqs;
+    std::vector<void *> bufs;
+    std::vector<int> indices;
+    Backoff backoff;
+
+    while (hx->p->running) {
+        std::list<Packet> ready;
+        {
+            std::unique_lock<std::mutex> lock(responses.mutex);
+
+            // only block when there is nothing to complete
+            if (!reqs.size()) {
+                responses.ready.wait(lock,
+                                     [this]() -> bool {
+                                         return (!hx->p->running || responses.queue.size());
+                                     });
+            }
+
+            ready = std::move(responses.queue);
+            responses.queue.clear();
+        }
+
+        // start sending new responses
+        for(Packet &res : ready) {
+            MPI_Request request = MPI_REQUEST_NULL;
+            if (MPI_Isend(res.data, res.len, MPI_CHAR, res.rank, TRANSPORT_MPI_RESPONSE_TAG, hx->p->bootstrap.comm, &request) != MPI_SUCCESS) {
+                mlog(MPI_ERR, "MPI Range Server errored while sending %zu bytes to %d", res.len, res.rank);
+                dealloc(res.data);
+                continue;
+            }
+
+            reqs.push_back(request);
+            bufs.push_back(res.data);
+        }
+
+        if (!reqs.size()) {
+            continue;
+        }
+
+        // complete as many sends as possible
+        int outcount = 0;
+        indices.resize(reqs.size());
+        if (MPI_Testsome(reqs.size(), reqs.data(), &outcount, indices.data(), MPI_STATUSES_IGNORE) != MPI_SUCCESS) {
+            mlog(MPI_ERR, "MPI Range Server errored while completing responses");
+            break;
+        }
+
+        if ((outcount == MPI_UNDEFINED) || (outcount == 0)) {
+            if (!ready.size()) {
+                backoff.wait();
+            }
+            continue;
+        }
+
+        backoff.reset();
+
+        for(int i = 0; i < outcount; i++) {
+            dealloc(bufs[indices[i]]);
+            bufs[indices[i]] = nullptr;
+        }
+
+        // remove completed sends
+        std::size_t kept = 0;
+        for(std::size_t i = 0; i < reqs.size(); i++) {
+            if (bufs[i]) {
+                reqs[kept] = reqs[i];
+                bufs[kept] = bufs[i];
+                kept++;
+            }
+        }
+        reqs.resize(kept);
+        bufs.resize(kept);
+    }
+
+    // Free any remaining requests
+    for(std::size_t i = 0; i < reqs.size(); i++) {
+        if (reqs[i] != MPI_REQUEST_NULL) {
+            MPI_Request_free(&reqs[i]);
+        }
+        dealloc(bufs[i]);
+    }
+
+    mlog(MPI_INFO, "MPI Range Server Sender Thread Stopped");
+}
+
+/*
+ * ingest_thread
+ * Function for the thread that processes
+ * PUTs appended to the ingest window
+ */
+void RangeServer::ingest_thread() {
+    mlog(MPI_INFO, "MPI Range Server Ingest Thread Started");
+    Backoff backoff;
+    while (hx->p->running) {
+        if (drain_ingest()) {
+            backoff.reset();
+        }
+        else {
+            backoff.wait();
+        }
+    }
+    mlog(MPI_INFO, "MPI Range Server Ingest Thread Stopped");
 }
 
 /**
- * send
- * Sends a length followed by the data to the
- * given destination. Although MPI_Isend is
- * used, it is blocked on immediately after.
+ * drain_ingest
+ * Unpacks PUTs directly out of the ingest window,
+ * runs them against the local datastores, and
+ * sends the responses like those of any other request.
  *
- * @param dst  the destination of the data
- * @param data the data to receive
- * @param len  the length of the data
- * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR on error
+ * @return the number of PUTs processed
  */
-int RangeServer::send(const int dst, void *data, const std::size_t len) {
-    MPI_Request request = {};
+std::size_t RangeServer::drain_ingest() {
+    return ingest->drain([this](void *data, const std::size_t len) {
+            Message::Request::Request *request = nullptr;
+            if (Message::Unpacker::unpack(&request, data, len) != MESSAGE_SUCCESS) {
+                mlog(MPI_WARN, "Could not unpack %zu byte ingested request", len);
+                return;
+            }
+
+            Message::Response::Response *response = local::range_server(hx, request);
+            destruct(request);
+            reply(response);
+        });
+}
+
+/**
+ * recv
+ * Gets a request if one has arrived. Requests that
+ * fit into a slot arrive through the pre-posted
+ * receives and stay in the slot until a worker
+ * releases them. Only the oldest started slot is
+ * checked, since MPI matches messages to slots in the
+ * order that the slots were started. An empty request
+ * announces a large request, which is received next
+ * so that it is not overtaken by later requests.
+ *
+ * @param packet the received request
+ * @return TRANSPORT_SUCCESS, or TRANSPORT_ERROR if nothing was received
+ */
+int RangeServer::recv(Packet &packet) {
+    MPI_Status status = {};
+    int flag = 0;
+    int count = 0;
 
-    // send the size of the data
-    // mlog(MPI_DBG, "MPI Range Server sending size %zu", len);
-    if ((MPI_Isend(&len, sizeof(len), MPI_CHAR, dst, TRANSPORT_MPI_SIZE_RESPONSE_TAG, hx->p->bootstrap.comm, &request) != MPI_SUCCESS) ||
-        (Flush(request) != TRANSPORT_SUCCESS)) {
+    if (pool.posted.size()) {
+        const int slot = pool.posted.front();
+        if (MPI_Test(&pool.reqs[slot], &flag, &status) != MPI_SUCCESS) {
+            mlog(MPI_ERR, "MPI Range Server errored while checking pre-posted receives");
+            return TRANSPORT_ERROR;
+        }
+
+        if (!flag) {
+            return TRANSPORT_ERROR;
+        }
+
+        pool.posted.pop_front();
+
+        MPI_Get_count(&status, MPI_CHAR, &count);
+        if (count) {
+            packet = Packet(pool.slab + slot * pool.slot_size, count, status.MPI_SOURCE, slot);
+            return TRANSPORT_SUCCESS;
+        }
+
+        // the slot only held an announcement
+        MPI_Start(&pool.reqs[slot]);
+        pool.posted.push_back(slot);
+        return recv_large(status.MPI_SOURCE, packet);
+    }
+
+    // no pre-posted receives
+    MPI_Message message = MPI_MESSAGE_NULL;
+    if ((MPI_Improbe(MPI_ANY_SOURCE, TRANSPORT_MPI_REQUEST_TAG, hx->p->bootstrap.comm, &flag, &message, &status) != MPI_SUCCESS) ||
+        !flag) {
         return TRANSPORT_ERROR;
     }
 
-    // wait for the data
-    // mlog(MPI_DBG, "MPI Range Server sending data");
-    if ((MPI_Isend(data, len, MPI_CHAR, dst, TRANSPORT_MPI_DATA_RESPONSE_TAG, hx->p->bootstrap.comm, &request) != MPI_SUCCESS) ||
-        (Flush(request) != TRANSPORT_SUCCESS)) {
+    MPI_Get_count(&status, MPI_CHAR, &count);
+    packet = Packet(alloc(count), count, status.MPI_SOURCE);
+    if (MPI_Mrecv(packet.data, count, MPI_CHAR, &message, MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+        mlog(MPI_ERR, "MPI Range Server errored while getting data of size %zu", packet.len);
+        dealloc(packet.data);
+        packet.data = nullptr;
         return TRANSPORT_ERROR;
     }
 
-    // mlog(MPI_DBG, "MPI Range Server send done");
-    return TRANSPORT_SUCCESS;
+    if (count) {
+        return TRANSPORT_SUCCESS;
+    }
+
+    return recv_large(status.MPI_SOURCE, packet);
 }
 
 /**
- * Flush
- * Tests a request until it is completed.
- * This function can exit early if the
- * HXHIM instance stops first.
+ * recv_large
+ * Receives a request that was too large for the
+ * pre-posted receives. The client starts sending it
+ * right after the empty request that announced it,
+ * so this only waits for it to arrive. MPI does not
+ * reorder messages from one source with the same tag,
+ * so this is the request that was announced.
  *
- * @param req the request to test
- * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR on error
+ * @param source the rank that announced the request
+ * @param packet the received request
+ * @return TRANSPORT_SUCCESS, or TRANSPORT_ERROR if nothing was received
  */
-int RangeServer::Flush(MPI_Request &req) {
+int RangeServer::recv_large(const int source, Packet &packet) {
+    MPI_Status status = {};
     int flag = 0;
-    while (!flag && hx->p->running) {
-        MPI_Test(&req, &flag, MPI_STATUS_IGNORE);
+    MPI_Message message = MPI_MESSAGE_NULL;
+    Backoff backoff;
+    while (!flag) {
+        if (!hx->p->running ||
+            (MPI_Improbe(source, TRANSPORT_MPI_LARGE_REQUEST_TAG, hx->p->bootstrap.comm, &flag, &message, &status) != MPI_SUCCESS)) {
+            return TRANSPORT_ERROR;
+        }
+
+        if (!flag) {
+            backoff.wait();
+        }
     }
 
-    if (flag) {
-        // mlog(MPI_DBG, "MPI Range Server flush succeeded");
-        return TRANSPORT_SUCCESS;
+    int count = 0;
+    MPI_Get_count(&status, MPI_CHAR, &count);
+    packet = Packet(alloc(count), count, source);
+
+    // receive the matched request
+    if (MPI_Mrecv(packet.data, count, MPI_CHAR, &message, MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+        mlog(MPI_ERR, "MPI Range Server errored while getting data of size %zu", packet.len);
+        dealloc(packet.data);
+        packet.data = nullptr;
+        return TRANSPORT_ERROR;
     }
 
-    // mlog(MPI_DBG, "MPI Range Server flush failed (flag %d, running %d)", flag, hx->p->running.load());
-    MPI_Request_free(&req);
-    return TRANSPORT_ERROR;
+    return TRANSPORT_SUCCESS;
 }
 
- /**
- * Flush
- * Tests a request until it is completed.
- * This function can exit early if the
- * HXHIM instance stops first.
- *
- * @param req    the request to test
- * @param status the status of the request
- * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR on error
+/**
+ * restart_slots
+ * Restarts the receives of the slots that the workers have
+ * released. Only the receiver thread touches the requests.
  */
-int RangeServer::Flush(MPI_Request &req, MPI_Status &status) {
-    int flag = 0;
-    while (!flag && hx->p->running) {
-        MPI_Test(&req, &flag, &status);
+void RangeServer::restart_slots() {
+    std::vector<int> released;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.released.size()) {
+            return;
+        }
+        released.swap(pool.released);
     }
 
-    if (flag) {
-        // mlog(MPI_DBG, "MPI Range Server flush succeeded");
-        return TRANSPORT_SUCCESS;
+    for(const int slot : released) {
+        MPI_Start(&pool.reqs[slot]);
+        pool.posted.push_back(slot);
+    }
+
+    // keep the capacity for the next round
+    released.clear();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (!pool.released.size()) {
+        pool.released.swap(released);
+    }
+}
+
+/**
+ * release
+ * Frees the buffer of a request packet
+ * or returns its slot to the pool
+ *
+ * @param packet the request packet
+ */
+void RangeServer::release(const Packet &packet) {
+    if (packet.slot < 0) {
+        dealloc(packet.data);
+        return;
     }
 
-    // mlog(MPI_DBG, "MPI Range Server flush failed (flag %d, running %d)", flag, hx->p->running.load());
-    MPI_Request_free(&req);
-    return TRANSPORT_ERROR;
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.released.push_back(packet.slot);
 }
 
 }
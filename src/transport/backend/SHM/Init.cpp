@@ -0,0 +1,179 @@
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include "hxhim/private/hxhim.hpp"
+#include "hxhim/RangeServer.hpp"
+#include "transport/backend/SHM/SHM.hpp"
+#include "transport/transport.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+typedef std::unordered_map<int, std::shared_ptr<Transport::SHM::Ring> > Rings;
+
+/**
+ * ring_name
+ * Names are unique to a node because they
+ * contain the pid of the first rank on the node.
+ *
+ * @param leader  the pid of the first rank on the node
+ * @param rank    the bootstrap rank that owns the ring
+ * @param type    "requests" or "responses"
+ * @return the name of the shared memory segment
+ */
+static std::string ring_name(const int leader, const int rank, const char *type) {
+    std::stringstream s;
+    s << "/hxhim-" << leader << "-" << rank << "-" << type;
+    return s.str();
+}
+
+/**
+ * all_ok
+ * Makes every rank on the node agree on whether or
+ * not a step succeeded. This also acts as a barrier.
+ *
+ * @param comm  the node communicator
+ * @param ok    whether or not this rank succeeded
+ * @return whether or not all ranks succeeded
+ */
+static bool all_ok(MPI_Comm comm, const bool ok) {
+    int local = ok;
+    int global = 0;
+    if (MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, comm) != MPI_SUCCESS) {
+        return false;
+    }
+
+    return global;
+}
+
+/**
+ * init
+ * Initializes the shared memory transport inside HXHIM
+ *     1. Every rank creates a response ring and every
+ *        range server also creates a request ring.
+ *     2. Range servers map the response rings of the
+ *        ranks on the same node and clients map the
+ *        request rings of the range servers on the
+ *        same node.
+ *     3. The names are unlinked once everyone has mapped
+ *        them, so the segments are removed as soon as
+ *        every rank has unmapped them.
+ * Ranks on other nodes are reached through MPI.
+ *
+ * @param hx             the HXHIM instance
+ * @param opts           the HXHIM options
+ * @return a new Transport, or nullptr on error
+ */
+Transport::Transport *Transport::SHM::init(hxhim_t *hx,
+                                           const std::size_t client_ratio,
+                                           const std::size_t server_ratio,
+                                           const std::set<int> &endpointgroup, // from config
+                                           Options *opts) {
+    mlog(SHM_INFO, "Starting Shared Memory Initialization");
+
+    // Do not allow MPI_COMM_NULL
+    if (hx->p->bootstrap.comm == MPI_COMM_NULL) {
+        return nullptr;
+    }
+
+    const int rank = hx->p->bootstrap.rank;
+    const int size = hx->p->bootstrap.size;
+
+    MPI_Comm node = MPI_COMM_NULL;
+    if (MPI_Comm_split_type(hx->p->bootstrap.comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node) != MPI_SUCCESS) {
+        mlog(SHM_ERR, "Could not find the ranks on this node");
+        return nullptr;
+    }
+
+    int node_size = 0;
+    MPI_Comm_size(node, &node_size);
+
+    // bootstrap ranks of the ranks on this node
+    std::vector<int> neighbors(node_size);
+    MPI_Allgather(&rank, 1, MPI_INT, neighbors.data(), 1, MPI_INT, node);
+
+    int leader = getpid();
+    MPI_Bcast(&leader, 1, MPI_INT, 0, node);
+
+    const bool is_rs = hxhim::RangeServer::is_range_server(rank, client_ratio, server_ratio);
+    const Reachable reachable(rank, size, client_ratio, server_ratio, endpointgroup);
+
+    // create the rings owned by this rank
+    std::shared_ptr<Ring> responses(Ring::create(ring_name(leader, rank, "responses"), opts->ring_size));
+    std::shared_ptr<Ring> requests;
+    if (is_rs) {
+        requests.reset(Ring::create(ring_name(leader, rank, "requests"), opts->ring_size));
+    }
+
+    if (!all_ok(node, responses && (!is_rs || requests))) {
+        mlog(SHM_ERR, "Could not create shared memory rings");
+        MPI_Comm_free(&node);
+        return nullptr;
+    }
+
+    // map the rings of the other ranks on this node
+    Rings servers;
+    Rings clients;
+    bool ok = true;
+    for(const int neighbor : neighbors) {
+        if (neighbor == rank) {
+            continue;
+        }
+
+        if (is_rs) {
+            Ring *ring = Ring::open(ring_name(leader, neighbor, "responses"));
+            ok &= (ring != nullptr);
+            clients[neighbor] = std::shared_ptr<Ring>(ring);
+        }
+
+        if (reachable(neighbor)) {
+            Ring *ring = Ring::open(ring_name(leader, neighbor, "requests"));
+            ok &= (ring != nullptr);
+            servers[neighbor] = std::shared_ptr<Ring>(ring);
+        }
+    }
+
+    ok = all_ok(node, ok);
+
+    // everyone has mapped the rings, so the names are no longer needed
+    responses->unlink();
+    if (requests) {
+        requests->unlink();
+    }
+
+    MPI_Comm_free(&node);
+
+    if (!ok) {
+        mlog(SHM_ERR, "Could not map shared memory rings");
+        return nullptr;
+    }
+
+    // ranks on other nodes use MPI
+    MPI::RangeServer *remote_rs = nullptr;
+    MPI::EndpointGroup *remote_eg = nullptr;
+    if (node_size < size) {
+        if (is_rs) {
+            remote_rs = construct<MPI::RangeServer>(hx, opts->listeners);
+        }
+
+        remote_eg = construct<MPI::EndpointGroup>(hx->p->bootstrap.comm,
+                                                  hx->p->running,
+                                                  hx->p->queues.max_per_request.size,
+                                                  reachable);
+    }
+
+    RangeServer *rs = nullptr;
+    if (is_rs) {
+        rs = construct<RangeServer>(hx, requests, clients, remote_rs);
+        mlog(SHM_INFO, "Created Shared Memory Range Server on rank %d", rank);
+    }
+
+    EndpointGroup *eg = construct<EndpointGroup>(rank, responses, servers, remote_eg, hx->p->running);
+
+    mlog(SHM_INFO, "Completed Shared Memory Initialization (%d of %d ranks on this node)", node_size, size);
+    return construct<Transport>(eg, rs);
+}
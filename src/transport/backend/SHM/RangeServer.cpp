@@ -0,0 +1,123 @@
+#include "hxhim/private/hxhim.hpp"
+#include "transport/backend/SHM/RangeServer.hpp"
+#include "transport/backend/local/RangeServer.hpp"
+#include "utils/Backoff.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+namespace Transport {
+namespace SHM {
+
+RangeServer::RangeServer(hxhim_t *hx,
+                         const std::shared_ptr<Ring> &requests,
+                         const std::unordered_map<int, std::shared_ptr<Ring> > &clients,
+                         MPI::RangeServer *remote)
+    : hx(hx),
+      requests(requests),
+      clients(clients),
+      remote(remote),
+      scheduled(hx->p->range_server.datastores.per_server, hx->p->range_server.schedule),
+      handler()
+{
+    handler = std::thread(&RangeServer::handler_thread, this);
+    mlog(SHM_INFO, "Started Shared Memory Range Server with %zu clients", clients.size());
+}
+
+RangeServer::~RangeServer() {
+    mlog(SHM_INFO, "Stopping Shared Memory Range Server");
+    handler.join();
+    destruct(remote);
+    mlog(SHM_INFO, "Shared Memory Range Server stopped");
+}
+
+/*
+ * handler_thread
+ * Function for the thread that drains the request ring
+ * An idle thread sleeps for longer and longer between checks.
+ */
+void RangeServer::handler_thread() {
+    Backoff backoff;
+    while (hx->p->running) {
+        requests->drain([this](const int src, void *data, const std::size_t len) {
+                schedule(src, data, len);
+            });
+
+        Message::Request::Request *request = nullptr;
+        if (scheduled.pop(request)) {
+            handle(request);
+            backoff.reset();
+        }
+        else {
+            backoff.wait();
+        }
+    }
+
+    // drop anything that was not processed
+    for(Message::Request::Request *request : scheduled.clear()) {
+        destruct(request);
+    }
+}
+
+/**
+ * schedule
+ * Unpacks one request directly from the ring
+ * and queues it to be processed
+ *
+ * @param src   the rank that sent the request
+ * @param data  the packed request
+ * @param len   the length of the packed request
+ */
+void RangeServer::schedule(const int src, void *data, const std::size_t len) {
+    Message::Request::Request *request = nullptr;
+    if (Message::Unpacker::unpack(&request, data, len) != MESSAGE_SUCCESS) {
+        mlog(SHM_WARN, "Could not unpack %zu byte request from %d", len, src);
+        return;
+    }
+
+    scheduled.push((std::size_t) request->dst, request->op, request);
+}
+
+/**
+ * handle
+ * Processes one request and sends the response back
+ *
+ * @param request the request (destroyed here)
+ */
+void RangeServer::handle(Message::Request::Request *request) {
+    Message::Response::Response *response = local::range_server(hx, request);
+    destruct(request);
+
+    if (!response) {
+        return;
+    }
+
+    std::unordered_map<int, std::shared_ptr<Ring> >::const_iterator it = clients.find(response->dst);
+    if (it == clients.end()) {
+        mlog(SHM_ERR, "Rank %d does not have a response ring", response->dst);
+        destruct(response);
+        return;
+    }
+
+    void *buf = nullptr;
+    std::size_t buf_len = 0;
+    const int packed = Message::Packer::pack(response, &buf, &buf_len);
+    destruct(response);
+
+    if (packed != MESSAGE_SUCCESS) {
+        mlog(SHM_WARN, "Could not pack response to %d", it->first);
+        dealloc(buf);
+        return;
+    }
+
+    // the client drains its response ring while it waits, so this will not deadlock
+    if (it->second->write(hx->p->bootstrap.rank, buf, buf_len, hx->p->running,
+                          []() -> bool { return false; }) != TRANSPORT_SUCCESS) {
+        mlog(SHM_ERR, "Could not push %zu byte response to %d", buf_len, it->first);
+    }
+
+    dealloc(buf);
+}
+
+}
+}
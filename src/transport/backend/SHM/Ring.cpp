@@ -0,0 +1,259 @@
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "transport/backend/SHM/Ring.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+namespace Transport {
+namespace SHM {
+
+const std::uint64_t Ring::WRAP = std::numeric_limits<std::uint64_t>::max();
+
+// fragments are aligned so that records never straddle the end of the ring
+static const std::size_t ALIGNMENT = 64;
+
+static std::size_t align(const std::size_t len) {
+    return ((len + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+}
+
+Ring::Ring(const std::string &name, void *mapping, const std::size_t mapping_size, const bool owner)
+    : name(name),
+      mapping(mapping),
+      mapping_size(mapping_size),
+      owner(owner),
+      header((Header *) mapping),
+      data(((char *) mapping) + header_size()),
+      partial()
+{}
+
+Ring::~Ring() {
+    if (owner) {
+        unlink();
+        pthread_mutex_destroy(&header->mutex);
+    }
+
+    munmap(mapping, mapping_size);
+}
+
+/**
+ * create
+ * Creates a new shared memory segment
+ * and initializes the ring inside it.
+ *
+ * @param name      the name of the segment (starts with '/')
+ * @param capacity  the number of bytes available for messages
+ * @return a new Ring, or nullptr on error
+ */
+Ring *Ring::create(const std::string &name, const std::size_t capacity) {
+    const std::size_t cap = align(capacity);
+    if (cap < (2 * record_size(1))) {
+        mlog(SHM_ERR, "Shared memory ring capacity %zu is too small", capacity);
+        return nullptr;
+    }
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        mlog(SHM_ERR, "Could not create shared memory segment %s: %s", name.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    const std::size_t mapping_size = header_size() + cap;
+    void *mapping = MAP_FAILED;
+    if (ftruncate(fd, mapping_size) == 0) {
+        mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        mlog(SHM_ERR, "Could not map shared memory segment %s: %s", name.c_str(), strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    Header *header = (Header *) mapping;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutex_init(&header->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    header->capacity = cap;
+    header->head = 0;
+    header->tail = 0;
+
+    return new Ring(name, mapping, mapping_size, true);
+}
+
+/**
+ * open
+ * Maps a shared memory segment that
+ * was created by another rank.
+ *
+ * @param name the name of the segment
+ * @return a new Ring, or nullptr on error
+ */
+Ring *Ring::open(const std::string &name) {
+    const int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        mlog(SHM_ERR, "Could not open shared memory segment %s: %s", name.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    struct stat st;
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &st) == 0) {
+        mapping = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        mlog(SHM_ERR, "Could not map shared memory segment %s: %s", name.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    return new Ring(name, mapping, st.st_size, false);
+}
+
+/**
+ * unlink
+ * Removes the name of the segment so that it is
+ * cleaned up once every rank has unmapped it.
+ * Only the creator of the segment can unlink it.
+ *
+ * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR
+ */
+int Ring::unlink() {
+    if (!owner || name.empty()) {
+        return TRANSPORT_ERROR;
+    }
+
+    const int rc = shm_unlink(name.c_str());
+    name.clear();
+    return (rc == 0)?TRANSPORT_SUCCESS:TRANSPORT_ERROR;
+}
+
+const std::string &Ring::Name() const {
+    return name;
+}
+
+std::size_t Ring::Capacity() const {
+    return header->capacity;
+}
+
+/**
+ * MaxFragment
+ * Fragments are limited to half of the ring so
+ * that a fragment always fits into an empty ring,
+ * even if it has to wrap around.
+ *
+ * @return the largest fragment that can be pushed
+ */
+std::size_t Ring::MaxFragment() const {
+    return ((header->capacity / 2) / ALIGNMENT) * ALIGNMENT - sizeof(Record);
+}
+
+/**
+ * push
+ * Copies one fragment into the ring.
+ * This does not wait for space.
+ *
+ * @param src   the rank pushing the fragment
+ * @param data  the fragment
+ * @param len   the length of the fragment (at most MaxFragment())
+ * @param more  whether or not the message continues in another fragment
+ * @return TRANSPORT_SUCCESS, or TRANSPORT_ERROR if there was not enough space
+ */
+int Ring::push(const int src, const void *data, const std::size_t len, const bool more) {
+    if (len > MaxFragment()) {
+        return TRANSPORT_ERROR;
+    }
+
+    const std::size_t need = record_size(len);
+
+    pthread_mutex_lock(&header->mutex);
+
+    const std::size_t cap = header->capacity;
+    std::size_t pos = header->tail % cap;
+    const std::size_t contiguous = cap - pos;
+    const std::size_t total = need + ((need > contiguous)?contiguous:0);
+
+    if ((header->tail - header->head + total) > cap) {
+        pthread_mutex_unlock(&header->mutex);
+        return TRANSPORT_ERROR;
+    }
+
+    // not enough room before the end of the ring, so skip to the front
+    if (need > contiguous) {
+        ((Record *) (this->data + pos))->len = WRAP;
+        header->tail += contiguous;
+        pos = 0;
+    }
+
+    Record *record = (Record *) (this->data + pos);
+    record->len = len;
+    record->src = src;
+    record->more = more;
+    memcpy(((char *) record) + sizeof(Record), data, len);
+    header->tail += need;
+
+    pthread_mutex_unlock(&header->mutex);
+    return TRANSPORT_SUCCESS;
+}
+
+std::size_t Ring::header_size() {
+    return align(sizeof(Header));
+}
+
+std::size_t Ring::record_size(const std::size_t len) {
+    return align(sizeof(Record) + len);
+}
+
+/**
+ * peek
+ * Gets the next fragment, skipping wrap markers.
+ * The fragment stays in the ring until pop is called.
+ *
+ * @param record where to place a pointer to the fragment
+ * @return whether or not a fragment was found
+ */
+bool Ring::peek(Record **record) {
+    pthread_mutex_lock(&header->mutex);
+
+    bool found = false;
+    while (header->head != header->tail) {
+        const std::size_t pos = header->head % header->capacity;
+        Record *curr = (Record *) (data + pos);
+        if (curr->len == WRAP) {
+            header->head += header->capacity - pos;
+            continue;
+        }
+
+        *record = curr;
+        found = true;
+        break;
+    }
+
+    pthread_mutex_unlock(&header->mutex);
+    return found;
+}
+
+/**
+ * pop
+ * Removes the fragment returned by peek
+ */
+void Ring::pop() {
+    pthread_mutex_lock(&header->mutex);
+    Record *curr = (Record *) (data + (header->head % header->capacity));
+    header->head += record_size(curr->len);
+    pthread_mutex_unlock(&header->mutex);
+}
+
+}
+}
@@ -0,0 +1,68 @@
+#include "transport/backend/SIM/EndpointGroup.hpp"
+
+namespace Transport {
+namespace SIM {
+
+EndpointGroup::EndpointGroup(const int rank,
+                             const std::shared_ptr<Network> &network,
+                             RangeServer &servers)
+  : ::Transport::EndpointGroup(),
+    rank(rank),
+    network(network),
+    servers(servers)
+{}
+
+EndpointGroup::~EndpointGroup() {}
+
+/**
+ * BPut
+ *
+ * @param bpm_list the list of BPUT messages to send
+ * @return a linked list of response messages, or nullptr
+ */
+Message::Response::BPut *EndpointGroup::communicate(const ReqList<Message::Request::BPut> &bpm_list) {
+    return return_msgs<Message::Response::BPut>(bpm_list);
+}
+
+/**
+ * BGet
+ *
+ * @param bgm_list the list of BGET messages to send
+ * @return a linked list of response messages, or nullptr
+ */
+Message::Response::BGet *EndpointGroup::communicate(const ReqList<Message::Request::BGet> &bgm_list) {
+    return return_msgs<Message::Response::BGet>(bgm_list);
+}
+
+/**
+ * BGetOp
+ *
+ * @param bgm_list the list of BGETOP messages to send
+ * @return a linked list of response messages, or nullptr
+ */
+Message::Response::BGetOp *EndpointGroup::communicate(const ReqList<Message::Request::BGetOp> &bgm_list) {
+    return return_msgs<Message::Response::BGetOp>(bgm_list);
+}
+
+/**
+ * BDelete
+ *
+ * @param bdm_list the list of BDEL messages to send
+ * @return a linked list of response messages, or nullptr
+ */
+Message::Response::BDelete *EndpointGroup::communicate(const ReqList<Message::Request::BDelete> &bdm_list) {
+    return return_msgs<Message::Response::BDelete>(bdm_list);
+}
+
+/**
+ * BHistogram
+ *
+ * @param bhm_list the list of BHISTOGRAM messages to send
+ * @return a linked list of response messages, or nullptr
+ */
+Message::Response::BHistogram *EndpointGroup::communicate(const ReqList<Message::Request::BHistogram> &bhm_list) {
+    return return_msgs<Message::Response::BHistogram>(bhm_list);
+}
+
+}
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "datastore/datastores.hpp"
+#include "hxhim/Datastore.hpp"
+#include "hxhim/RangeServer.hpp"
+#include "hxhim/private/hxhim.hpp"
+#include "transport/backend/SIM/SIM.hpp"
+#include "transport/transport.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+/**
+ * init
+ * Initializes the simulated transport inside HXHIM
+ *     1. This process is rank 0 of opts->ranks simulated
+ *        ranks (bootstrap.size has already been set).
+ *     2. Every other simulated rank that is a range server
+ *        gets its own set of datastores, which are run by
+ *        a shared pool of workers. Like real range servers,
+ *        they grant credits in their responses.
+ * Only this rank sends requests. The other simulated
+ * ranks only act as range servers.
+ *
+ * @param hx             the HXHIM instance
+ * @param opts           the HXHIM options
+ * @return a new Transport, or nullptr on error
+ */
+Transport::Transport *Transport::SIM::init(hxhim_t *hx,
+                                           const std::size_t client_ratio,
+                                           const std::size_t server_ratio,
+                                           const std::set<int> &,      // every simulated rank is reachable
+                                           Options *opts) {
+    mlog(SIM_INFO, "Starting Simulated Transport Initialization");
+
+    const int rank = hx->p->bootstrap.rank;
+    const int size = hx->p->bootstrap.size;
+
+    if ((rank != 0) || (size < 1) || ((std::size_t) size != opts->ranks)) {
+        mlog(SIM_ERR, "The simulated transport must be started by rank 0 of %zu simulated ranks", opts->ranks);
+        return nullptr;
+    }
+
+    std::shared_ptr<Network> network(construct<Network>(opts->ranks,
+                                                        opts->latency,
+                                                        opts->bandwidth,
+                                                        opts->jitter,
+                                                        opts->seed),
+                                     [](Network *network) { destruct(network); });
+
+    RangeServer *rs = construct<RangeServer>(hx, network, opts->workers);
+
+    std::size_t servers = 0;
+    for(int i = 1; i < size; i++) {
+        if (!hxhim::RangeServer::is_range_server(i, client_ratio, server_ratio)) {
+            continue;
+        }
+
+        int ds_id = hxhim::Datastore::get_id(i, 0, size,
+                                             client_ratio,
+                                             server_ratio,
+                                             hx->p->range_server.datastores.per_server);
+
+        std::vector<::Datastore::Datastore *> datastores(hx->p->range_server.datastores.per_server, nullptr);
+        for(::Datastore::Datastore *&ds : datastores) {
+            ds = ::Datastore::Init(hx,
+                                   ds_id++,
+                                   hx->p->range_server.datastores.config,
+                                   hxhim::init::transform(hx),
+                                   hx->p->histograms.config,
+                                   nullptr,
+                                   hx->p->range_server.datastores.open_init,
+                                   hx->p->histograms.read,
+                                   hx->p->histograms.write);
+            if (!ds) {
+                mlog(SIM_ERR, "Could not create datastore %d of simulated rank %d", ds_id - 1, i);
+                break;
+            }
+        }
+
+        // the range server cleans up the datastores, even on error
+        rs->AddServer(i, datastores);
+
+        if (std::find(datastores.begin(), datastores.end(), nullptr) != datastores.end()) {
+            destruct(rs);
+            return nullptr;
+        }
+
+        servers++;
+    }
+
+    EndpointGroup *eg = construct<EndpointGroup>(rank, network, *rs);
+
+    mlog(SIM_INFO, "Completed Simulated Transport Initialization (%zu simulated range servers)", servers);
+    return construct<Transport>(eg, rs);
+}
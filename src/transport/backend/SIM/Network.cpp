@@ -0,0 +1,81 @@
+#include <algorithm>
+
+#include "transport/backend/SIM/Network.hpp"
+
+namespace Transport {
+namespace SIM {
+
+/**
+ * mix
+ * splitmix64 finalizer
+ *
+ * @param x  the value to scramble
+ * @return a well distributed function of x
+ */
+static std::size_t mix(unsigned long long x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Network
+ *
+ * @param ranks      the number of simulated ranks
+ * @param latency    the one-way delay of every message (microseconds)
+ * @param bandwidth  the bytes per second of each link (0 is unlimited)
+ * @param jitter     the largest extra delay of a message (microseconds)
+ * @param seed       the seed of the jitter
+ */
+Network::Network(const std::size_t ranks,
+                 const std::size_t latency,
+                 const std::size_t bandwidth,
+                 const std::size_t jitter,
+                 const std::size_t seed)
+    : latency(latency),
+      bandwidth(bandwidth),
+      jitter(jitter),
+      seed(seed),
+      links(ranks),
+      mutex()
+{}
+
+/**
+ * send
+ *
+ * @param src  the rank sending the message
+ * @param dst  the rank receiving the message
+ * @param len  the size of the message
+ * @param id   identifies the message for the jitter
+ * @return when the message arrives at dst
+ */
+Network::Clock::time_point Network::send(const int src, const int dst, const std::size_t len, const std::size_t id) {
+    const Clock::time_point now = Clock::now();
+
+    std::chrono::nanoseconds transfer(0);
+    if (bandwidth) {
+        transfer = std::chrono::nanoseconds((unsigned long long) len * 1000000000ULL / bandwidth);
+    }
+
+    Clock::time_point end = now;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Link &out = links[src];
+        Link &in  = links[dst];
+
+        end = std::max(now, std::max(out.out, in.in)) + transfer;
+        out.out = end;
+        in.in = end;
+    }
+
+    std::chrono::microseconds delay = latency;
+    if (jitter) {
+        delay += std::chrono::microseconds(mix(seed ^ mix(id)) % (jitter + 1));
+    }
+
+    return end + delay;
+}
+
+}
+}
@@ -0,0 +1,273 @@
+#include "hxhim/private/hxhim.hpp"
+#include "transport/backend/SIM/RangeServer.hpp"
+#include "transport/backend/local/RangeServer.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+namespace Transport {
+namespace SIM {
+
+bool RangeServer::Arrival::operator>(const Arrival &rhs) const {
+    return time > rhs.time;
+}
+
+RangeServer::Server::Server(const std::vector<::Datastore::Datastore *> &datastores,
+                            const std::size_t per_server,
+                            const SchedulePolicies &policies)
+    : datastores(datastores),
+      scheduled(per_server, policies),
+      grants(),
+      busy(false)
+{}
+
+RangeServer::RangeServer(hxhim_t *hx,
+                         const std::shared_ptr<Network> &network,
+                         const std::size_t workers)
+    : hx(hx),
+      network(network),
+      servers(),
+      arrivals(),
+      ready(),
+      stop(false),
+      mutex(),
+      cv(),
+      workers()
+{
+    for(std::size_t i = 0; i < (workers?workers:1); i++) {
+        this->workers.emplace_back(&RangeServer::worker_thread, this);
+    }
+
+    mlog(SIM_INFO, "Started %zu Simulated Range Server workers", this->workers.size());
+}
+
+RangeServer::~RangeServer() {
+    mlog(SIM_INFO, "Stopping Simulated Range Servers");
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    // drop anything that was not processed
+    while (arrivals.size()) {
+        dealloc(arrivals.top().data);
+        arrivals.pop();
+    }
+
+    for(decltype(servers)::value_type &server : servers) {
+        for(Pending &pending : server.second->scheduled.clear()) {
+            destruct(pending.request);
+        }
+
+        for(::Datastore::Datastore *&ds : server.second->datastores) {
+            if (ds) {
+                ds->Close(hx->p->histograms.write);
+                delete ds;
+                ds = nullptr;
+            }
+        }
+    }
+
+    mlog(SIM_INFO, "Simulated Range Servers stopped");
+}
+
+/**
+ * AddServer
+ *
+ * @param rank        the simulated rank of the range server
+ * @param datastores  the datastores of the range server
+ */
+void RangeServer::AddServer(const int rank, const std::vector<::Datastore::Datastore *> &datastores) {
+    std::lock_guard<std::mutex> lock(mutex);
+    servers[rank].reset(new Server(datastores,
+                                   hx->p->range_server.datastores.per_server,
+                                   hx->p->range_server.schedule));
+    servers[rank]->grants.budget(hx->p->range_server.credits.bytes,
+                                 hx->p->range_server.credits.ops);
+}
+
+/**
+ * Has
+ * Servers are only added during initialization,
+ * so this does not lock.
+ *
+ * @param rank the simulated rank
+ * @return whether or not rank has a simulated range server
+ */
+bool RangeServer::Has(const int rank) const {
+    return servers.find(rank) != servers.end();
+}
+
+/**
+ * deliver
+ * Every delivered request gets exactly one response
+ * in the inbox, even if it cannot be processed.
+ *
+ * @param rank     the simulated rank of the range server
+ * @param arrival  when the request arrives
+ * @param data     the packed request (owned by this object)
+ * @param len      the length of the packed request
+ * @param inbox    where to place the response
+ */
+void RangeServer::deliver(const int rank, const Network::Clock::time_point &arrival,
+                          void *data, const std::size_t len, Inbox *inbox) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        arrivals.push(Arrival{arrival, rank, data, len, inbox});
+    }
+    cv.notify_all();
+}
+
+/**
+ * worker_thread
+ * Moves requests that have arrived into their range
+ * servers and processes the next request of a range
+ * server that is not busy. Idle workers sleep until
+ * the next request arrives.
+ */
+void RangeServer::worker_thread() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+        arrive(lock);
+
+        if (ready.size()) {
+            const int rank = ready.front();
+            ready.pop_front();
+
+            Server &server = *servers.at(rank);
+            Pending pending;
+            if (!server.scheduled.pop(pending)) {
+                continue;
+            }
+
+            server.busy = true;
+            lock.unlock();
+
+            handle(rank, server, pending);
+
+            lock.lock();
+            server.busy = false;
+            if (server.scheduled.size()) {
+                ready.push_back(rank);
+            }
+            continue;
+        }
+
+        if (arrivals.size()) {
+            cv.wait_until(lock, arrivals.top().time);
+        }
+        else {
+            cv.wait(lock);
+        }
+    }
+}
+
+/**
+ * arrive
+ * Unpacks the requests whose arrival time has passed
+ * into the Scheduler of their range server.
+ *
+ * @param lock the lock on mutex, which is held
+ */
+void RangeServer::arrive(std::unique_lock<std::mutex> &lock) {
+    const Network::Clock::time_point now = Network::Clock::now();
+
+    std::list<Arrival> arrived;
+    while (arrivals.size() && (arrivals.top().time <= now)) {
+        arrived.push_back(arrivals.top());
+        arrivals.pop();
+    }
+
+    if (!arrived.size()) {
+        return;
+    }
+
+    // unpack without blocking the other workers
+    lock.unlock();
+
+    std::list<std::pair<int, Pending> > unpacked;
+    for(Arrival &arrival : arrived) {
+        Message::Request::Request *request = nullptr;
+        if (Message::Unpacker::unpack(&request, arrival.data, arrival.len) != MESSAGE_SUCCESS) {
+            mlog(SIM_WARN, "Could not unpack %zu byte request to %d", arrival.len, arrival.rank);
+        }
+        dealloc(arrival.data);
+
+        if (!request) {
+            reply(arrival.rank, nullptr, nullptr, arrival.inbox);
+            continue;
+        }
+
+        unpacked.emplace_back(arrival.rank, Pending{request, arrival.inbox});
+    }
+
+    lock.lock();
+
+    for(std::pair<int, Pending> const &pending : unpacked) {
+        Server &server = *servers.at(pending.first);
+        const bool idle = !server.busy && !server.scheduled.size();
+        server.scheduled.push((std::size_t) pending.second.request->dst, pending.second.request->op, pending.second);
+        if (idle) {
+            ready.push_back(pending.first);
+        }
+    }
+}
+
+/**
+ * handle
+ * Processes one request and sends the response back
+ *
+ * @param rank     the simulated rank of the range server
+ * @param server   the range server
+ * @param pending  the request (destroyed here) and where to reply
+ */
+void RangeServer::handle(const int rank, Server &server, const Pending &pending) {
+    Message::Response::Response *response = local::range_server(hx, server.datastores, pending.request);
+    server.grants.issue(pending.request->src, response);
+    reply(rank, pending.request, response, pending.inbox);
+    destruct(pending.request);
+}
+
+/**
+ * reply
+ * Packs the response and places it in the inbox
+ * with the time that it arrives at the client.
+ *
+ * @param rank      the simulated rank of the range server
+ * @param request   the request being replied to (may be nullptr)
+ * @param response  the response (destroyed here; may be nullptr)
+ * @param inbox     where to place the response
+ */
+void RangeServer::reply(const int rank, const Message::Request::Request *request,
+                        Message::Response::Response *response, Inbox *inbox) {
+    Inbox::Response packed{Network::Clock::now(), nullptr, 0};
+
+    if (response) {
+        if (Message::Packer::pack(response, &packed.data, &packed.len) == MESSAGE_SUCCESS) {
+            packed.arrival = network->send(rank, request->src, packed.len, 2 * request->seq + 1);
+        }
+        else {
+            mlog(SIM_WARN, "Could not pack response from %d", rank);
+            dealloc(packed.data);
+            packed.data = nullptr;
+            packed.len = 0;
+        }
+
+        destruct(response);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(inbox->mutex);
+        inbox->responses.emplace_back(packed);
+    }
+    inbox->cv.notify_all();
+}
+
+}
+}
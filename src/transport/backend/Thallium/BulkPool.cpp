@@ -0,0 +1,139 @@
+#include <utility>
+
+#include "transport/backend/Thallium/BulkPool.hpp"
+#include "utils/memory.hpp"
+#include "utils/mlog2.h"
+#include "utils/mlogfacs2.h"
+
+const std::size_t Transport::Thallium::BulkPool::MIN_SIZE;
+const std::size_t Transport::Thallium::BulkPool::MAX_SIZE;
+const std::size_t Transport::Thallium::BulkPool::MAX_FREE;
+
+// number of powers of 2 from MIN_SIZE to MAX_SIZE
+const std::size_t Transport::Thallium::BulkPool::MAX_CLASSES = Transport::Thallium::BulkPool::size_class(Transport::Thallium::BulkPool::MAX_SIZE) + 1;
+
+Transport::Thallium::BulkPool::BulkPool(thallium::engine *engine)
+    : engine(engine),
+      free(MAX_CLASSES),
+      mutex()
+{}
+
+Transport::Thallium::BulkPool::~BulkPool() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for(std::vector<Region *> &regions : free) {
+        for(Region *region : regions) {
+            destroy(region);
+        }
+        regions.clear();
+    }
+}
+
+/**
+ * reserve
+ * Registers regions ahead of time so that
+ * the first requests do not have to.
+ *
+ * @param size   the size of the regions
+ * @param count  the number of regions to register
+ */
+void Transport::Thallium::BulkPool::reserve(const std::size_t size, const std::size_t count) {
+    std::vector<Region *> regions;
+    for(std::size_t i = 0; i < count; i++) {
+        regions.push_back(acquire(size));
+    }
+
+    for(Region *region : regions) {
+        release(region);
+    }
+}
+
+/**
+ * acquire
+ * Gets an idle region from the size class of size,
+ * registering a new region only if there are none.
+ *
+ * @param size the minimum number of bytes needed
+ * @return a region, or nullptr on error
+ */
+Transport::Thallium::BulkPool::Region *Transport::Thallium::BulkPool::acquire(const std::size_t size) {
+    const std::size_t sc = size_class(size);
+    if (sc >= MAX_CLASSES) {
+        mlog(THALLIUM_DBG, "Registering unpooled %zu byte region", size);
+        return create(size, MAX_CLASSES);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Region *> &regions = free[sc];
+        if (regions.size()) {
+            Region *region = regions.back();
+            regions.pop_back();
+            return region;
+        }
+    }
+
+    return create(MIN_SIZE << sc, sc);
+}
+
+/**
+ * release
+ * Keeps the region for reuse unless there are
+ * already enough idle regions in its size class.
+ *
+ * @param region the region to return
+ */
+void Transport::Thallium::BulkPool::release(Region *region) {
+    if (!region) {
+        return;
+    }
+
+    if (region->size_class < MAX_CLASSES) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Region *> &regions = free[region->size_class];
+        if (regions.size() < MAX_FREE) {
+            regions.push_back(region);
+            return;
+        }
+    }
+
+    destroy(region);
+}
+
+/**
+ * size_class
+ *
+ * @param size the number of bytes needed
+ * @return the index of the smallest size class that can hold size bytes
+ */
+std::size_t Transport::Thallium::BulkPool::size_class(const std::size_t size) {
+    std::size_t sc = 0;
+    std::size_t capacity = MIN_SIZE;
+    while (capacity < size) {
+        capacity <<= 1;
+        sc++;
+    }
+
+    return sc;
+}
+
+Transport::Thallium::BulkPool::Region *Transport::Thallium::BulkPool::create(const std::size_t capacity, const std::size_t size_class) {
+    void *buf = alloc(capacity);
+    if (!buf) {
+        return nullptr;
+    }
+
+    std::vector<std::pair<void *, std::size_t> > segments = {std::make_pair(buf, capacity)};
+
+    Region *region = construct<Region>();
+    region->buf = buf;
+    region->capacity = capacity;
+    region->size_class = size_class;
+    region->bulk = engine->expose(segments, thallium::bulk_mode::read_write);
+    return region;
+}
+
+void Transport::Thallium::BulkPool::destroy(Region *region) {
+    void *buf = region->buf;
+    destruct(region);          // deregister before freeing the memory
+    dealloc(buf);
+}
@@ -1,14 +1,16 @@
-#ifdef ASYNC_THALLIUM
-#include <future>
 #include <list>
-#endif
-
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <thallium/serialization/stl/string.hpp>
+#include <thallium/serialization/stl/vector.hpp>
+
 #include "transport/backend/Thallium/EndpointGroup.hpp"
 #include "transport/backend/Thallium/Utilities.hpp"
+#include "utils/Backoff.hpp"
 #include "utils/macros.hpp"
 #include "utils/memory.hpp"
 #include "utils/mlog2.h"
@@ -16,102 +18,147 @@
 #include "utils/type_traits.hpp"
 
 Transport::Thallium::EndpointGroup::EndpointGroup(thallium::engine *engine,
-                                                  RangeServer *rs)
+                                                  RangeServer *rs,
+                                                  const std::shared_ptr<AddressBook> &addresses,
+                                                  const Reachable &reachable,
+                                                  const std::size_t cache_size)
     : ::Transport::EndpointGroup(),
       engine(engine),
       rs(rs),
-      endpoints()
+      addresses(addresses),
+      reachable(reachable),
+      endpoints(cache_size,
+                [this](const int rank, Endpoint &ep) -> bool {
+                    return resolve(rank, ep);
+                }),
+      releases()
 {}
 
 Transport::Thallium::EndpointGroup::~EndpointGroup() {
-    for(decltype(endpoints)::value_type const ep : endpoints) {
-        destruct(ep.second);
-    }
+    // endpoints have to be released before the engine is finalized
+    endpoints.clear();
     engine->finalize();
     destruct(engine);
 }
 
 /**
  * AddID
- * Add a mapping from a unique ID to a thalllium address.
+ * Add a mapping from a rank to a thalllium address.
  *
- * @param id       the unique ID associated with the rank
+ * @param rank     the rank of the other end
  * @param address  the address of the other end
  * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR
  */
-int Transport::Thallium::EndpointGroup::AddID(const int id, const std::string &address) {
-    return AddID(id, construct<thallium::endpoint>(engine->lookup(address)));
+int Transport::Thallium::EndpointGroup::AddID(const int rank, const std::string &address) {
+    return AddID(rank, construct<thallium::endpoint>(engine->lookup(address)));
 }
 
 /**
  * AddID
- * Add a mapping from a unique ID to a MPI rank
+ * Add a mapping from a rank to an endpoint
  * Thallium::EndpointGroup takes ownership of ep
  *     - If ep is null, nothing is done
  *       and TRANSPORT_ERROR is returned
- *     - If there is already an endpoint at id,
- *       the endpoint is destroyed
+ *     - If there is already an endpoint for
+ *       rank, it is replaced
  *
- * @param id the unique ID associated with the rank
- * @param ep the other end
+ * @param rank the rank of the other end
+ * @param ep   the other end
  * @return TRANSPORT_SUCCESS or TRANSPORT_ERROR
  */
-int Transport::Thallium::EndpointGroup::AddID(const int id, thallium::endpoint *ep) {
+int Transport::Thallium::EndpointGroup::AddID(const int rank, thallium::endpoint *ep) {
     if (!ep) {
         return TRANSPORT_ERROR;
     }
 
-    RemoveID(id);
-    endpoints[id] = ep;
+    endpoints.put(rank, Endpoint(ep, destruct<thallium::endpoint>));
     return TRANSPORT_SUCCESS;
 }
 
 /**
  * RemoveID
- * Remove a mapping from a unique ID to a rank
- * If the unique ID is not found, nothing is done
+ * Remove the endpoint of a rank
+ * If the rank is not found, nothing is done
  *
- * @param id the unique ID to remove
+ * @param rank the rank to remove
  */
-void Transport::Thallium::EndpointGroup::RemoveID(const int id) {
-    decltype(endpoints)::const_iterator rm = endpoints.find(id);
-    if (rm != endpoints.end()) {
-        destruct(rm->second);
-        endpoints.erase(rm);
+void Transport::Thallium::EndpointGroup::RemoveID(const int rank) {
+    endpoints.erase(rank);
+}
+
+/**
+ * resolve
+ * Looks up the address of a range server in the
+ * address book and converts it into an endpoint.
+ *
+ * @param rank  the rank of the range server
+ * @param ep    where to place the endpoint
+ * @return whether or not the endpoint was found
+ */
+bool Transport::Thallium::EndpointGroup::resolve(const int rank, Endpoint &ep) {
+    std::string address;
+    if (!reachable(rank) || !addresses || !addresses->get(rank, address)) {
+        return false;
     }
+
+    try {
+        ep = Endpoint(construct<thallium::endpoint>(engine->lookup(address)), destruct<thallium::endpoint>);
+    }
+    catch (const thallium::exception &e) {
+        mlog(THALLIUM_WARN, "Could not look up %s (rank %d): %s", address.c_str(), rank, e.what());
+        return false;
+    }
+
+    mlog(THALLIUM_DBG, "Looked up Thallium endpoint %s for rank %d", address.c_str(), rank);
+    return true;
 }
 
 /**
- * process request
- * Does the client side of a single remote send/receive operation
- * All arguments after messages are members of Thallium::EndpointGroup
+ * Pending
+ * A request whose RPC has been forwarded
+ * but whose response has not been handled
  *
- * @tparam Recv_t      Receive type; listed first to allow for Send_t to be deduced by the compiler
- * @tparam Send_t      Send type
- * @tparam (unnamed)   test to make sure the rest of the template makes sense
- * @param messages     the list of messages to send
- * @param engine       the thallium engine
- * @param rpc          the thallium rpc
- * @param buffer_size  the size of the buffer allocated for sending and receiving packets
- * @param endpoints    the endpoint to send to
- * @return The list of responses received
+ * @tparam Send_t the request type
  */
-template <typename Recv_t, typename Send_t,
-          typename = enable_if_t<std::is_base_of<Message::Request::Request,   Send_t>::value &&
-                                 std::is_base_of<Message::Response::Response, Recv_t>::value> >
-inline Recv_t *process_request(Send_t *req,
-                               thallium::engine *engine,
-                               Transport::Thallium::RangeServer *rs,
-                               const std::unordered_map<int, thallium::endpoint *> &endpoints) {
-    // if (!req || !engine || !rs || !endpoint) {
-    //     return nullptr;
-    // }
+template <typename Send_t>
+struct Pending {
+    Pending(Send_t *req, const Transport::Thallium::Endpoint &ep, Transport::Thallium::BulkPool::Region *req_region)
+        : req(req),
+          ep(ep),
+          req_region(req_region),
+          response()
+    {}
+
+    Send_t *req;
+    Transport::Thallium::Endpoint ep;
+    Transport::Thallium::BulkPool::Region *req_region;  // must stay alive until the response arrives (nullptr if sent inline)
+    std::unique_ptr<thallium::async_response> response;
+};
 
+/**
+ * start_request
+ * Packs a request and forwards it without waiting for the response
+ *
+ * @tparam Send_t      Send type
+ * @param req          the request to send
+ * @param rs           the range server (where the rpcs are defined)
+ * @param endpoints    cache of endpoints
+ * @param releases     response leases to acknowledge
+ * @param pending      where to place the forwarded request
+ * @return whether or not the request was forwarded
+ */
+template <typename Send_t,
+          typename = enable_if_t<std::is_base_of<Message::Request::Request, Send_t>::value> >
+bool start_request(Send_t *req,
+                   Transport::Thallium::RangeServer *rs,
+                   Transport::Thallium::Endpoints &endpoints,
+                   Transport::Thallium::Releases &releases,
+                   std::list<Pending<Send_t> > &pending) {
     // figure out where to send the message
-    REF(endpoints)::const_iterator dst_it = endpoints.find(req->dst_rank);
-    if (dst_it == endpoints.end()) {
-        mlog(THALLIUM_WARN, "Could not find endpoint for destination rank %d", req->dst);
-        return nullptr;
+    Transport::Thallium::Endpoint ep;
+    if (!endpoints.get(req->dst_rank, ep)) {
+        mlog(THALLIUM_WARN, "Could not find endpoint for destination rank %d", req->dst_rank);
+        return false;
     }
 
     mlog(THALLIUM_DBG, "Request is going to range server %d", req->dst);
@@ -120,45 +167,107 @@ inline Recv_t *process_request(Send_t *req,
 
     mlog(THALLIUM_DBG, "Packing request going to range server %d", req->dst);
 
-    // pack the request
+    // pack the request directly into where it will be sent from
     req->timestamps.transport.pack.start = ::Stats::now();
+    const std::size_t req_size = req->size();
+    std::string inline_req;
+    Transport::Thallium::BulkPool::Region *req_region = nullptr;
     void *req_buf = nullptr;
-    std::size_t req_size = 0;
-    if (Message::Packer::pack(req, &req_buf, &req_size) != MESSAGE_SUCCESS) {
+    if (req_size <= rs->EagerSize()) {
+        // small requests are sent inside of the RPC
+        inline_req.resize(req_size);
+        req_buf = &inline_req[0];
+    }
+    else {
+        // large requests are pulled from a registered region
+        req_region = rs->Pool().acquire(req_size);
+        req_buf = req_region?req_region->buf:nullptr;
+    }
+
+    std::size_t packed_size = 0;
+    if (!req_buf || (Message::Packer::pack(req, &req_buf, &packed_size) != MESSAGE_SUCCESS)) {
         mlog(THALLIUM_WARN, "Unable to pack message");
-        dealloc(req_buf);
-        return nullptr;
+        rs->Pool().release(req_region);
+        return false;
     }
     req->timestamps.transport.pack.end = ::Stats::now();
 
-    mlog(THALLIUM_DBG, "Sending packed request (%zu bytes) to %d", req_size, req->dst);
+    mlog(THALLIUM_DBG, "Forwarding packed request (%zu bytes) to %d", req_size, req->dst);
 
-    // expose req_buf through bulk
-    std::vector<std::pair<void *, std::size_t> > req_segments = {std::make_pair(req_buf, req_size)};
-    thallium::bulk req_bulk = engine->expose(req_segments, thallium::bulk_mode::read_write);
+    pending.emplace_back(req, ep, req_region);
+    Pending<Send_t> &p = pending.back();
 
-    // send request_size and request
-    // get back packed response_size, response, and remote address
+    // acknowledge the responses that have already been pulled from this range server
+    std::vector<uintptr_t> released;
+    {
+        std::lock_guard<std::mutex> lock(releases.mutex);
+        released.swap(releases.addrs[req->dst_rank]);
+    }
+
+    // send request_size and request without waiting
     req->timestamps.transport.send_start = ::Stats::now(); // store the value in req for now
-    thallium::packed_response packed_res = rs->process().on(*(dst_it->second))(req_size, req_bulk);
+    p.response.reset(new thallium::async_response(rs->process().on(*(p.ep)).async(req_size, inline_req,
+                                                                                  req_region?req_region->bulk:thallium::bulk(),
+                                                                                  released)));
+
+    return true;
+}
+
+/**
+ * finish_request
+ * Handles the response of a request that has arrived
+ *
+ * @tparam Recv_t      Receive type; listed first to allow for Send_t to be deduced by the compiler
+ * @tparam Send_t      Send type
+ * @param p            the forwarded request
+ * @param pool         registered regions
+ * @param releases     where to record response leases that need to be acknowledged
+ * @return the response, or nullptr on error
+ */
+template <typename Recv_t, typename Send_t,
+          typename = enable_if_t<std::is_base_of<Message::Request::Request,   Send_t>::value &&
+                                 std::is_base_of<Message::Response::Response, Recv_t>::value> >
+Recv_t *finish_request(Pending<Send_t> &p,
+                       Transport::Thallium::BulkPool &pool,
+                       Transport::Thallium::Releases &releases) {
+    Send_t *req = p.req;
+
+    // get back packed response_size, response, and remote address
+    thallium::packed_response packed_res = p.response->wait();
     req->timestamps.transport.recv_end = ::Stats::now();   // store the value in req for now
 
-    dealloc(req_buf);
+    pool.release(p.req_region);
+    p.req_region = nullptr;
 
     // unpack thallium::packed_response
     std::size_t res_size;
+    std::string inline_res;
     thallium::bulk res_bulk;
     uintptr_t res_ptr;
-    std::tie(res_size, res_bulk, res_ptr) = packed_res.as<std::size_t, thallium::bulk, uintptr_t> ();
+    std::tie(res_size, inline_res, res_bulk, res_ptr) = packed_res.as<std::size_t, std::string, thallium::bulk, uintptr_t> ();
 
     mlog(THALLIUM_DBG, "Received %zu byte response from %d", res_size, req->dst);
 
-    // read the data out of the response bulk
-    void *res_buf = alloc(res_size);
-    std::vector<std::pair<void *, std::size_t> > res_segments = {
-        std::make_pair((void *) res_buf, res_size)};
-    thallium::bulk local = engine->expose(res_segments, thallium::bulk_mode::write_only);
-    res_bulk.on(*(dst_it->second)) >> local;
+    // the server can free its copy of the response when it receives the next request
+    if (res_ptr) {
+        std::lock_guard<std::mutex> lock(releases.mutex);
+        releases.addrs[req->dst_rank].push_back(res_ptr);
+    }
+
+    // small responses arrive with the RPC
+    void *res_buf = (void *) inline_res.data();
+    Transport::Thallium::BulkPool::Region *res_region = nullptr;
+    if (inline_res.size() != res_size) {
+        res_region = pool.acquire(res_size);
+        if (!res_region) {
+            mlog(THALLIUM_WARN, "Could not get a %zu byte region for the response", res_size);
+            return nullptr;
+        }
+
+        // read the data out of the response bulk
+        res_bulk.on(*(p.ep)) >> res_region->bulk.select(0, res_size);
+        res_buf = res_region->buf;
+    }
 
     // unpack the response
     mlog(THALLIUM_DBG, "Unpacking %zu byte response from %d", res_size, req->dst);
@@ -166,13 +275,12 @@ inline Recv_t *process_request(Send_t *req,
     req->timestamps.transport.unpack.start = ::Stats::now(); // store the value in req for now
     Recv_t *response = nullptr;
     const int unpack_rc = Message::Unpacker::unpack(&response, res_buf, res_size);
-    dealloc(res_buf);
+    pool.release(res_region);
     req->timestamps.transport.unpack.end = ::Stats::now(); // store the value in req for now
 
-    // clean up server pointer before handling any errors
+    // leases are acknowledged with the next request, so there is no cleanup rpc
     req->timestamps.transport.cleanup_rpc.start = ::Stats::now(); // store the value in req for now
-    rs->cleanup().on(*(dst_it->second))(res_ptr);
-    req->timestamps.transport.cleanup_rpc.end = ::Stats::now(); // store the value in req for now
+    req->timestamps.transport.cleanup_rpc.end = req->timestamps.transport.cleanup_rpc.start;
 
     if (unpack_rc != MESSAGE_SUCCESS) {
         mlog(THALLIUM_WARN, "Unable to unpack message");
@@ -187,6 +295,12 @@ inline Recv_t *process_request(Send_t *req,
         return nullptr;
     }
 
+    if (response->seq != req->seq) {
+        mlog(THALLIUM_WARN, "Response %zu from %d does not match request %zu", response->seq, req->dst, req->seq);
+        destruct(response);
+        return nullptr;
+    }
+
     response->steal_timestamps(req, true);
 
     return response;
@@ -194,37 +308,31 @@ inline Recv_t *process_request(Send_t *req,
 
 /**
  * process requests
- * Sends off all requests provided
+ * Forwards all requests provided from this thread without
+ * waiting, and then handles the responses as they arrive,
+ * so sending to N range servers costs about one round trip.
  * All arguments after messages are members of Thallium::EndpointGroup
  *
  * @tparam Recv_t      Receive type; listed first to allow for Send_t to be deduced by the compiler
  * @tparam Send_t      Send type
  * @tparam (unnamed)   test to make sure the rest of the template makes sense
  * @param messages     the list of messages to send
- * @param engine       the thallium engine
- * @param rpc          the thallium rpc
- * @param buffer_size  the size of the buffer allocated for sending and receiving packets
- * @param endpoints    list of endpoints
+ * @param rs           the range server (where the rpcs are defined)
+ * @param endpoints    cache of endpoints
+ * @param releases     response leases to acknowledge
  * @return The list of responses received
  */
 template <typename Recv_t, typename Send_t,
           typename = enable_if_t<std::is_base_of<Message::Request::Request,   Send_t>::value &&
                                  std::is_base_of<Message::Response::Response, Recv_t>::value> >
 Recv_t *process_requests(const Transport::ReqList<Send_t> &messages,
-                         thallium::engine *engine,
                          Transport::Thallium::RangeServer *rs,
-                         const std::unordered_map<int, thallium::endpoint *> &endpoints) {
-    int rank = -1;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-
+                         Transport::Thallium::Endpoints &endpoints,
+                         Transport::Thallium::Releases &releases) {
     mlog(THALLIUM_INFO, "Sending %zu requests", messages.size());
 
-    #ifdef ASYNC_THALLIUM
-    std::list<std::future<Recv_t *> > futures;
-    #endif
-
-    Recv_t *head = nullptr;
-    Recv_t *tail = nullptr;
+    // forward everything first
+    std::list<Pending<Send_t> > pending;
     for(REF(messages)::value_type const &message : messages) {
         Send_t *req = message.second;
         if (!req) {
@@ -233,30 +341,42 @@ Recv_t *process_requests(const Transport::ReqList<Send_t> &messages,
         }
 
         mlog(THALLIUM_DBG, "Sending request to %d", req->dst);
-
-    #ifdef ASYNC_THALLIUM
-        futures.emplace_back(std::async(std::launch::async,
-                                        process_request<Recv_t, Send_t>,
-                                        req, engine, rs, std::cref(endpoints)));
-
-        mlog(THALLIUM_DBG, "Done sending request to %d", req->dst);
+        start_request(req, rs, endpoints, releases, pending);
     }
 
-    for(std::future<Recv_t *> &future : futures) {
-        Recv_t *response = future.get();
-    #else
-        Recv_t *response = process_request<Recv_t, Send_t>(req, engine, rs, endpoints);
-    #endif
-
-        mlog(THALLIUM_DBG, "Received response from %d", response->src);
-        if (response) {
-            if (!head) {
-                head = response;
+    // complete the requests in the order that the responses arrive
+    Recv_t *head = nullptr;
+    Recv_t *tail = nullptr;
+    Backoff backoff;
+    while (pending.size()) {
+        bool progressed = false;
+        for(typename std::list<Pending<Send_t> >::iterator it = pending.begin(); it != pending.end();) {
+            if (!it->response->received()) {
+                it++;
+                continue;
             }
-            else {
-                tail->next = response;
+
+            Recv_t *response = finish_request<Recv_t>(*it, rs->Pool(), releases);
+            it = pending.erase(it);
+            progressed = true;
+
+            if (response) {
+                mlog(THALLIUM_DBG, "Received response from %d", response->src);
+                if (!head) {
+                    head = response;
+                }
+                else {
+                    tail->next = response;
+                }
+                tail = response;
             }
-            tail = response;
+        }
+
+        if (progressed) {
+            backoff.reset();
+        }
+        else {
+            backoff.wait();
         }
     }
 
@@ -272,7 +392,7 @@ Recv_t *process_requests(const Transport::ReqList<Send_t> &messages,
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BPut *Transport::Thallium::EndpointGroup::communicate(const ReqList<Message::Request::BPut> &bpm_list) {
-    return process_requests<Message::Response::BPut>(bpm_list, engine, rs, endpoints);
+    return process_requests<Message::Response::BPut>(bpm_list, rs, endpoints, releases);
 }
 
 /**
@@ -283,7 +403,7 @@ Message::Response::BPut *Transport::Thallium::EndpointGroup::communicate(const R
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BGet *Transport::Thallium::EndpointGroup::communicate(const ReqList<Message::Request::BGet> &bgm_list) {
-    return process_requests<Message::Response::BGet>(bgm_list, engine, rs, endpoints);
+    return process_requests<Message::Response::BGet>(bgm_list, rs, endpoints, releases);
 }
 
 /**
@@ -294,7 +414,7 @@ Message::Response::BGet *Transport::Thallium::EndpointGroup::communicate(const R
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BGetOp *Transport::Thallium::EndpointGroup::communicate(const ReqList<Message::Request::BGetOp> &bgm_list) {
-    return process_requests<Message::Response::BGetOp>(bgm_list, engine, rs, endpoints);
+    return process_requests<Message::Response::BGetOp>(bgm_list, rs, endpoints, releases);
 }
 
 /**
@@ -305,7 +425,7 @@ Message::Response::BGetOp *Transport::Thallium::EndpointGroup::communicate(const
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BDelete *Transport::Thallium::EndpointGroup::communicate(const ReqList<Message::Request::BDelete> &bdm_list) {
-    return process_requests<Message::Response::BDelete>(bdm_list, engine, rs, endpoints);
+    return process_requests<Message::Response::BDelete>(bdm_list, rs, endpoints, releases);
 }
 
 /**
@@ -316,5 +436,5 @@ Message::Response::BDelete *Transport::Thallium::EndpointGroup::communicate(cons
  * @return a linked list of response messages, or nullptr
  */
 Message::Response::BHistogram *Transport::Thallium::EndpointGroup::communicate(const ReqList<Message::Request::BHistogram> &bhm_list) {
-    return process_requests<Message::Response::BHistogram>(bhm_list, engine, rs, endpoints);
+    return process_requests<Message::Response::BHistogram>(bhm_list, rs, endpoints, releases);
 }
@@ -1,14 +1,19 @@
-#include <map>
+#include <memory>
 
 #include "hxhim/private/accessors.hpp"
 #include "hxhim/private/hxhim.hpp"
 #include "hxhim/RangeServer.hpp"
+#include "transport/AddressBook.hpp"
+#include "transport/Reachable.hpp"
 #include "transport/backend/Thallium/Thallium.hpp"
 #include "utils/Stats.hpp"
 #include "utils/memory.hpp"
 #include "utils/mlog2.h"
 #include "utils/mlogfacs2.h"
 
+// number of regions registered ahead of time for full requests
+static const std::size_t BULK_REGIONS = 4;
+
 /**
  * init
  * Initializes Thallium inside HXHIM
@@ -53,16 +58,24 @@ Transport::Transport *Transport::Thallium::init(hxhim_t *hx,
     // Range server is always created, even if this rank is not a range server
     // because RPC function signatures are needed. Datastores are not tied to
     // range servers, so it should not matter that there are extra range servers.
-    RangeServer *rs = construct<RangeServer>(hx, engine);
+    RangeServer *rs = construct<RangeServer>(hx, engine, opts->eager_size, opts->xstreams_per_datastore);
+
+    // register the regions full requests will be sent from before the first flush
+    if (hx->p->queues.max_per_request.size > opts->eager_size) {
+        rs->Pool().reserve(hx->p->queues.max_per_request.size, BULK_REGIONS);
+    }
 
     #if PRINT_TIMESTAMPS
     ::Stats::Chronostamp thallium_addrs;
     thallium_addrs.start = ::Stats::now();
     #endif
 
-    // get a mapping of ranks to thallium addresses
-    std::map<int, std::string> addrs;
-    if (get_addrs(hx->p->bootstrap.comm, *engine, addrs) != TRANSPORT_SUCCESS) {
+    // node leaders exchange the addresses of the range servers
+    // endpoints are looked up when they are first used
+    std::shared_ptr<AddressBook> addresses = std::make_shared<AddressBook>(hx->p->bootstrap.comm,
+                                                                           static_cast<std::string>(engine->self()),
+                                                                           hxhim::RangeServer::is_range_server(rank, client_ratio, server_ratio));
+    if (!addresses->Valid()) {
         delete rs;
         return nullptr;
     }
@@ -72,26 +85,11 @@ Transport::Transport *Transport::Thallium::init(hxhim_t *hx,
     #endif
 
     // the EndpointGroup that will be stored
-    EndpointGroup *eg = construct<EndpointGroup>(engine, rs);
-
-    // logical
-    int rs_id = 0;
-
-    // create mapping between logical ids and endpoints
-    for(decltype(addrs)::value_type const &addr : addrs) {
-        if (hxhim::RangeServer::is_range_server(addr.first, client_ratio, server_ratio)) {
-            if (rank != addr.first) { // skip adding the local range server
-                // if the rank was specified as part of the endpoint group,
-                // add the thallium endpoint to the endpoint group
-                if (!endpointgroup.size() || (endpointgroup.find(addr.first) != endpointgroup.end())) {
-                    eg->AddID(rs_id, addr.second);
-                    mlog(THALLIUM_DBG, "Added Thallium endpoint %s to the endpoint group", addr.second.c_str());
-                }
-            }
-
-            rs_id++;
-        }
-    }
+    EndpointGroup *eg = construct<EndpointGroup>(engine, rs, addresses,
+                                                 Reachable(rank, hx->p->bootstrap.size,
+                                                           client_ratio, server_ratio,
+                                                           endpointgroup),
+                                                 hx->p->transport.endpoint_cache);
 
     mlog(THALLIUM_INFO, "Rank %d Completed Thallium transport initialization", rank);
     #if PRINT_TIMESTAMPS
@@ -1,9 +1,12 @@
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <thallium/serialization/stl/string.hpp>
+#include <thallium/serialization/stl/vector.hpp>
 
 #include "hxhim/accessors.hpp"
+#include "hxhim/private/hxhim.hpp"
 #include "transport/backend/Thallium/RangeServer.hpp"
 #include "transport/backend/local/RangeServer.hpp"
 #include "utils/memory.hpp"
@@ -11,34 +14,75 @@
 #include "utils/mlogfacs2.h"
 
 const std::string Transport::Thallium::RangeServer::PROCESS_RPC_NAME = "process";
-const std::string Transport::Thallium::RangeServer::CLEANUP_RPC_NAME = "cleanup";
 
-Transport::Thallium::RangeServer::RangeServer(hxhim_t *hx, thallium::engine *engine)
+Transport::Thallium::RangeServer::DatastorePool::DatastorePool(const SchedulePolicies &policies)
+    : pool(thallium::pool::create(thallium::pool::access::mpmc)),
+      scheduled(1, policies),
+      mutex()
+{}
+
+Transport::Thallium::RangeServer::RangeServer(hxhim_t *hx, thallium::engine *engine,
+                                              const std::size_t eager_size,
+                                              const std::size_t xstreams_per_datastore)
     : hx(hx),
       engine(engine),
       rank(-1),
+      eager_size(eager_size),
+      pool(engine),
       process_rpc(engine->define(PROCESS_RPC_NAME,
                                  [this](const thallium::request &req,
                                         const std::size_t req_len,
-                                        thallium::bulk &bulk) {
-                                     return this->process(req, req_len, bulk);
+                                        const std::string &inline_req,
+                                        thallium::bulk &bulk,
+                                        const std::vector<uintptr_t> &released) {
+                                     return this->process(req, req_len, inline_req, bulk, released);
                                  }
                       )
 
           ),
-      cleanup_rpc(engine->define(CLEANUP_RPC_NAME,
-                                 [this](const thallium::request &req,
-                                        uintptr_t addr) {
-                                     return this->cleanup(req, addr);
-                                 }
-                      ).disable_response()
-          )
+      leases(),
+      leases_mutex(),
+      pools(),
+      xstreams()
 {
     hxhim::nocheck::GetMPI(hx, nullptr, &rank, nullptr);
-    mlog(THALLIUM_INFO, "Initialized Thallium Range Server on rank %d", rank);
+
+    if (xstreams_per_datastore) {
+        // ranks without datastores do not get pools
+        const std::size_t datastores = hx->p->range_server.datastores.ds.size();
+        for(std::size_t i = 0; i < datastores; i++) {
+            pools.emplace_back(new DatastorePool(hx->p->range_server.schedule));
+            for(std::size_t j = 0; j < xstreams_per_datastore; j++) {
+                xstreams.emplace_back(thallium::xstream::create(thallium::scheduler::predef::deflt, *(pools.back()->pool)));
+            }
+        }
+    }
+
+    mlog(THALLIUM_INFO, "Initialized Thallium Range Server on rank %d with %zu datastore pools", rank, pools.size());
 }
 
 Transport::Thallium::RangeServer::~RangeServer() {
+    // finish the requests that have already been queued
+    for(thallium::managed<thallium::xstream> &xstream : xstreams) {
+        xstream->join();
+    }
+    xstreams.clear();
+
+    for(std::unique_ptr<DatastorePool> &dp : pools) {
+        for(Queued &queued : dp->scheduled.clear()) {
+            destruct(queued.req);
+            destruct(queued.request);
+        }
+    }
+    pools.clear();
+
+    // responses that were never acknowledged
+    std::lock_guard<std::mutex> lock(leases_mutex);
+    for(const uintptr_t addr : leases) {
+        pool.release((BulkPool::Region *) addr);
+    }
+    leases.clear();
+
     mlog(THALLIUM_INFO, "Stopped Thallium Range Server on rank %d", rank);
 }
 
@@ -46,37 +90,123 @@ const thallium::remote_procedure &Transport::Thallium::RangeServer::process() co
     return process_rpc;
 }
 
-const thallium::remote_procedure &Transport::Thallium::RangeServer::cleanup() const {
-    return cleanup_rpc;
+std::size_t Transport::Thallium::RangeServer::EagerSize() const {
+    return eager_size;
+}
+
+Transport::Thallium::BulkPool &Transport::Thallium::RangeServer::Pool() {
+    return pool;
+}
+
+/**
+ * release
+ * Returns response regions that a client has finished
+ * pulling to the pool. Addresses that were not leased
+ * are ignored.
+ *
+ * @param released the addresses of the response regions
+ */
+void Transport::Thallium::RangeServer::release(const std::vector<uintptr_t> &released) {
+    std::lock_guard<std::mutex> lock(leases_mutex);
+    for(const uintptr_t addr : released) {
+        if (leases.erase(addr)) {
+            pool.release((BulkPool::Region *) addr);
+        }
+    }
 }
 
-void Transport::Thallium::RangeServer::process(const thallium::request &req, const std::size_t req_len, thallium::bulk &bulk) {
+void Transport::Thallium::RangeServer::process(const thallium::request &req,
+                                               const std::size_t req_len,
+                                               const std::string &inline_req,
+                                               thallium::bulk &bulk,
+                                               const std::vector<uintptr_t> &released) {
     thallium::endpoint ep = req.get_endpoint();
     mlog(THALLIUM_INFO, "Rank %d RangeServer Starting to process data from %s", rank, ((std::string) ep).c_str());
 
-    void *req_buf = alloc(req_len);
+    // acknowledgements piggybacked on this request
+    release(released);
 
-    // receive request
-    {
-        std::vector<std::pair<void *, std::size_t> > segments = {std::make_pair(req_buf, req_len)};
-        thallium::bulk local = engine->expose(segments, thallium::bulk_mode::write_only);
-        bulk.on(ep) >> local;
+    // small requests arrive with the RPC
+    void *req_buf = (void *) inline_req.data();
+    BulkPool::Region *req_region = nullptr;
+    if (inline_req.size() != req_len) {
+        req_region = pool.acquire(req_len);
+        if (!req_region) {
+            req.respond((std::size_t) 0, std::string(), thallium::bulk(), (uintptr_t) 0);
+            mlog(THALLIUM_WARN, "Could not get a %zu byte region for the request", req_len);
+            return;
+        }
+
+        // receive request
+        bulk.on(ep) >> req_region->bulk.select(0, req_len);
+        req_buf = req_region->buf;
     }
 
     mlog(THALLIUM_DBG, "Rank %d RangeServer Receieved %zu byte request", rank, req_len);
 
     // unpack the request
     Message::Request::Request *request = nullptr;
-    if (Message::Unpacker::unpack(&request, req_buf, req_len) != MESSAGE_SUCCESS) {
-        dealloc(req_buf);
-        req.respond((std::size_t) 0, thallium::bulk());
+    const int unpacked = Message::Unpacker::unpack(&request, req_buf, req_len);
+    pool.release(req_region);
+
+    if (unpacked != MESSAGE_SUCCESS) {
+        req.respond((std::size_t) 0, std::string(), thallium::bulk(), (uintptr_t) 0);
         mlog(THALLIUM_WARN, "Could not unpack request");
         return;
     }
-    dealloc(req_buf);
 
     mlog(THALLIUM_DBG, "Rank %d RangeServer Unpacked %zu bytes of %s request", rank, req_len, HXHIM_OP_STR[request->op]);
 
+    // queue the request with the other requests to the same datastore
+    if (pools.size()) {
+        DatastorePool &dp = *pools[request->dst % pools.size()];
+        {
+            std::lock_guard<std::mutex> lock(dp.mutex);
+            dp.scheduled.push(0, request->op, {construct<thallium::request>(req), request});
+        }
+
+        // every queued request gets a thread, but the thread
+        // processes whichever request should go next
+        dp.pool->make_thread([this, &dp]() {
+                                 run(dp);
+                             },
+                             thallium::anonymous());
+        return;
+    }
+
+    respond(req, request);
+}
+
+/**
+ * run
+ * Processes the next scheduled request of a datastore
+ *
+ * @param dp the pool of the datastore
+ */
+void Transport::Thallium::RangeServer::run(DatastorePool &dp) {
+    Queued queued;
+    {
+        std::lock_guard<std::mutex> lock(dp.mutex);
+        if (!dp.scheduled.pop(queued)) {
+            return;
+        }
+    }
+
+    respond(*queued.req, queued.request);
+    destruct(queued.req);
+}
+
+/**
+ * respond
+ * Processes an unpacked request and sends the
+ * response back through the RPC that carried it.
+ *
+ * @param req      the RPC the request arrived in
+ * @param request  the request (destroyed here)
+ */
+void Transport::Thallium::RangeServer::respond(const thallium::request &req, Message::Request::Request *request) {
+    thallium::endpoint ep = req.get_endpoint();
+
     // process the request
     mlog(THALLIUM_DBG, "Rank %d Sending %s to Local RangeServer", rank, HXHIM_OP_STR[request->op]);
     Message::Response::Response *response = local::range_server(hx, request);
@@ -84,29 +214,51 @@ void Transport::Thallium::RangeServer::process(const thallium::request &req, con
 
     mlog(THALLIUM_DBG, "Rank %d Local RangeServer responded with %s response", rank, HXHIM_OP_STR[response->op]);
 
-    // pack the response
-    std::size_t res_len = 0;
+    // pack the response directly into where it will be sent from
+    const std::size_t res_len = response->size();
+    std::string inline_res;
+    BulkPool::Region *res_region = nullptr;
     void *res_buf = nullptr;
-    Message::Packer::pack(response, &res_buf, &res_len);     // do not check for error
+    if (res_len <= eager_size) {
+        inline_res.resize(res_len);
+        res_buf = &inline_res[0];
+    }
+    else {
+        res_region = pool.acquire(res_len);
+        res_buf = res_region?res_region->buf:nullptr;
+    }
+
+    std::size_t packed_len = 0;
+    if (!res_buf || (Message::Packer::pack(response, &res_buf, &packed_len) != MESSAGE_SUCCESS)) {
+        pool.release(res_region);
+        destruct(response);
+        req.respond((std::size_t) 0, std::string(), thallium::bulk(), (uintptr_t) 0);
+        mlog(THALLIUM_WARN, "Could not pack %zu byte response", res_len);
+        return;
+    }
+
     mlog(THALLIUM_DBG, "Rank %d RangeServer Responding with %zu byte %s response", rank, res_len, HXHIM_OP_STR[response->op]);
     destruct(response);
 
     mlog(THALLIUM_DBG, "Rank %d RangeServer Packed response into %zu byte buffer", rank, res_len);
 
     // send the response
-    {
-        std::vector<std::pair<void *, std::size_t> > segments = {std::make_pair(res_buf, res_len)};
-        thallium::bulk local = engine->expose(segments, thallium::bulk_mode::read_only);
-        req.respond(res_len, local, (uintptr_t) res_buf);
+    if (!res_region) {
+        // small responses are returned with the RPC
+        req.respond(res_len, inline_res, thallium::bulk(), (uintptr_t) 0);
+    }
+    else {
+        // res_region is leased to the client until it acknowledges the response
+        // since reusing it here would overwrite data the other side has not pulled
+        {
+            std::lock_guard<std::mutex> lock(leases_mutex);
+            leases.insert((uintptr_t) res_region);
+        }
+
+        req.respond(res_len, std::string(), res_region->bulk, (uintptr_t) res_region);
     }
 
     mlog(THALLIUM_DBG, "Rank %d RangeServer Done sending %zu byte packed response", rank, res_len);
 
     mlog(THALLIUM_INFO, "Rank %d RangeServer Done processing request from %s and sending response", rank, ((std::string) ep).c_str());
 }
-
-void Transport::Thallium::RangeServer::cleanup(const thallium::request &, uintptr_t addr) {
-    // res_buf is cleaned up here
-    // since freeing in process will result in the other side given access to freed memory
-    dealloc((void *) addr);
-}
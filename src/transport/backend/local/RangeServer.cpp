@@ -11,7 +11,26 @@
 namespace Transport {
 namespace local {
 
+/**
+ * range_server
+ * Runs a request from a client against the datastores
+ * of this rank. Requests from other ranks get the
+ * current grant of their client in their response.
+ *
+ * @param hx   pointer to the main HXHIM struct
+ * @param req  the request packet to operate on
+ * @return     the response packet resulting from the request
+ */
 Message::Response::Response *range_server(hxhim_t *hx, Message::Request::Request *req) {
+    Message::Response::Response *res = range_server(hx, hx->p->range_server.datastores.ds, req);
+    if (req->src != hx->p->bootstrap.rank) {
+        hx->p->range_server.grants.issue(req->src, res);
+    }
+
+    return res;
+}
+
+Message::Response::Response *range_server(hxhim_t *hx, std::vector<::Datastore::Datastore *> &datastores, Message::Request::Request *req) {
     int rank = -1;
     hxhim::nocheck::GetMPI(hx, nullptr, &rank, nullptr);
 
@@ -22,19 +41,19 @@ Message::Response::Response *range_server(hxhim_t *hx, Message::Request::Request
     // Call the appropriate function depending on the message type
     switch(req->op) {
         case hxhim_op_t::HXHIM_PUT:
-            res = range_server<Message::Response::BPut>(hx, static_cast<Message::Request::BPut *>(req));
+            res = range_server<Message::Response::BPut>(hx, datastores, static_cast<Message::Request::BPut *>(req));
             break;
         case hxhim_op_t::HXHIM_GET:
-            res = range_server<Message::Response::BGet>(hx, static_cast<Message::Request::BGet *>(req));
+            res = range_server<Message::Response::BGet>(hx, datastores, static_cast<Message::Request::BGet *>(req));
             break;
         case hxhim_op_t::HXHIM_GETOP:
-            res = range_server<Message::Response::BGetOp>(hx, static_cast<Message::Request::BGetOp *>(req));
+            res = range_server<Message::Response::BGetOp>(hx, datastores, static_cast<Message::Request::BGetOp *>(req));
             break;
         case hxhim_op_t::HXHIM_DELETE:
-            res = range_server<Message::Response::BDelete>(hx, static_cast<Message::Request::BDelete *>(req));
+            res = range_server<Message::Response::BDelete>(hx, datastores, static_cast<Message::Request::BDelete *>(req));
             break;
         case hxhim_op_t::HXHIM_HISTOGRAM:
-            res = range_server<Message::Response::BHistogram>(hx, static_cast<Message::Request::BHistogram *>(req));
+            res = range_server<Message::Response::BHistogram>(hx, datastores, static_cast<Message::Request::BHistogram *>(req));
             break;
         default:
             break;
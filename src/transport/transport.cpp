@@ -35,7 +35,8 @@ Transport::RangeServer::~RangeServer() {}
 
 Transport::Transport::Transport(EndpointGroup *epg, RangeServer *rs)
     : endpointgroup_(nullptr),
-      rangeserver_(nullptr)
+      rangeserver_(nullptr),
+      seq_(1)
 {
     SetEndpointGroup(epg);
     SetRangeServer(rs);
@@ -78,7 +79,7 @@ void Transport::Transport::SetRangeServer(RangeServer *rs) {
  */
 Message::Response::BPut *
 Transport::Transport::communicate(const ReqList<Message::Request::BPut> &bpm_list) {
-    return (bpm_list.size() && endpointgroup_)?endpointgroup_->communicate(bpm_list):nullptr;
+    return (bpm_list.size() && endpointgroup_)?endpointgroup_->communicate(sequence(bpm_list)):nullptr;
 }
 
 /**
@@ -91,7 +92,7 @@ Transport::Transport::communicate(const ReqList<Message::Request::BPut> &bpm_lis
  */
 Message::Response::BGet *
 Transport::Transport::communicate(const ReqList<Message::Request::BGet> &bgm_list) {
-    return (bgm_list.size() && endpointgroup_)?endpointgroup_->communicate(bgm_list):nullptr;
+    return (bgm_list.size() && endpointgroup_)?endpointgroup_->communicate(sequence(bgm_list)):nullptr;
 }
 
 /**
@@ -104,7 +105,7 @@ Transport::Transport::communicate(const ReqList<Message::Request::BGet> &bgm_lis
  */
 Message::Response::BGetOp *
 Transport::Transport::communicate(const ReqList<Message::Request::BGetOp> &bgm_list) {
-    return (bgm_list.size() && endpointgroup_)?endpointgroup_->communicate(bgm_list):nullptr;
+    return (bgm_list.size() && endpointgroup_)?endpointgroup_->communicate(sequence(bgm_list)):nullptr;
 }
 
 /**
@@ -117,7 +118,7 @@ Transport::Transport::communicate(const ReqList<Message::Request::BGetOp> &bgm_l
  */
 Message::Response::BDelete *
 Transport::Transport::communicate(const ReqList<Message::Request::BDelete> &bdm_list) {
-    return (bdm_list.size() && endpointgroup_)?endpointgroup_->communicate(bdm_list):nullptr;
+    return (bdm_list.size() && endpointgroup_)?endpointgroup_->communicate(sequence(bdm_list)):nullptr;
 }
 
 /**
@@ -130,5 +131,5 @@ Transport::Transport::communicate(const ReqList<Message::Request::BDelete> &bdm_
  */
 Message::Response::BHistogram *
 Transport::Transport::communicate(const ReqList<Message::Request::BHistogram> &bhm_list) {
-    return (bhm_list.size() && endpointgroup_)?endpointgroup_->communicate(bhm_list):nullptr;
+    return (bhm_list.size() && endpointgroup_)?endpointgroup_->communicate(sequence(bhm_list)):nullptr;
 }
@@ -10,6 +10,11 @@ int ::Transport::init(hxhim_t *hx,
     int ret = TRANSPORT_SUCCESS; // can't check hx->p->transport because it will be
                                  // nullptr when transport type is TRANSPORT_NULL
 
+    // clients receive their grants in responses, so nothing is exchanged
+    // set before the range server starts so that every response has a grant
+    hx->p->range_server.grants.budget(hx->p->range_server.credits.bytes,
+                                      hx->p->range_server.credits.ops);
+
     switch (opts->type) {
         case TRANSPORT_NULL:
             // hash has already been set to SUM_MOD_LOCAL_DATASTORES
@@ -24,6 +29,24 @@ int ::Transport::init(hxhim_t *hx,
                 ret = TRANSPORT_ERROR;
             }
             break;
+        case TRANSPORT_SHM:
+            if (!(hx->p->transport.transport = SHM::init(hx,
+                                                         client_ratio,
+                                                         server_ratio,
+                                                         endpointgroup,
+                                                         static_cast<SHM::Options *>(opts)))) {
+                ret = TRANSPORT_ERROR;
+            }
+            break;
+        case TRANSPORT_SIM:
+            if (!(hx->p->transport.transport = SIM::init(hx,
+                                                         client_ratio,
+                                                         server_ratio,
+                                                         endpointgroup,
+                                                         static_cast<SIM::Options *>(opts)))) {
+                ret = TRANSPORT_ERROR;
+            }
+            break;
         #if HXHIM_HAVE_THALLIUM
         case TRANSPORT_THALLIUM:
             if (!(hx->p->transport.transport = Thallium::init(hx,
@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <thread>
+
+#include "utils/Backoff.hpp"
+
+Backoff::Backoff(const std::size_t spins,
+                 const std::chrono::microseconds &min,
+                 const std::chrono::microseconds &max)
+    : spins(spins),
+      min(min),
+      max((max < min)?min:max),
+      idle(0),
+      sleep(min)
+{}
+
+/**
+ * reset
+ * Go back to spinning after progress was made
+ */
+void Backoff::reset() {
+    idle = 0;
+    sleep = min;
+}
+
+/**
+ * wait
+ * Delay the caller after a poll that made no progress.
+ * Spins first, then yields once, then sleeps, doubling
+ * the sleep time after each call until it reaches max.
+ */
+void Backoff::wait() {
+    if (idle < spins) {
+        idle++;
+        return;
+    }
+
+    if (idle == spins) {
+        idle++;
+        std::this_thread::yield();
+        return;
+    }
+
+    std::this_thread::sleep_for(sleep);
+    sleep = std::min(sleep * 2, max);
+}
+
+/**
+ * delay
+ *
+ * @return how long the next call to wait will sleep
+ */
+std::chrono::microseconds Backoff::delay() const {
+    if (idle <= spins) {
+        return std::chrono::microseconds::zero();
+    }
+
+    return sleep;
+}
@@ -160,7 +160,8 @@ Histogram::Histogram::Histogram()
       count_(0),
       buckets_(nullptr),
       counts_(nullptr),
-      size_(0)
+      size_(0),
+      mutex_()
 {}
 
 Histogram::Histogram::Histogram(const Config &config, const std::string &name)
@@ -172,7 +173,8 @@ Histogram::Histogram::Histogram(const Config &config, const std::string &name)
       count_(0),
       buckets_(nullptr),
       counts_(nullptr),
-      size_(0)
+      size_(0),
+      mutex_()
 {}
 
 Histogram::Histogram::Histogram(const Config *config, const std::string &name)
@@ -201,6 +203,8 @@ Histogram::Histogram::~Histogram() {
  * @return HISTOGRAM_SUCCESS or HISTOGRAM_ERROR
  */
 int Histogram::Histogram::add(const double &value) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     // limit has not been hit
     if (count_ < first_n_) {
         cache_[count_] = value;
@@ -280,6 +284,8 @@ int Histogram::Histogram::get_name(const char **name, std::size_t *name_len) con
 int Histogram::Histogram::get_cache(std::size_t *first_n,
                                     double **cache,
                                     std::size_t *size) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (first_n) {
         *first_n = first_n_;
     }
@@ -308,6 +314,8 @@ int Histogram::Histogram::get_cache(std::size_t *first_n,
  * @return HISTOGRAM_SUCCESS or HISTOGRAM_ERROR if the buckets have not been generated yet
  */
 int Histogram::Histogram::get(double **buckets, std::size_t **counts, std::size_t *size) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (count_  < first_n_) {
         return HISTOGRAM_ERROR;
     }
@@ -336,6 +344,8 @@ int Histogram::Histogram::get(double **buckets, std::size_t **counts, std::size_
  * @return size
  */
 std::size_t Histogram::Histogram::pack_size() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     std::size_t total =
         sizeof(name_.size()) + name_.size() +
         sizeof(count_) + sizeof(first_n_) +
@@ -364,6 +374,8 @@ std::size_t Histogram::Histogram::pack_size() const {
  * @return true on success, false on error
  */
 bool Histogram::Histogram::pack(void **buf, std::size_t *size) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (!buf || !size) {
         return false;
     }
@@ -391,6 +403,8 @@ bool Histogram::Histogram::pack(void **buf, std::size_t *size) const {
  * @return true on success, false on error
  */
 bool Histogram::Histogram::pack(char *&curr, std::size_t &avail, std::size_t *used) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (!curr || (avail < pack_size())) {
         return false;
     }
@@ -466,6 +480,8 @@ bool Histogram::Histogram::unpack(const void *buf, const std::size_t size) {
  * @return true on success, false on error
  */
 bool Histogram::Histogram::unpack(char *&curr, std::size_t &size, std::size_t *used) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (!curr ||
         (size < (4 * sizeof(std::size_t)))) {
         return false;
@@ -530,6 +546,8 @@ bool Histogram::Histogram::unpack(char *&curr, std::size_t &size, std::size_t *u
  * the first n values.
  */
 void Histogram::Histogram::clear() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     first_n_ = 0;
     count_ = 0;
 
@@ -543,6 +561,8 @@ void Histogram::Histogram::clear() {
 }
 
 std::ostream &Histogram::Histogram::print(std::ostream &stream, const std::string &indent) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     stream << indent << "Histogram has " << count_ << " values" << std::endl;
     if (size_) {
         for(std::size_t i = 0; i < size_; i++) {
@@ -0,0 +1,78 @@
+#include "utils/RWLock.hpp"
+
+RWLock::RWLock()
+    : mutex(),
+      cv(),
+      readers(0),
+      writers(0),
+      writing(false)
+{}
+
+/**
+ * lock
+ * Waits until no one else holds the lock
+ */
+void RWLock::lock() {
+    std::unique_lock<std::mutex> lock(mutex);
+    writers++;
+    cv.wait(lock,
+            [this]() -> bool {
+                return !writing && !readers;
+            });
+    writers--;
+    writing = true;
+}
+
+void RWLock::unlock() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        writing = false;
+    }
+    cv.notify_all();
+}
+
+/**
+ * lock_shared
+ * Waits until no writer holds or is waiting for the lock
+ */
+void RWLock::lock_shared() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock,
+            [this]() -> bool {
+                return !writing && !writers;
+            });
+    readers++;
+}
+
+void RWLock::unlock_shared() {
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        last = !--readers;
+    }
+
+    if (last) {
+        cv.notify_all();
+    }
+}
+
+RWLock::Guard::Guard(RWLock &rwlock, const Mode mode)
+    : rwlock(rwlock),
+      mode(mode)
+{
+    if (mode == EXCLUSIVE) {
+        rwlock.lock();
+    }
+    else {
+        rwlock.lock_shared();
+    }
+}
+
+RWLock::Guard::~Guard() {
+    if (mode == EXCLUSIVE) {
+        rwlock.unlock();
+    }
+    else {
+        rwlock.unlock_shared();
+    }
+}
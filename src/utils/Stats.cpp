@@ -34,6 +34,113 @@ long double Stats::sec(const Stats::Chronostamp &duration) {
     return Stats::sec(duration.start, duration.end);
 }
 
+const std::size_t Stats::Distribution::SUB_BITS;
+const std::size_t Stats::Distribution::SUB_BUCKETS;
+const std::size_t Stats::Distribution::BUCKETS;
+
+Stats::Distribution::Distribution()
+    : count_(0),
+      sum_(0),
+      buckets()
+{}
+
+/**
+ * add
+ * Counters are only summed, so relaxed
+ * atomics are enough
+ *
+ * @param value  the value to add
+ */
+void Stats::Distribution::add(const uint64_t value) {
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    buckets[index(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Stats::Distribution::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t Stats::Distribution::sum() const {
+    return sum_.load(std::memory_order_relaxed);
+}
+
+uint64_t Stats::Distribution::bucket(const std::size_t i) const {
+    return (i < BUCKETS)?buckets[i].load(std::memory_order_relaxed):0;
+}
+
+/**
+ * quantile
+ * Values being added while the buckets are walked
+ * might not be counted.
+ *
+ * @param q  the fraction of values, between 0 and 1
+ * @return the upper bound of the bucket containing the quantile, or 0 if there are no values
+ */
+uint64_t Stats::Distribution::quantile(const double q) const {
+    const uint64_t total = count();
+    if (!total) {
+        return 0;
+    }
+
+    // at least one value has to be seen
+    uint64_t target = (uint64_t) (q * total);
+    if (target < 1) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for(std::size_t i = 0; i < BUCKETS; i++) {
+        seen += bucket(i);
+        if (seen >= target) {
+            return upper(i);
+        }
+    }
+
+    return upper(BUCKETS - 1);
+}
+
+/**
+ * index
+ * Values smaller than SUB_BUCKETS get their own bucket.
+ * Larger values are bucketed by their most significant
+ * bit and the SUB_BITS bits that follow it.
+ *
+ * @param value  the value
+ * @return the index of the bucket that value falls in
+ */
+std::size_t Stats::Distribution::index(const uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+
+    std::size_t msb = 0;
+    for(uint64_t v = value; v >>= 1;) {
+        msb++;
+    }
+
+    const std::size_t shift = msb - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t Stats::Distribution::lower(const std::size_t i) {
+    if (i < SUB_BUCKETS) {
+        return i;
+    }
+
+    const std::size_t shift = i / SUB_BUCKETS - 1;
+    return ((uint64_t) (SUB_BUCKETS + (i % SUB_BUCKETS))) << shift;
+}
+
+uint64_t Stats::Distribution::upper(const std::size_t i) {
+    if (i < SUB_BUCKETS) {
+        return i;
+    }
+
+    const std::size_t shift = i / SUB_BUCKETS - 1;
+    return lower(i) + ((((uint64_t) 1) << shift) - 1);
+}
+
 /**
  * print_event
  * Print a single timestamp since the epoch in the format
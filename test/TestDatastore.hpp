@@ -26,7 +26,7 @@ class TestDatastore : public Datastore::Datastore {
             event.time.start = ::Stats::now();
             event.count = 1;
             event.time.end = event.time.start + PUT_TIME;
-            stats.puts.emplace_back(event);
+            AddEvent(stats.puts, event);
 
             Message::Response::BPut *res = construct<Message::Response::BPut>(req->count);
             res->count = req->count;
@@ -41,7 +41,7 @@ class TestDatastore : public Datastore::Datastore {
             event.time.start = ::Stats::now();
             event.count = 1;
             event.time.end = event.time.start + GET_TIME;
-            stats.gets.emplace_back(event);
+            AddEvent(stats.gets, event);
 
             return nullptr;
         }
@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "datastore/BPlusTree.hpp"
+
+typedef std::map<std::string, std::string> Map;
+
+// check every record, every bound, and both directions of iteration
+static void compare(const Datastore::BPlusTree &tree, const Map &expected) {
+    ASSERT_EQ(tree.size(), expected.size());
+    EXPECT_EQ(tree.empty(), expected.empty());
+
+    // forwards
+    Datastore::BPlusTree::const_iterator it = tree.begin();
+    for(Map::value_type const &record : expected) {
+        ASSERT_NE(it, tree.end());
+        EXPECT_EQ((std::string) it->first, record.first);
+        EXPECT_EQ((std::string) it->second, record.second);
+        it++;
+    }
+    EXPECT_EQ(it, tree.end());
+
+    // backwards
+    for(Map::const_reverse_iterator rit = expected.rbegin(); rit != expected.rend(); rit++) {
+        it--;
+        ASSERT_NE(it, tree.end());
+        EXPECT_EQ((std::string) it->first, rit->first);
+    }
+    EXPECT_EQ(it, tree.begin());
+
+    // bounds
+    for(Map::value_type const &record : expected) {
+        ASSERT_NE(tree.find(record.first), tree.end());
+        EXPECT_EQ((std::string) tree.find(record.first)->second, record.second);
+
+        const std::string before = record.first.substr(0, record.first.size() - 1);
+        Map::const_iterator lower = expected.lower_bound(before);
+        Datastore::BPlusTree::const_iterator tree_lower = tree.lower_bound(before);
+        ASSERT_NE(tree_lower, tree.end());
+        EXPECT_EQ((std::string) tree_lower->first, lower->first);
+
+        Map::const_iterator upper = expected.upper_bound(record.first);
+        Datastore::BPlusTree::const_iterator tree_upper = tree.upper_bound(record.first);
+        if (upper == expected.end()) {
+            EXPECT_EQ(tree_upper, tree.end());
+        }
+        else {
+            ASSERT_NE(tree_upper, tree.end());
+            EXPECT_EQ((std::string) tree_upper->first, upper->first);
+        }
+    }
+}
+
+static std::string random_key() {
+    std::string key(1 + rand() % 12, '\x00');
+    for(char &c : key) {
+        c = (char) (rand() % 256);
+    }
+    return key;
+}
+
+TEST(BPlusTree, empty) {
+    Datastore::BPlusTree tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.begin(), tree.end());
+    EXPECT_EQ(tree.find("key"), tree.end());
+    EXPECT_EQ(tree.lower_bound("key"), tree.end());
+    EXPECT_FALSE(tree.erase("key"));
+
+    // decrementing end() of an empty tree stays at end()
+    Datastore::BPlusTree::const_iterator it = tree.end();
+    it--;
+    EXPECT_EQ(it, tree.end());
+}
+
+TEST(BPlusTree, put_overwrite_erase) {
+    srand(0);
+
+    Datastore::BPlusTree tree;
+    Map expected;
+
+    // enough records to split leaves and inner nodes
+    for(std::size_t i = 0; i < 20000; i++) {
+        const std::string key = random_key();
+        const std::string value(rand() % 64, (char) i);
+        tree.put(key, value);
+        expected[key] = value;
+    }
+    compare(tree, expected);
+
+    // overwrite some values with longer ones
+    std::size_t i = 0;
+    for(Map::value_type &record : expected) {
+        if (i++ % 3 == 0) {
+            record.second = std::string(100, 'o');
+            tree.put(record.first, record.second);
+        }
+    }
+    compare(tree, expected);
+
+    // erase most of the records, emptying leaves
+    i = 0;
+    for(Map::iterator it = expected.begin(); it != expected.end();) {
+        if (i++ % 8) {
+            EXPECT_TRUE(tree.erase(it->first));
+            it = expected.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+    compare(tree, expected);
+
+    // erase everything
+    for(Map::value_type const &record : expected) {
+        EXPECT_TRUE(tree.erase(record.first));
+    }
+    expected.clear();
+    compare(tree, expected);
+
+    // the tree is still usable
+    tree.put("key", "value");
+    expected["key"] = "value";
+    compare(tree, expected);
+}
+
+TEST(BPlusTree, large_values) {
+    Datastore::BPlusTree tree;
+    Map expected;
+
+    // values larger than a leaf
+    for(std::size_t i = 0; i < 32; i++) {
+        const std::string key(1, (char) ('a' + i));
+        const std::string value(100000, (char) i);
+        tree.put(key, value);
+        expected[key] = value;
+    }
+
+    compare(tree, expected);
+}
@@ -48,3 +48,31 @@ TEST(datastore, GetStats) {
         }
     }
 }
+
+TEST(datastore, GetStats_op) {
+    TestDatastore ds(-1);
+
+    EXPECT_EQ(ds.GetStats(HXHIM_SYNC), nullptr);
+
+    const Datastore::Datastore::Stats::Op *puts = ds.GetStats(HXHIM_PUT);
+    const Datastore::Datastore::Stats::Op *gets = ds.GetStats(HXHIM_GET);
+    ASSERT_NE(puts, nullptr);
+    ASSERT_NE(gets, nullptr);
+
+    const std::size_t count = 10;
+    for(std::size_t i = 0; i < count; i++) {
+        Message::Request::BPut bput(0);
+        destruct(ds.operate(static_cast<Message::Request::BPut *>(&bput)));
+    }
+
+    // the statistics are updated while the datastore is running
+    EXPECT_EQ(puts->events(), count);
+    EXPECT_EQ(puts->count(), count);
+    EXPECT_EQ(puts->time(), count * PUT_TIME_UINT64);
+    EXPECT_EQ(puts->latency.count(), count);
+    EXPECT_GE(puts->latency.quantile(0.5), PUT_TIME_UINT64);
+    EXPECT_LE(puts->latency.quantile(0.5), PUT_TIME_UINT64 + PUT_TIME_UINT64 / 4);
+
+    EXPECT_EQ(gets->events(), 0);
+    EXPECT_EQ(gets->latency.quantile(0.5), 0);
+}
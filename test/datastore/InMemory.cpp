@@ -1,4 +1,7 @@
+#include <chrono>
 #include <cstring>
+#include <mutex>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -21,9 +24,18 @@ class InMemoryTest : public Datastore::InMemory {
         return DATASTORE_SUCCESS;
     }
 
-    std::map<std::string, std::string> const &data() const {
+    ::Datastore::BPlusTree const &data() const {
         return db;
     }
+
+    int Encode(const Blob &src, void **dst, std::size_t *dst_size) {
+        return encode(callbacks, src, dst, dst_size);
+    }
+
+    std::size_t Partials() {
+        std::lock_guard<std::mutex> lock(partials_mutex);
+        return partials.size();
+    }
 };
 
 // create a test InMemory datastore and insert some triples
@@ -49,7 +61,7 @@ TEST(InMemory, BPut) {
     InMemoryTest *ds = setup();
     ASSERT_NE(ds, nullptr);
 
-    std::map<std::string, std::string> const &db = ds->data();
+    ::Datastore::BPlusTree const &db = ds->data();
     EXPECT_EQ(db.size(), count);
 
     for(std::size_t i = 0; i < count; i++) {
@@ -173,11 +185,208 @@ TEST(InMemory, BGetOp) {
     destruct(ds);
 }
 
+TEST(InMemory, BGetOp_chunks) {
+    InMemoryTest *ds = setup();
+    ASSERT_NE(ds, nullptr);
+
+    // get one record at a time
+    ds->SetGetOpChunk(1);
+
+    const hxhim_getop_t ops[] = {hxhim_getop_t::HXHIM_GETOP_FIRST,
+                                 hxhim_getop_t::HXHIM_GETOP_LAST};
+
+    for(hxhim_getop_t const op : ops) {
+        Blob cursor;
+        for(std::size_t i = 0; i < count; i++) {
+            Message::Request::BGetOp req(1);
+            req.add(Blob(), Blob(),
+                    hxhim_data_t::HXHIM_DATA_BYTE,
+                    count - i,
+                    op,
+                    std::move(cursor));
+
+            Message::Response::BGetOp *res = ds->operate(&req);
+            ASSERT_NE(res, nullptr);
+            ASSERT_EQ(res->count, 1);
+            EXPECT_EQ(res->statuses[0], DATASTORE_SUCCESS);
+            ASSERT_EQ(res->num_recs[0], 1);
+
+            // records arrive in order across chunks
+            const std::size_t expected = (op == hxhim_getop_t::HXHIM_GETOP_FIRST)?i:(count - 1 - i);
+            EXPECT_EQ((std::string) res->subjects[0][0],   subjects[expected]);
+            EXPECT_EQ((std::string) res->predicates[0][0], predicates[expected]);
+            EXPECT_EQ((std::string) res->objects[0][0],    objects[expected]);
+
+            // the rest is only returned while records are missing
+            EXPECT_EQ(res->rest.num_recs[0], count - i - 1);
+            if (res->rest.num_recs[0]) {
+                EXPECT_EQ(res->rest.ops[0], op);
+                ASSERT_NE(res->rest.cursors[0].size(), 0);
+                cursor = std::move(res->rest.cursors[0]);
+            }
+
+            destruct(res);
+        }
+    }
+
+    destruct(ds);
+}
+
+TEST(InMemory, BPut_chunks) {
+    InMemoryTest *ds = setup();
+    ASSERT_NE(ds, nullptr);
+
+    const std::string object = "0123456789";
+    const std::size_t CHUNK  = 2;
+
+    // chunks arrive out of order, each alongside a whole object
+    const std::size_t order[] = {4, 1, 3, 0, 2};
+    const std::size_t chunks = sizeof(order) / sizeof(*order);
+    for(std::size_t i = 0; i < chunks; i++) {
+        Message::Request::BPut::Chunk chunk;
+        chunk.id     = 1;
+        chunk.offset = order[i] * CHUNK;
+        chunk.total  = object.size();
+
+        Message::Request::BPut req(2);
+        req.add(Blob(subjects[1]),
+                Blob(predicates[1]),
+                Blob(objects[1]));
+        req.add(Blob(subjects[0]),
+                Blob(predicates[0]),
+                ReferenceBlob((void *) (object.data() + chunk.offset), CHUNK, hxhim_data_t::HXHIM_DATA_BYTE),
+                chunk);
+
+        Message::Response::BPut *res = ds->operate(&req);
+        ASSERT_NE(res, nullptr);
+        ASSERT_EQ(res->count, 2);
+        EXPECT_EQ(res->statuses[0], DATASTORE_SUCCESS);
+
+        // only the last chunk reports the status of the object
+        EXPECT_EQ(res->statuses[1], (i == chunks - 1)?DATASTORE_SUCCESS:DATASTORE_PARTIAL);
+
+        destruct(res);
+    }
+
+    EXPECT_EQ(ds->data().size(), count);
+
+    Message::Request::BGet req(1);
+    req.add(Blob(subjects[0]),
+            Blob(predicates[0]),
+            hxhim_data_t::HXHIM_DATA_BYTE);
+
+    Message::Response::BGet *res = ds->operate(&req);
+    ASSERT_NE(res, nullptr);
+    ASSERT_EQ(res->count, 1);
+    EXPECT_EQ(res->statuses[0], DATASTORE_SUCCESS);
+    EXPECT_EQ((std::string) res->objects[0], object);
+
+    destruct(res);
+    destruct(ds);
+}
+
+// PUT one chunk of an object and return the status of the chunk
+static int put_chunk(InMemoryTest *ds, const std::string &object,
+                     const std::uint64_t id, const std::size_t offset, const std::size_t len) {
+    Message::Request::BPut::Chunk chunk;
+    chunk.id     = id;
+    chunk.offset = offset;
+    chunk.total  = object.size();
+
+    Message::Request::BPut req(1);
+    req.add(Blob(subjects[0]),
+            Blob(predicates[0]),
+            ReferenceBlob((void *) (object.data() + offset), len, hxhim_data_t::HXHIM_DATA_BYTE),
+            chunk);
+
+    Message::Response::BPut *res = ds->operate(&req);
+    EXPECT_NE(res, nullptr);
+    EXPECT_EQ(res->count, 1);
+    const int status = res->statuses[0];
+    destruct(res);
+
+    return status;
+}
+
+TEST(InMemory, BPut_chunks_duplicate) {
+    InMemoryTest *ds = setup();
+    ASSERT_NE(ds, nullptr);
+
+    const std::string object = "0123456789";
+
+    // the repeated and overlapping bytes add up to the size of the object
+    EXPECT_EQ(put_chunk(ds, object, 1, 0, 4), DATASTORE_PARTIAL);
+    EXPECT_EQ(put_chunk(ds, object, 1, 0, 4), DATASTORE_PARTIAL);
+    EXPECT_EQ(put_chunk(ds, object, 1, 2, 4), DATASTORE_PARTIAL);
+    EXPECT_EQ(put_chunk(ds, object, 1, 8, 0), DATASTORE_PARTIAL);
+    EXPECT_EQ(put_chunk(ds, object, 1, 8, 2), DATASTORE_PARTIAL);
+    EXPECT_EQ(ds->Partials(), 1);
+
+    // fill in the hole
+    EXPECT_EQ(put_chunk(ds, object, 1, 6, 2), DATASTORE_SUCCESS);
+    EXPECT_EQ(ds->Partials(), 0);
+
+    Message::Request::BGet req(1);
+    req.add(Blob(subjects[0]),
+            Blob(predicates[0]),
+            hxhim_data_t::HXHIM_DATA_BYTE);
+
+    Message::Response::BGet *res = ds->operate(&req);
+    ASSERT_NE(res, nullptr);
+    ASSERT_EQ(res->count, 1);
+    EXPECT_EQ(res->statuses[0], DATASTORE_SUCCESS);
+    EXPECT_EQ((std::string) res->objects[0], object);
+
+    destruct(res);
+    destruct(ds);
+}
+
+TEST(InMemory, BPut_chunks_too_large) {
+    InMemoryTest *ds = setup();
+    ASSERT_NE(ds, nullptr);
+
+    ds->SetMaxObjectSize(4);
+
+    // only the first chunk reports the error
+    const std::string object = "0123456789";
+    EXPECT_EQ(put_chunk(ds, object, 1, 2, 2), DATASTORE_PARTIAL);
+    EXPECT_EQ(put_chunk(ds, object, 1, 0, 2), DATASTORE_ERROR);
+    EXPECT_EQ(put_chunk(ds, object, 1, 4, 6), DATASTORE_PARTIAL);
+    EXPECT_EQ(ds->Partials(), 0);
+
+    // objects within the limit are still reassembled
+    const std::string small = "0123";
+    EXPECT_EQ(put_chunk(ds, small, 2, 2, 2), DATASTORE_PARTIAL);
+    EXPECT_EQ(put_chunk(ds, small, 2, 0, 2), DATASTORE_SUCCESS);
+    EXPECT_EQ(ds->Partials(), 0);
+
+    destruct(ds);
+}
+
+TEST(InMemory, BPut_chunks_expire) {
+    InMemoryTest *ds = setup();
+    ASSERT_NE(ds, nullptr);
+
+    ds->SetPartialTimeout(1);
+
+    const std::string object = "0123456789";
+    EXPECT_EQ(put_chunk(ds, object, 1, 0, 2), DATASTORE_PARTIAL);
+    EXPECT_EQ(ds->Partials(), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // the first chunk was dropped, so the rest of the object never completes
+    EXPECT_EQ(put_chunk(ds, object, 1, 2, 8), DATASTORE_PARTIAL);
+    EXPECT_EQ(ds->Partials(), 1);
+
+    destruct(ds);
+}
+
 TEST(InMemory, BDelete) {
     InMemoryTest *ds = setup();
     ASSERT_NE(ds, nullptr);
 
-    std::map<std::string, std::string> const &db = ds->data();
+    ::Datastore::BPlusTree const &db = ds->data();
     EXPECT_EQ(db.size(), count);
 
     // include the non-existant subject-predicate pair
@@ -397,3 +606,39 @@ TEST(InMemory, Histograms) {
 
     destruct(ds);
 }
+
+TEST(InMemory, encode_pass_through) {
+    InMemoryTest *ds = construct<InMemoryTest>();
+
+    // BYTE data is not transformed, so it is not copied
+    {
+        const std::string str = "str";
+        Blob src(str);
+        void *dst = nullptr;
+        std::size_t dst_size = 0;
+        EXPECT_EQ(ds->Encode(src, &dst, &dst_size), DATASTORE_SUCCESS);
+        EXPECT_EQ(dst, src.data());
+        EXPECT_EQ(dst_size, src.size());
+    }
+
+    // numeric data is transformed into a new buffer
+    {
+        int32_t value = 1;
+        Blob src(&value, sizeof(value), hxhim_data_t::HXHIM_DATA_INT32);
+        void *dst = nullptr;
+        std::size_t dst_size = 0;
+        EXPECT_EQ(ds->Encode(src, &dst, &dst_size), DATASTORE_SUCCESS);
+        EXPECT_NE(dst, src.data());
+        dealloc(dst);
+    }
+
+    // data types without callbacks cannot be encoded
+    {
+        Blob src((void *) "str", 3, hxhim_data_t::HXHIM_DATA_INVALID);
+        void *dst = nullptr;
+        std::size_t dst_size = 0;
+        EXPECT_EQ(ds->Encode(src, &dst, &dst_size), DATASTORE_ERROR);
+    }
+
+    destruct(ds);
+}
@@ -76,6 +76,26 @@ TEST(triplestore, sp_to_key) {
     ASSERT_EQ(curr, ((char *) key.data()) + key.size());
 }
 
+TEST(triplestore, sp_to_key_string) {
+    Blob sub(SUBJECT);
+    Blob pred(PREDICATE);
+
+    Blob expected;
+    ASSERT_EQ(sp_to_key(sub, pred, &expected), HXHIM_SUCCESS);
+    EXPECT_EQ(sp_to_key_size(sub, pred), expected.size());
+
+    // longer contents are overwritten
+    std::string key(2 * expected.size(), '\x00');
+    EXPECT_EQ(sp_to_key(sub, pred, key), HXHIM_SUCCESS);
+    EXPECT_EQ(key, (std::string) expected);
+
+    // the string is reused for the next key
+    Blob other_expected;
+    ASSERT_EQ(sp_to_key(pred, sub, &other_expected), HXHIM_SUCCESS);
+    EXPECT_EQ(sp_to_key(pred, sub, key), HXHIM_SUCCESS);
+    EXPECT_EQ(key, (std::string) other_expected);
+}
+
 TEST(triplestore, key_to_sp) {
     Blob sub(SUBJECT);
     Blob pred(PREDICATE);
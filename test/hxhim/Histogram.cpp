@@ -118,6 +118,9 @@ TEST(hxhim, Histogram) {
 
     hxhim::Results::Destroy(put_results);
 
+    // the histograms of the other ranks are complete once every rank has flushed
+    MPI_Barrier(MPI_COMM_WORLD);
+
     for(std::string const &hist_name : HIST_NAMES) {
         // Pull the current histogram from each rank
         for(std::size_t i = 0; i < total_rs; i++) {
@@ -161,5 +164,8 @@ TEST(hxhim, Histogram) {
         hxhim::Results::Destroy(hist_results);
     }
 
+    // other ranks might still be pulling the histograms on this rank
+    MPI_Barrier(MPI_COMM_WORLD);
+
     EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
 }
@@ -1,7 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <climits>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
 #include "generic_options.hpp"
 #include "hxhim/hxhim.hpp"
+#include "hxhim/private/collective.hpp"
+#include "message/Messages.hpp"
 
 typedef uint64_t Subject_t;
 typedef uint64_t Predicate_t;
@@ -110,3 +119,346 @@ TEST(hxhim, PutGet) {
         EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
     }
 }
+
+static void put_get_chunked(const bool remote) {
+    const std::string SUBJECT   = "SUBJECT";
+    const std::string PREDICATE = "PREDICATE";
+    std::string OBJECT(10000, '\0');
+    for(std::size_t i = 0; i < OBJECT.size(); i++) {
+        OBJECT[i] = (char) (i % 256);
+    }
+
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(hxhim_set_maximum_size_per_request(&hx, 512), HXHIM_SUCCESS);
+    if (remote) {
+        // several chunks are sent at once and handled by
+        // different workers, so they can arrive in any order
+        ASSERT_EQ(use_remote_hash(&hx), true);
+        ASSERT_EQ(hxhim_set_maximum_requests_in_flight(&hx, 8), HXHIM_SUCCESS);
+        ASSERT_EQ(hxhim_set_transport_mpi(&hx, 4), HXHIM_SUCCESS);
+    }
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    // object is much larger than the maximum request size
+    EXPECT_EQ(hxhim::Put(&hx,
+                         (void *) SUBJECT.c_str(),   SUBJECT.size(),   hxhim_data_t::HXHIM_DATA_BYTE,
+                         (void *) PREDICATE.c_str(), PREDICATE.size(), hxhim_data_t::HXHIM_DATA_BYTE,
+                         (void *) OBJECT.c_str(),    OBJECT.size(),    hxhim_data_t::HXHIM_DATA_BYTE,
+                         HXHIM_PUT_SPO),
+              HXHIM_SUCCESS);
+
+    hxhim::Results *put_results = hxhim::FlushPuts(&hx);
+    ASSERT_NE(put_results, nullptr);
+
+    // the object was split into multiple chunks, but was only PUT once
+    EXPECT_EQ(put_results->Size(), (std::size_t) 1);
+    HXHIM_CXX_RESULTS_LOOP(put_results) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(put_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+    }
+
+    hxhim::Results::Destroy(put_results);
+
+    // the chunks were reassembled by the range server
+    EXPECT_EQ(hxhim::Get(&hx,
+                         (void *) SUBJECT.c_str(),   SUBJECT.size(),   hxhim_data_t::HXHIM_DATA_BYTE,
+                         (void *) PREDICATE.c_str(), PREDICATE.size(), hxhim_data_t::HXHIM_DATA_BYTE,
+                         hxhim_data_t::HXHIM_DATA_BYTE),
+              HXHIM_SUCCESS);
+
+    hxhim::Results *get_results = hxhim::FlushGets(&hx);
+    ASSERT_NE(get_results, nullptr);
+
+    EXPECT_EQ(get_results->Size(), (std::size_t) 1);
+    HXHIM_CXX_RESULTS_LOOP(get_results) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(get_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        char *object = nullptr;
+        std::size_t object_size = 0;
+        hxhim_data_t object_type;
+        EXPECT_EQ(get_results->Object((void **) &object, &object_size, &object_type), HXHIM_SUCCESS);
+        EXPECT_EQ(object_type, hxhim_data_t::HXHIM_DATA_BYTE);
+        ASSERT_EQ(object_size, OBJECT.size());
+        EXPECT_EQ(memcmp(object, OBJECT.c_str(), object_size), 0);
+    }
+
+    hxhim::Results::Destroy(get_results);
+
+    // other ranks might still be using the range server on this rank
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+TEST(hxhim, PutGetChunked) {
+    put_get_chunked(false);
+}
+
+TEST(hxhim, PutGetChunkedRemote) {
+    put_get_chunked(true);
+}
+
+TEST(hxhim, PutGetLastWriterWins) {
+    const Subject_t   SUBJECT   = (((Subject_t)   rand()) << 32) | rand();
+    const Predicate_t PREDICATE = (((Predicate_t) rand()) << 32) | rand();
+    const std::size_t COUNT     = 64;
+
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(use_remote_hash(&hx), true);
+    ASSERT_EQ(hxhim_set_maximum_requests_in_flight(&hx, 8), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim_set_transport_mpi(&hx, 4), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    // each PUT is its own packet, several packets to the same range
+    // server are sent at once, and the range server has several workers
+    std::vector<Object_t> objects(COUNT);
+    for(std::size_t i = 0; i < COUNT; i++) {
+        objects[i] = i;
+        EXPECT_EQ(hxhim::PutDouble(&hx,
+                                   (void *)   &SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                                   (void *)   &PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   (double *) &objects[i],
+                                   HXHIM_PUT_SPO),
+                  HXHIM_SUCCESS);
+    }
+
+    hxhim::Results *put_results = hxhim::FlushPuts(&hx);
+    ASSERT_NE(put_results, nullptr);
+    EXPECT_EQ(put_results->Size(), COUNT);
+    hxhim::Results::Destroy(put_results);
+
+    EXPECT_EQ(hxhim::GetDouble(&hx,
+                               (void *)&SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                               (void *)&PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64),
+              HXHIM_SUCCESS);
+
+    hxhim::Results *get_results = hxhim::FlushGets(&hx);
+    ASSERT_NE(get_results, nullptr);
+
+    // the PUTs were applied in the order they were queued
+    EXPECT_EQ(get_results->Size(), (std::size_t) 1);
+    HXHIM_CXX_RESULTS_LOOP(get_results) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(get_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        Object_t *object = nullptr;
+        EXPECT_EQ(get_results->Object((void **) &object, nullptr, nullptr), HXHIM_SUCCESS);
+        ASSERT_NE(object, nullptr);
+        EXPECT_EQ(*object, objects.back());
+    }
+
+    hxhim::Results::Destroy(get_results);
+
+    // other ranks might still be using the range server on this rank
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+TEST(hxhim, PutGetLastWriterWinsMixedSizes) {
+    const Subject_t   SUBJECT   = (((Subject_t)   rand()) << 32) | rand();
+    const Predicate_t PREDICATE = (((Predicate_t) rand()) << 32) | rand();
+    const std::size_t COUNT     = 64;
+
+    // only packets holding a float fit into the pre-posted receives
+    std::size_t float_size = 0;
+    {
+        const float object = 0;
+        Message::Request::BPut bput(1);
+        bput.add(ReferenceBlob((void *) &SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64),
+                 ReferenceBlob((void *) &PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64),
+                 ReferenceBlob((void *) &object,    sizeof(object),    hxhim_data_t::HXHIM_DATA_FLOAT));
+
+        void *buf = nullptr;
+        ASSERT_EQ(Message::Packer::pack(&bput, &buf, &float_size), MESSAGE_SUCCESS);
+        dealloc(buf);
+    }
+
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(use_remote_hash(&hx), true);
+    ASSERT_EQ(hxhim_set_maximum_size_per_request(&hx, float_size), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim_set_maximum_requests_in_flight(&hx, 8), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim_set_transport_mpi(&hx, 1), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    // floats arrive through the pre-posted receives, which are
+    // reused many times, and doubles are matched separately
+    std::vector<float>    floats(COUNT);
+    std::vector<Object_t> doubles(COUNT);
+    for(std::size_t i = 0; i < COUNT; i++) {
+        floats[i] = i;
+        doubles[i] = i;
+        if (!(i % 2)) {
+            EXPECT_EQ(hxhim::PutDouble(&hx,
+                                       (void *)   &SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                                       (void *)   &PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64,
+                                       (double *) &doubles[i],
+                                       HXHIM_PUT_SPO),
+                      HXHIM_SUCCESS);
+        }
+        else {
+            EXPECT_EQ(hxhim::PutFloat(&hx,
+                                      (void *)  &SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                                      (void *)  &PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64,
+                                      (float *) &floats[i],
+                                      HXHIM_PUT_SPO),
+                      HXHIM_SUCCESS);
+        }
+    }
+
+    hxhim::Results *put_results = hxhim::FlushPuts(&hx);
+    ASSERT_NE(put_results, nullptr);
+    EXPECT_EQ(put_results->Size(), COUNT);
+    hxhim::Results::Destroy(put_results);
+
+    EXPECT_EQ(hxhim::GetFloat(&hx,
+                              (void *)&SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                              (void *)&PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64),
+              HXHIM_SUCCESS);
+
+    hxhim::Results *get_results = hxhim::FlushGets(&hx);
+    ASSERT_NE(get_results, nullptr);
+
+    // the last PUT was a float, which would overtake the double
+    // before it if the packets were not received in order
+    EXPECT_EQ(get_results->Size(), (std::size_t) 1);
+    HXHIM_CXX_RESULTS_LOOP(get_results) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(get_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        float *object = nullptr;
+        EXPECT_EQ(get_results->Object((void **) &object, nullptr, nullptr), HXHIM_SUCCESS);
+        ASSERT_NE(object, nullptr);
+        EXPECT_EQ(*object, floats.back());
+    }
+
+    hxhim::Results::Destroy(get_results);
+
+    // other ranks might still be using the range server on this rank
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+static void put_get_collective(const bool node_aggregation) {
+    const Subject_t   SUBJECT   = (((Subject_t)   rand()) << 32) | rand();
+    const Predicate_t PREDICATE = (((Predicate_t) rand()) << 32) | rand();
+    const Object_t    OBJECT    = (((Object_t) SUBJECT) * ((Object_t) SUBJECT)) / (((Object_t) PREDICATE) * ((Object_t) PREDICATE));
+
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(use_remote_hash(&hx), true);
+    ASSERT_EQ(hxhim_set_node_aggregation(&hx, node_aggregation), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    EXPECT_EQ(hxhim::PutDouble(&hx,
+                               (void *)   &SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                               (void *)   &PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64,
+                               (double *) &OBJECT,
+                               HXHIM_PUT_SPO),
+              HXHIM_SUCCESS);
+
+    // flush PUTs collectively
+    hxhim::Results *put_results = hxhim::FlushCollective(&hx);
+    ASSERT_NE(put_results, nullptr);
+
+    EXPECT_EQ(put_results->Size(), (std::size_t) 1);
+    HXHIM_CXX_RESULTS_LOOP(put_results) {
+        hxhim_op_t op;
+        EXPECT_EQ(put_results->Op(&op), HXHIM_SUCCESS);
+        EXPECT_EQ(op, hxhim_op_t::HXHIM_PUT);
+
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(put_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+    }
+
+    hxhim::Results::Destroy(put_results);
+
+    EXPECT_EQ(hxhim::GetDouble(&hx,
+                               (void *)&SUBJECT,   sizeof(SUBJECT),   hxhim_data_t::HXHIM_DATA_UINT64,
+                               (void *)&PREDICATE, sizeof(PREDICATE), hxhim_data_t::HXHIM_DATA_UINT64),
+              HXHIM_SUCCESS);
+
+    // flush GETs collectively
+    hxhim::Results *get_results = hxhim::FlushCollective(&hx);
+    ASSERT_NE(get_results, nullptr);
+
+    EXPECT_EQ(get_results->Size(), (std::size_t) 1);
+    HXHIM_CXX_RESULTS_LOOP(get_results) {
+        hxhim_op_t op = hxhim_op_t::HXHIM_INVALID;
+        EXPECT_EQ(get_results->Op(&op), HXHIM_SUCCESS);
+        EXPECT_EQ(op, hxhim_op_t::HXHIM_GET);
+
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(get_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        Object_t *object = nullptr;
+        std::size_t object_size = 0;
+        hxhim_data_t object_type;
+        EXPECT_EQ(get_results->Object((void **) &object, &object_size, &object_type), HXHIM_SUCCESS);
+        EXPECT_EQ(object_type, hxhim_data_t::HXHIM_DATA_DOUBLE);
+        EXPECT_EQ(object_size, sizeof(Object_t));
+        EXPECT_NEAR(*object, OBJECT, std::numeric_limits<double>::digits10);
+    }
+
+    hxhim::Results::Destroy(get_results);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+TEST(hxhim, PutGetCollective) {
+    put_get_collective(false);
+}
+
+TEST(hxhim, PutGetCollectiveNodeAggregation) {
+    put_get_collective(true);
+}
+
+TEST(hxhim, CollectiveExchangeRounds) {
+    int rank = -1;
+    int size = -1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // buffers of different sizes, some of which are empty
+    auto len  = [](const int src, const int dst) -> std::size_t { return (src * 7 + dst * 3) % 11; };
+    auto byte = [](const int src, const int dst, const std::size_t i) -> char { return src * 31 + dst * 17 + i; };
+
+    hxhim::collective::Buffers send(size);
+    for(int dst = 0; dst < size; dst++) {
+        for(std::size_t i = 0; i < len(rank, dst); i++) {
+            send[dst].push_back(byte(rank, dst, i));
+        }
+    }
+
+    // a tiny round size forces the data to be split into many rounds
+    const std::size_t max_rounds[] = {INT_MAX, 5, 1};
+    for(std::size_t max_round : max_rounds) {
+        std::vector<char> recv;
+        std::vector<std::size_t> displs;
+        std::vector<std::size_t> counts;
+        ASSERT_EQ(hxhim::collective::exchange(MPI_COMM_WORLD, send, recv, displs, counts, max_round), HXHIM_SUCCESS);
+        ASSERT_EQ(counts.size(), (std::size_t) size);
+
+        for(int src = 0; src < size; src++) {
+            ASSERT_EQ(counts[src], len(src, rank));
+            for(std::size_t i = 0; i < counts[src]; i++) {
+                EXPECT_EQ(recv[displs[src] + i], byte(src, rank, i));
+            }
+        }
+    }
+}
@@ -26,13 +26,20 @@ static const std::vector<Triple> TRIPLES = [](const std::size_t count) {
     return ret;
 }(COUNT);
 
-static int init(hxhim_t *hx) {
+static int init(hxhim_t *hx, const std::size_t getop_chunk = 0) {
     hxhim::Init(hx, MPI_COMM_WORLD);
     if (!fill_options(hx)) {
         hxhim::Close(hx);
         return HXHIM_ERROR;
     }
 
+    // 0 keeps the configured chunk size
+    if (getop_chunk &&
+        (hxhim_set_range_server_getop_chunk(hx, getop_chunk) != HXHIM_SUCCESS)) {
+        hxhim::Close(hx);
+        return HXHIM_ERROR;
+    }
+
     if (hxhim::Open(hx) != HXHIM_SUCCESS) {
         hxhim::Close(hx);
         return HXHIM_ERROR;
@@ -220,6 +227,61 @@ TEST(hxhim, PutGetOp_NEXT) {
     EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
 }
 
+TEST(hxhim, PutGetOp_NEXT_chunked) {
+    // return fewer records at once than are asked for
+    const std::size_t CHUNK = 3;
+
+    hxhim_t hx;
+    ASSERT_EQ(init(&hx, CHUNK), HXHIM_SUCCESS);
+
+    // Flush all queued items
+    hxhim::Results *put_results = hxhim::Flush(&hx);
+    ASSERT_NE(put_results, nullptr);
+    EXPECT_EQ(put_results->Size(), COUNT);
+    hxhim::Results::Destroy(put_results);
+
+    // get all of the triples with one GETOP
+    EXPECT_EQ(hxhim::GetOp(&hx,
+                           (void *) &TRIPLES[0].subject,   sizeof(TRIPLES[0].subject),   hxhim_data_t::HXHIM_DATA_UINT64,
+                           (void *) &TRIPLES[0].predicate, sizeof(TRIPLES[0].predicate), hxhim_data_t::HXHIM_DATA_DOUBLE,
+                           hxhim_data_t::HXHIM_DATA_INT32,
+                           COUNT, hxhim_getop_t::HXHIM_GETOP_NEXT),
+              HXHIM_SUCCESS);
+
+    // Flush all queued items
+    hxhim::Results *getop_results = hxhim::Flush(&hx);
+    ASSERT_NE(getop_results, nullptr);
+
+    // the chunks are put back together in order
+    std::size_t j = 0;
+    EXPECT_EQ(getop_results->Size(), COUNT);
+    HXHIM_CXX_RESULTS_LOOP(getop_results) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(getop_results->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        Predicate_t *predicate = nullptr;
+        std::size_t predicate_len = 0;
+        hxhim_data_t predicate_type = hxhim_data_t::HXHIM_DATA_INVALID;
+        EXPECT_EQ(getop_results->Predicate((void **) &predicate, &predicate_len, &predicate_type), HXHIM_SUCCESS);
+        EXPECT_NEAR(*predicate, TRIPLES[j].predicate, std::numeric_limits<Predicate_t>::digits10);
+
+        Object_t *object = nullptr;
+        std::size_t object_len = 0;
+        hxhim_data_t object_type = hxhim_data_t::HXHIM_DATA_INVALID;
+        EXPECT_EQ(getop_results->Object((void **) &object, &object_len, &object_type), HXHIM_SUCCESS);
+        EXPECT_EQ(*object, TRIPLES[j].object);
+
+        j++;
+    }
+
+    EXPECT_EQ(j, COUNT);
+
+    hxhim::Results::Destroy(getop_results);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
 TEST(hxhim, PutGetOp_PREV) {
     hxhim_t hx;
     ASSERT_EQ(init(&hx), HXHIM_SUCCESS);
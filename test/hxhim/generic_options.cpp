@@ -13,6 +13,20 @@ static int test_hash_local(hxhim_t *hx, void *, const size_t, void *, const size
     return rank;
 }
 
+/**
+ * Sends everything to the next rank so that packets
+ * go through the transport when there is more than
+ * one rank. Like test_hash_local, this only works
+ * when every rank has a range server.
+ */
+static int test_hash_remote(hxhim_t *hx, void *, const size_t, void *, const size_t, void *) {
+    int rank = -1;
+    int size = -1;
+    hxhim::nocheck::GetMPI(hx, nullptr, &rank, &size);
+
+    return (rank + 1) % size;
+}
+
 bool fill_options(hxhim_t *hx) {
     return ((hxhim_set_debug_level(hx, MLOG_WARN)                  == HXHIM_SUCCESS) &&
             (hxhim_set_client_ratio(hx, 1)                         == HXHIM_SUCCESS) &&
@@ -33,3 +47,7 @@ bool fill_options(hxhim_t *hx) {
             (hxhim_set_histogram_bucket_gen_name(hx, "10_BUCKETS") == HXHIM_SUCCESS) &&
             true);
 }
+
+bool use_remote_hash(hxhim_t *hx) {
+    return (hxhim_set_hash_function(hx, "Test_Hash_Remote", test_hash_remote, nullptr) == HXHIM_SUCCESS);
+}
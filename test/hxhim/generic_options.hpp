@@ -5,4 +5,7 @@
 
 bool fill_options(hxhim_t *hx);
 
+// replaces the hash set by fill_options
+bool use_remote_hash(hxhim_t *hx);
+
 #endif
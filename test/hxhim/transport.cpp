@@ -1,10 +1,87 @@
+#include <chrono>
 #include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
 
 #include <gtest/gtest.h>
 #include <mpi.h>
 
 #include "generic_options.hpp"
 #include "hxhim/hxhim.hpp"
+#include "message/Messages.hpp"
+#include "transport/AddressBook.hpp"
+#include "transport/Credits.hpp"
+#include "transport/EndpointCache.hpp"
+#include "transport/Scheduler.hpp"
+#include "transport/backend/SHM/Ring.hpp"
+
+/**
+ * round_trip
+ * PUTs triples, GETs them back, and checks the
+ * statuses and values of the results
+ *
+ * @param hx  an open hxhim instance
+ */
+static void round_trip(hxhim_t *hx) {
+    const std::size_t COUNT = 32;
+
+    std::vector<uint64_t> subjects(COUNT);
+    std::vector<double> objects(COUNT);
+    for(std::size_t i = 0; i < COUNT; i++) {
+        subjects[i] = i;
+        objects[i] = i * 1.5;
+        EXPECT_EQ(hxhim::PutDouble(hx,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   &objects[i],
+                                   HXHIM_PUT_SPO),
+                  HXHIM_SUCCESS);
+    }
+
+    hxhim::Results *puts = hxhim::FlushPuts(hx);
+    ASSERT_NE(puts, nullptr);
+    EXPECT_EQ(puts->Size(), COUNT);
+    HXHIM_CXX_RESULTS_LOOP(puts) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(puts->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+    }
+    hxhim::Results::Destroy(puts);
+
+    for(std::size_t i = 0; i < COUNT; i++) {
+        EXPECT_EQ(hxhim::GetDouble(hx,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64),
+                  HXHIM_SUCCESS);
+    }
+
+    hxhim::Results *gets = hxhim::FlushGets(hx);
+    ASSERT_NE(gets, nullptr);
+    EXPECT_EQ(gets->Size(), COUNT);
+    HXHIM_CXX_RESULTS_LOOP(gets) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(gets->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        uint64_t *subject = nullptr;
+        EXPECT_EQ(gets->Subject((void **) &subject, nullptr, nullptr), HXHIM_SUCCESS);
+        ASSERT_NE(subject, nullptr);
+        ASSERT_LT(*subject, COUNT);
+
+        double *object = nullptr;
+        EXPECT_EQ(gets->Object((void **) &object, nullptr, nullptr), HXHIM_SUCCESS);
+        ASSERT_NE(object, nullptr);
+        EXPECT_NEAR(*object, objects[*subject], 1e-6);
+    }
+    hxhim::Results::Destroy(gets);
+
+    // other ranks might still be using the range server on this rank
+    MPI_Barrier(MPI_COMM_WORLD);
+}
 
 TEST(transport, MPI) {
     hxhim_t hx;
@@ -17,6 +94,354 @@ TEST(transport, MPI) {
     EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
 }
 
+TEST(transport, MPI_ingest) {
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(hxhim_set_transport_mpi_ingest(&hx, 10, 4096), HXHIM_SUCCESS);
+    ASSERT_EQ(use_remote_hash(&hx), true);
+
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    round_trip(&hx);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+TEST(transport, SHM) {
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(hxhim_set_transport_shm(&hx, 4096, 1), HXHIM_SUCCESS);
+    ASSERT_EQ(use_remote_hash(&hx), true);
+
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    round_trip(&hx);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+TEST(transport, SIM) {
+    // this process has to be the only MPI rank
+    int size = 0;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (size != 1) {
+        return;
+    }
+
+    const std::size_t RANKS   = 8;
+    const std::size_t LATENCY = 1000; // microseconds
+    const std::size_t COUNT   = 32;
+
+    hxhim_t hx;
+    ASSERT_EQ(hxhim::Init(&hx, MPI_COMM_WORLD), HXHIM_SUCCESS);
+    ASSERT_EQ(fill_options(&hx), true);
+    ASSERT_EQ(hxhim_set_transport_sim(&hx, RANKS, LATENCY, 0, 100, 2, 1), HXHIM_SUCCESS);
+    ASSERT_EQ(hxhim_set_hash_name(&hx, "SUM_MOD_DATASTORES"), HXHIM_SUCCESS);
+
+    ASSERT_EQ(hxhim::Open(&hx), HXHIM_SUCCESS);
+
+    std::size_t range_servers = 0;
+    EXPECT_EQ(hxhim::GetRangeServerCount(&hx, &range_servers), HXHIM_SUCCESS);
+    EXPECT_EQ(range_servers, RANKS);
+
+    // spread the triples across the simulated range servers
+    std::vector<uint64_t> subjects(COUNT);
+    std::vector<double> objects(COUNT);
+    for(std::size_t i = 0; i < COUNT; i++) {
+        subjects[i] = i;
+        objects[i] = i * 1.5;
+        EXPECT_EQ(hxhim::PutDouble(&hx,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   &objects[i],
+                                   HXHIM_PUT_SPO),
+                  HXHIM_SUCCESS);
+    }
+
+    hxhim::Results *puts = hxhim::FlushPuts(&hx);
+    ASSERT_NE(puts, nullptr);
+    EXPECT_EQ(puts->Size(), COUNT);
+    HXHIM_CXX_RESULTS_LOOP(puts) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(puts->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+    }
+    hxhim::Results::Destroy(puts);
+
+    for(std::size_t i = 0; i < COUNT; i++) {
+        EXPECT_EQ(hxhim::GetDouble(&hx,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64,
+                                   &subjects[i], sizeof(subjects[i]), hxhim_data_t::HXHIM_DATA_UINT64),
+                  HXHIM_SUCCESS);
+    }
+
+    // requests to other simulated ranks take at least a round trip
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    hxhim::Results *gets = hxhim::FlushGets(&hx);
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    EXPECT_GE(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(), (long long) (2 * LATENCY));
+
+    ASSERT_NE(gets, nullptr);
+    EXPECT_EQ(gets->Size(), COUNT);
+    HXHIM_CXX_RESULTS_LOOP(gets) {
+        int status = HXHIM_ERROR;
+        EXPECT_EQ(gets->Status(&status), HXHIM_SUCCESS);
+        EXPECT_EQ(status, HXHIM_SUCCESS);
+
+        uint64_t *subject = nullptr;
+        EXPECT_EQ(gets->Subject((void **) &subject, nullptr, nullptr), HXHIM_SUCCESS);
+        ASSERT_NE(subject, nullptr);
+        ASSERT_LT(*subject, COUNT);
+
+        double *object = nullptr;
+        EXPECT_EQ(gets->Object((void **) &object, nullptr, nullptr), HXHIM_SUCCESS);
+        ASSERT_NE(object, nullptr);
+        EXPECT_NEAR(*object, objects[*subject], 1e-6);
+    }
+    hxhim::Results::Destroy(gets);
+
+    EXPECT_EQ(hxhim::Close(&hx), HXHIM_SUCCESS);
+}
+
+TEST(transport, SHM_Ring) {
+    std::stringstream name;
+    name << "/hxhim-test-" << getpid();
+
+    Transport::SHM::Ring *ring = Transport::SHM::Ring::create(name.str(), 1024);
+    ASSERT_NE(ring, nullptr);
+
+    // a message larger than the ring has to be written in pieces
+    const std::string small = "small message";
+    const std::string large(3 * ring->Capacity(), 'x');
+
+    EXPECT_EQ(ring->push(1, small.data(), small.size(), false), TRANSPORT_SUCCESS);
+    EXPECT_EQ(ring->push(2, large.data(), large.size(), false), TRANSPORT_ERROR);
+
+    std::string received;
+    volatile std::atomic_bool running(true);
+    EXPECT_EQ(ring->write(2, large.data(), large.size(), running,
+                          [&]() -> bool {
+                              return ring->drain([&](const int src, void *data, const std::size_t len) {
+                                      if (src == 2) {
+                                          received.assign((char *) data, len);
+                                      }
+                                      else {
+                                          EXPECT_EQ(std::string((char *) data, len), small);
+                                      }
+                                  });
+                          }), TRANSPORT_SUCCESS);
+
+    // the last fragment is still in the ring
+    EXPECT_EQ(ring->drain([&](const int src, void *data, const std::size_t len) {
+                EXPECT_EQ(src, 2);
+                received.assign((char *) data, len);
+            }), 1U);
+    EXPECT_EQ(received, large);
+
+    delete ring;
+}
+
+TEST(transport, Scheduler) {
+    Transport::Scheduler<int> scheduler(2, Transport::default_schedule());
+
+    // a backlog of PUTs on datastore 0, followed by GETs
+    for(int i = 0; i < 4; i++) {
+        scheduler.push(0, HXHIM_PUT, i);
+    }
+    for(int i = 10; i < 16; i++) {
+        scheduler.push(0, HXHIM_GET, i);
+    }
+
+    // a PUT for datastore 1 does not wait for datastore 0
+    scheduler.push(1, HXHIM_PUT, 100);
+    EXPECT_EQ(scheduler.size(), 11U);
+
+    // GETs go first, but PUTs get a turn every round
+    const int expected[] = {10, 100, 11, 12, 13, 0, 14, 15, 1, 2, 3};
+    for(const int value : expected) {
+        int item = -1;
+        ASSERT_TRUE(scheduler.pop(item));
+        EXPECT_EQ(item, value);
+    }
+
+    int item = -1;
+    EXPECT_FALSE(scheduler.pop(item));
+    EXPECT_EQ(scheduler.size(), 0U);
+}
+
+TEST(transport, Scheduler_acquire) {
+    Transport::Scheduler<int> scheduler(2, Transport::default_schedule());
+
+    scheduler.push(0, HXHIM_PUT, 0);
+    scheduler.push(0, HXHIM_PUT, 1);
+    scheduler.push(1, HXHIM_PUT, 100);
+    EXPECT_TRUE(scheduler.acquirable());
+
+    // datastore 0 is busy until it is released
+    int item = -1;
+    std::size_t ds = 2;
+    ASSERT_TRUE(scheduler.acquire(item, ds));
+    EXPECT_EQ(item, 0);
+    EXPECT_EQ(ds, 0U);
+
+    ASSERT_TRUE(scheduler.acquire(item, ds));
+    EXPECT_EQ(item, 100);
+    EXPECT_EQ(ds, 1U);
+
+    EXPECT_FALSE(scheduler.acquirable());
+    EXPECT_FALSE(scheduler.acquire(item, ds));
+    EXPECT_EQ(scheduler.size(), 1U);
+
+    scheduler.release(1);
+    EXPECT_FALSE(scheduler.acquirable());
+
+    scheduler.release(0);
+    EXPECT_TRUE(scheduler.acquirable());
+    ASSERT_TRUE(scheduler.acquire(item, ds));
+    EXPECT_EQ(item, 1);
+    EXPECT_EQ(ds, 0U);
+    scheduler.release(ds);
+
+    EXPECT_FALSE(scheduler.acquirable());
+    EXPECT_EQ(scheduler.size(), 0U);
+}
+
+TEST(transport, Credits) {
+    Transport::Credits credits;
+    credits.grant(1, 100, 2);
+
+    // range servers without grants get one packet at a time
+    EXPECT_TRUE(credits.acquire(2, 1000, 1000));
+    EXPECT_FALSE(credits.acquire(2, 1, 1));
+    credits.grant(2, 0, 0);
+    EXPECT_TRUE(credits.acquire(2, 1000, 1000));
+
+    // the first packet always fits
+    EXPECT_TRUE(credits.acquire(1, 150, 1));
+    EXPECT_FALSE(credits.acquire(1, 1, 1));
+
+    const std::size_t generation = credits.generation();
+    credits.release(1, 150, 1);
+    EXPECT_NE(credits.generation(), generation);
+    credits.wait(generation);
+
+    EXPECT_TRUE(credits.acquire(1, 50, 1));
+    EXPECT_TRUE(credits.acquire(1, 50, 1));
+
+    // out of bytes and operations
+    EXPECT_FALSE(credits.acquire(1, 0, 1));
+    EXPECT_FALSE(credits.acquire(1, 1, 0));
+}
+
+TEST(transport, Grants) {
+    Transport::Grants grants;
+    grants.budget(100, 0);
+
+    Message::Response::BPut res;
+
+    // a lone client gets the entire budget
+    grants.issue(1, &res);
+    EXPECT_EQ(res.grant.bytes, 100U);
+    EXPECT_EQ(res.grant.ops, 0U);
+
+    // the budget is split between the active clients
+    grants.issue(2, &res);
+    EXPECT_EQ(res.grant.bytes, 50U);
+    grants.issue(1, &res);
+    EXPECT_EQ(res.grant.bytes, 50U);
+    EXPECT_EQ(grants.active(), 2U);
+
+    // idle clients stop counting
+    std::this_thread::sleep_for(std::chrono::milliseconds(Transport::Grants::ACTIVE_MS + 10));
+    grants.issue(2, &res);
+    EXPECT_EQ(grants.active(), 1U);
+    EXPECT_EQ(res.grant.bytes, 100U);
+}
+
+TEST(transport, EndpointCache) {
+    std::vector<int> resolved;
+    Transport::EndpointCache<int> cache(2,
+                                        [&resolved](const int rank, int &endpoint) -> bool {
+                                            if (rank < 0) {
+                                                return false;
+                                            }
+
+                                            resolved.push_back(rank);
+                                            endpoint = rank * 10;
+                                            return true;
+                                        });
+
+    int endpoint = -1;
+    EXPECT_TRUE(cache.get(1, endpoint));
+    EXPECT_EQ(endpoint, 10);
+    EXPECT_TRUE(cache.get(2, endpoint));
+    EXPECT_EQ(endpoint, 20);
+    EXPECT_EQ(cache.misses(), 2U);
+
+    // hit, which makes rank 2 the least recently used
+    EXPECT_TRUE(cache.get(1, endpoint));
+    EXPECT_EQ(cache.misses(), 2U);
+
+    // evicts rank 2
+    EXPECT_TRUE(cache.get(3, endpoint));
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_TRUE(cache.get(1, endpoint));
+    EXPECT_EQ(cache.misses(), 3U);
+    EXPECT_TRUE(cache.get(2, endpoint));
+    EXPECT_EQ(cache.misses(), 4U);
+
+    // endpoints that cannot be resolved are not cached
+    EXPECT_FALSE(cache.get(-1, endpoint));
+    EXPECT_EQ(cache.size(), 2U);
+
+    // endpoints that were put do not need to be resolved
+    cache.put(5, 7);
+    EXPECT_TRUE(cache.get(5, endpoint));
+    EXPECT_EQ(endpoint, 7);
+
+    cache.erase(5);
+    EXPECT_TRUE(cache.get(5, endpoint));
+    EXPECT_EQ(endpoint, 50);
+
+    const std::vector<int> expected = {1, 2, 3, 2, 5};
+    EXPECT_EQ(resolved, expected);
+    EXPECT_LE(cache.size(), cache.capacity());
+}
+
+TEST(transport, AddressBook) {
+    int rank = -1;
+    int size = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // only even ranks publish an address
+    std::stringstream s;
+    s << "address-" << rank;
+
+    Transport::AddressBook addresses(MPI_COMM_WORLD, s.str(), !(rank % 2));
+    ASSERT_TRUE(addresses.Valid());
+    EXPECT_EQ(addresses.Size(), size);
+
+    for(int i = 0; i < size; i++) {
+        std::string address;
+        if (i % 2) {
+            EXPECT_FALSE(addresses.get(i, address));
+        }
+        else {
+            std::stringstream expected;
+            expected << "address-" << i;
+            EXPECT_TRUE(addresses.get(i, address));
+            EXPECT_EQ(address, expected.str());
+        }
+    }
+
+    std::string address;
+    EXPECT_FALSE(addresses.get(-1, address));
+    EXPECT_FALSE(addresses.get(size, address));
+}
+
 #ifdef HXHIM_HAVE_THALLIUM
 #define TEST_THALLIUM_TRANSPORT(plugin, protocol)                                                     \
     TEST(transport, thallium_ ##plugin ##_ ##protocol) {                                              \
@@ -21,10 +21,13 @@ TEST(Request, BPut) {
     for(std::size_t i = 0; i < COUNT; i++) {
         src.src = rand();
         src.dst = rand();
+        src.seq = rand();
 
         src.add(ReferenceBlob((void *) &SUBJECT, SUBJECT_LEN, SUBJECT_TYPE),
                 ReferenceBlob((void *) &PREDICATE, PREDICATE_LEN, PREDICATE_TYPE),
-                ReferenceBlob((void *) &OBJECT, OBJECT_LEN, OBJECT_TYPE));
+                ReferenceBlob((void *) &OBJECT, OBJECT_LEN, OBJECT_TYPE),
+                // every other object is a chunk of a larger object
+                {(i % 2)?i:0, (i % 2)?(i * OBJECT_LEN):0, (i % 2)?(COUNT * OBJECT_LEN):0});
     }
 
     EXPECT_EQ(src.direction, Direction::REQUEST);
@@ -43,6 +46,7 @@ TEST(Request, BPut) {
     EXPECT_EQ(src.op, dst->op);
     EXPECT_EQ(src.src, dst->src);
     EXPECT_EQ(src.dst, dst->dst);
+    EXPECT_EQ(src.seq, dst->seq);
 
     EXPECT_EQ(src.count, dst->count);
 
@@ -50,6 +54,50 @@ TEST(Request, BPut) {
         EXPECT_EQ(src.subjects[i], dst->subjects[i]);
         EXPECT_EQ(src.predicates[i], dst->predicates[i]);
         EXPECT_EQ(src.objects[i], dst->objects[i]);
+        EXPECT_EQ(src.chunks[i].id, dst->chunks[i].id);
+        EXPECT_EQ(src.chunks[i].offset, dst->chunks[i].offset);
+        EXPECT_EQ(src.chunks[i].total, dst->chunks[i].total);
+    }
+
+    destruct(dst);
+}
+
+TEST(Request, BPutSingleType) {
+    const double OBJECTS[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0};
+
+    Request::BPut src;
+    ASSERT_NO_THROW(src.alloc(COUNT));
+    for(std::size_t i = 0; i < COUNT; i++) {
+        src.add(ReferenceBlob((void *) &SUBJECT, SUBJECT_LEN, SUBJECT_TYPE),
+                ReferenceBlob((void *) &PREDICATE, PREDICATE_LEN, PREDICATE_TYPE),
+                ReferenceBlob((void *) &OBJECTS[i], sizeof(OBJECTS[i]), hxhim_data_t::HXHIM_DATA_DOUBLE));
+    }
+
+    std::size_t width = 0;
+    EXPECT_EQ(src.single_type(&width), hxhim_data_t::HXHIM_DATA_DOUBLE);
+    EXPECT_EQ(width, sizeof(double));
+
+    void *buf = nullptr;
+    std::size_t size = 0;
+    EXPECT_EQ(Packer::pack(&src, &buf, &size), MESSAGE_SUCCESS);
+
+    // objects are packed without individual lengths and types
+    EXPECT_LT(size, src.size());
+
+    Request::BPut *dst = nullptr;
+    EXPECT_EQ(Unpacker::unpack(&dst, buf, size), MESSAGE_SUCCESS);
+    dealloc(buf);
+
+    ASSERT_NE(dst, nullptr);
+    EXPECT_EQ(src.count, dst->count);
+
+    for(std::size_t i = 0; i < dst->count; i++) {
+        EXPECT_EQ(src.subjects[i], dst->subjects[i]);
+        EXPECT_EQ(src.predicates[i], dst->predicates[i]);
+        EXPECT_EQ(dst->objects[i].data_type(), hxhim_data_t::HXHIM_DATA_DOUBLE);
+        ASSERT_EQ(dst->objects[i].size(), sizeof(double));
+        EXPECT_EQ(* (double *) dst->objects[i].data(), OBJECTS[i]);
+        EXPECT_EQ(dst->chunks[i].id, (std::uint64_t) 0);
     }
 
     destruct(dst);
@@ -107,7 +155,8 @@ TEST(Request, BGetOp) {
                     ReferenceBlob((void *) &PREDICATE, PREDICATE_LEN, PREDICATE_TYPE),
                     OBJECT_TYPE,
                     rand(),
-                    static_cast<hxhim_getop_t>(i));
+                    static_cast<hxhim_getop_t>(i),
+                    (i % 2)?ReferenceBlob((void *) &OBJECT, OBJECT_LEN, hxhim_data_t::HXHIM_DATA_BYTE):Blob());
         }
     }
 
@@ -142,6 +191,7 @@ TEST(Request, BGetOp) {
         EXPECT_EQ(src.object_types[i], dst->object_types[i]);
         EXPECT_EQ(src.num_recs[i], dst->num_recs[i]);
         EXPECT_EQ(src.ops[i], dst->ops[i]);
+        EXPECT_EQ(src.cursors[i], dst->cursors[i]);
     }
 
     destruct(dst);
@@ -226,12 +276,16 @@ TEST(Response, BPut) {
     for(std::size_t i = 0; i < COUNT; i++) {
         src.src = rand();
         src.dst = rand();
+        src.seq = rand();
 
         src.add(ReferenceBlob((void *) &SUBJECT, SUBJECT_LEN, SUBJECT_TYPE),
                 ReferenceBlob((void *) &PREDICATE, PREDICATE_LEN, PREDICATE_TYPE),
                 DATASTORE_SUCCESS);
     }
 
+    src.grant.bytes = rand();
+    src.grant.ops = rand();
+
     EXPECT_EQ(src.direction, Message::RESPONSE);
     EXPECT_EQ(src.op, hxhim_op_t::HXHIM_PUT);
 
@@ -248,6 +302,9 @@ TEST(Response, BPut) {
     EXPECT_EQ(src.op, dst->op);
     EXPECT_EQ(src.src, dst->src);
     EXPECT_EQ(src.dst, dst->dst);
+    EXPECT_EQ(src.seq, dst->seq);
+    EXPECT_EQ(src.grant.bytes, dst->grant.bytes);
+    EXPECT_EQ(src.grant.ops, dst->grant.ops);
 
     EXPECT_EQ(src.count, dst->count);
 
@@ -321,6 +378,13 @@ TEST(Response, BGetOp) {
         objects[0]    = ReferenceBlob((void *) &OBJECT, OBJECT_LEN, OBJECT_TYPE);
 
         src.add(subjects, predicates, objects, DATASTORE_SUCCESS, 1);
+        src.set_rest(0,
+                     ReferenceBlob((void *) &SUBJECT, SUBJECT_LEN, SUBJECT_TYPE),
+                     ReferenceBlob((void *) &PREDICATE, PREDICATE_LEN, PREDICATE_TYPE),
+                     OBJECT_TYPE,
+                     COUNT,
+                     hxhim_getop_t::HXHIM_GETOP_NEXT,
+                     ReferenceBlob((void *) &OBJECT, OBJECT_LEN, hxhim_data_t::HXHIM_DATA_BYTE));
     }
 
     EXPECT_EQ(src.direction, Message::RESPONSE);
@@ -361,6 +425,13 @@ TEST(Response, BGetOp) {
             EXPECT_EQ(src.predicates[i][j], dst->predicates[i][j]);
             EXPECT_EQ(src.objects[i][j],    dst->objects[i][j]);
         }
+
+        EXPECT_EQ(src.rest.num_recs[i],     dst->rest.num_recs[i]);
+        EXPECT_EQ(src.rest.ops[i],          dst->rest.ops[i]);
+        EXPECT_EQ(src.rest.object_types[i], dst->rest.object_types[i]);
+        EXPECT_EQ(src.rest.subjects[i],     dst->rest.subjects[i]);
+        EXPECT_EQ(src.rest.predicates[i],   dst->rest.predicates[i]);
+        EXPECT_EQ(src.rest.cursors[i],      dst->rest.cursors[i]);
     }
 
     destruct(dst);
@@ -471,3 +542,25 @@ TEST(Response, BHistogram) {
 
     destruct(dst);
 }
+
+TEST(Unpacker, peek) {
+    Request::BGet src;
+    ASSERT_NO_THROW(src.alloc(COUNT));
+    src.src = rand();
+    src.dst = 7;
+
+    void *buf = nullptr;
+    std::size_t size = 0;
+    EXPECT_EQ(Packer::pack(&src, &buf, &size), MESSAGE_SUCCESS);
+
+    enum hxhim_op_t op = HXHIM_INVALID;
+    int dst = -1;
+    EXPECT_EQ(Unpacker::peek(buf, size, &op, &dst), MESSAGE_SUCCESS);
+    EXPECT_EQ(op, hxhim_op_t::HXHIM_GET);
+    EXPECT_EQ(dst, src.dst);
+
+    // too short to contain a header
+    EXPECT_EQ(Unpacker::peek(buf, 1, &op, &dst), MESSAGE_ERROR);
+
+    dealloc(buf);
+}
@@ -0,0 +1,37 @@
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "utils/Backoff.hpp"
+
+TEST(Backoff, grows_and_resets) {
+    const std::size_t spins = 3;
+    const std::chrono::microseconds min(1);
+    const std::chrono::microseconds max(8);
+
+    Backoff backoff(spins, min, max);
+
+    // spin without sleeping
+    for(std::size_t i = 0; i < spins; i++) {
+        EXPECT_EQ(backoff.delay(), std::chrono::microseconds::zero());
+        backoff.wait();
+    }
+
+    // yield once
+    EXPECT_EQ(backoff.delay(), std::chrono::microseconds::zero());
+    backoff.wait();
+
+    // sleep, doubling until max
+    for(std::chrono::microseconds expected : {std::chrono::microseconds(1),
+                                              std::chrono::microseconds(2),
+                                              std::chrono::microseconds(4),
+                                              std::chrono::microseconds(8),
+                                              std::chrono::microseconds(8)}) {
+        EXPECT_EQ(backoff.delay(), expected);
+        backoff.wait();
+    }
+
+    // progress was made
+    backoff.reset();
+    EXPECT_EQ(backoff.delay(), std::chrono::microseconds::zero());
+}
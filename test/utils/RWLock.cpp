@@ -0,0 +1,70 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/RWLock.hpp"
+
+TEST(RWLock, readers_share) {
+    RWLock rwlock;
+
+    // every reader waits for all of the others while holding the lock
+    const std::size_t count = 4;
+    std::atomic<std::size_t> inside(0);
+    std::vector<std::thread> readers;
+    for(std::size_t i = 0; i < count; i++) {
+        readers.emplace_back([&rwlock, &inside, count]() {
+                RWLock::Guard lock(rwlock, RWLock::SHARED);
+                inside++;
+                while (inside < count) {
+                    std::this_thread::yield();
+                }
+            });
+    }
+
+    for(std::thread &reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(inside, count);
+}
+
+TEST(RWLock, writers_exclude) {
+    RWLock rwlock;
+
+    const std::size_t count = 4;
+    const std::size_t loops = 1000;
+    std::size_t value = 0;          // not atomic
+    std::atomic<bool> overlap(false);
+    std::atomic<std::size_t> readers(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < count; i++) {
+        threads.emplace_back([&]() {
+                for(std::size_t j = 0; j < loops; j++) {
+                    std::lock_guard<RWLock> lock(rwlock);
+                    if (readers) {
+                        overlap = true;
+                    }
+                    value++;
+                }
+            });
+
+        threads.emplace_back([&]() {
+                for(std::size_t j = 0; j < loops; j++) {
+                    RWLock::Guard lock(rwlock, RWLock::SHARED);
+                    readers++;
+                    readers--;
+                }
+            });
+    }
+
+    for(std::thread &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(overlap);
+    EXPECT_EQ(value, count * loops);
+}
@@ -29,3 +29,42 @@ TEST(Stats, chrono) {
         EXPECT_EQ(::Stats::nano(duration), 41976);
     }
 }
+
+TEST(Stats, Distribution_buckets) {
+    // buckets cover every value without gaps
+    EXPECT_EQ(::Stats::Distribution::lower(0), 0);
+    for(std::size_t i = 1; i < ::Stats::Distribution::BUCKETS; i++) {
+        EXPECT_EQ(::Stats::Distribution::lower(i), ::Stats::Distribution::upper(i - 1) + 1);
+    }
+    EXPECT_EQ(::Stats::Distribution::upper(::Stats::Distribution::BUCKETS - 1), UINT64_MAX);
+
+    // values land in the bucket that contains them
+    const uint64_t values[] = {0, 1, 3, 4, 7, 8, 100, 12345, 1ULL << 40, UINT64_MAX};
+    for(uint64_t const value : values) {
+        const std::size_t i = ::Stats::Distribution::index(value);
+        ASSERT_LT(i, ::Stats::Distribution::BUCKETS);
+        EXPECT_LE(::Stats::Distribution::lower(i), value);
+        EXPECT_GE(::Stats::Distribution::upper(i), value);
+    }
+}
+
+TEST(Stats, Distribution_quantile) {
+    ::Stats::Distribution dist;
+    EXPECT_EQ(dist.count(), 0);
+    EXPECT_EQ(dist.quantile(0.5), 0);
+
+    for(uint64_t value = 1; value <= 100; value++) {
+        dist.add(value);
+    }
+
+    EXPECT_EQ(dist.count(), 100);
+    EXPECT_EQ(dist.sum(), 5050);
+
+    // quantiles are the upper bounds of their buckets
+    const uint64_t median = dist.quantile(0.5);
+    EXPECT_GE(median, 50);
+    EXPECT_LE(median, 50 + 50 / 4);
+
+    EXPECT_EQ(dist.quantile(1), ::Stats::Distribution::upper(::Stats::Distribution::index(100)));
+    EXPECT_EQ(dist.quantile(0), 1);
+}
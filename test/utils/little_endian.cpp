@@ -76,3 +76,31 @@ TEST(little_endian, Enum) {
     EXPECT_EQ(little_endian::decode(decoded, encoded, sizeof(orig)), HXHIM_SUCCESS);
     EXPECT_EQ(decoded, orig);
 }
+
+TEST(little_endian, double_array) {
+    const std::size_t count = (rand() % 32) + 1;
+    double *orig = new double[count]();
+    for(std::size_t i = 0; i < count; i++) {
+        orig[i] = rand() + rand() / rand();
+    }
+
+    char *encoded = new char[sizeof(double) * count]();
+    EXPECT_EQ(little_endian::encode_array(encoded, orig, count), HXHIM_SUCCESS);
+
+    // each value is encoded the same way as a single value
+    for(std::size_t i = 0; i < count; i++) {
+        char single[sizeof(double)] = {};
+        EXPECT_EQ(little_endian::encode(single, orig[i]), HXHIM_SUCCESS);
+        EXPECT_EQ(memcmp(encoded + i * sizeof(double), single, sizeof(double)), 0);
+    }
+
+    double *decoded = new double[count]();
+    EXPECT_EQ(little_endian::decode_array(decoded, encoded, count), HXHIM_SUCCESS);
+    for(std::size_t i = 0; i < count; i++) {
+        EXPECT_EQ(decoded[i], orig[i]);
+    }
+
+    delete [] decoded;
+    delete [] encoded;
+    delete [] orig;
+}